@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <cmath>
+#include <cstring>
 #include "app_gyro_game.hpp"
 #include "esp_brookesia.hpp"
 #include "bsp/esp32_s3_touch_amoled_2_06.h"
@@ -35,6 +36,17 @@ namespace esp_brookesia::apps {
 
 GyroGame *GyroGame::_instance = nullptr;
 
+static base::App::Config get_core_config(void)
+{
+    base::App::Config config = base::App::Config::SIMPLE_CONSTRUCTOR(GYRO_GAME_APP_NAME, &gyro_game_icon, false);
+    // The IMU init and calibration block for hundreds of ms, run them in `prepare()` instead of the first frame
+    config.flags.enable_prepare = 1;
+    // Only the box motion has to survive, so the screen can be freed while the app is in the background
+    config.flags.enable_hibernate = 1;
+
+    return config;
+}
+
 GyroGame *GyroGame::requestInstance(bool use_status_bar, bool use_navigation_bar)
 {
     if (_instance == nullptr) {
@@ -44,7 +56,7 @@ GyroGame *GyroGame::requestInstance(bool use_status_bar, bool use_navigation_bar
 }
 
 GyroGame::GyroGame(bool use_status_bar, bool use_navigation_bar):
-    App(GYRO_GAME_APP_NAME, &gyro_game_icon, false, use_status_bar, use_navigation_bar),
+    App(get_core_config(), phone::App::Config::SIMPLE_CONSTRUCTOR(&gyro_game_icon, use_status_bar, use_navigation_bar)),
     _container(nullptr), _box(nullptr), _physics_timer(nullptr),
     pos_x(0), pos_y(0), vel_x(0), vel_y(0),
     screen_width(0), screen_height(0), box_size(50),
@@ -62,13 +74,15 @@ GyroGame::~GyroGame()
     }
 }
 
-void GyroGame::perform_calibration() {
+void GyroGame::perform_calibration(bool refresh_ui) {
     if (!_qmi_dev) return;
 
     ESP_LOGI(GYRO_GAME_LOG_TAG, "Starting calibration...");
     
     // Simple UI feedback, force render
-    lv_refr_now(NULL);
+    if (refresh_ui) {
+        lv_refr_now(NULL);
+    }
 
     const int samples = 200;
     float sum_x = 0;
@@ -96,7 +110,7 @@ void GyroGame::perform_calibration() {
     ESP_LOGI(GYRO_GAME_LOG_TAG, "Calibration done. Bias X: %.3f, Y: %.3f", accel_bias_x, accel_bias_y);
 }
 
-void GyroGame::init_imu() {
+void GyroGame::init_imu(bool refresh_ui) {
     if (imu_initialized) return;
 
     ESP_LOGI(GYRO_GAME_LOG_TAG, "Initializing QMI8658 Component...");
@@ -129,7 +143,7 @@ void GyroGame::init_imu() {
     imu_initialized = true;
     
     // Auto calibrate on start
-    perform_calibration();
+    perform_calibration(refresh_ui);
 }
 
 void GyroGame::read_imu(float &acc_x, float &acc_y) {
@@ -242,6 +256,14 @@ void GyroGame::timer_cb(lv_timer_t *timer) {
     app->update_physics(timer);
 }
 
+bool GyroGame::prepare(void)
+{
+    // Runs without the LVGL lock, so the calibration must not refresh the screen
+    init_imu(false);
+
+    return true;
+}
+
 bool GyroGame::run(void)
 {
     // Start recording resources for recents screen snapshots
@@ -322,6 +344,35 @@ bool GyroGame::resume(void)
     return true;
 }
 
+bool GyroGame::saveState(std::vector<uint8_t> &state)
+{
+    const float values[] = {pos_x, pos_y, vel_x, vel_y};
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(values);
+    state.assign(data, data + sizeof(values));
+
+    // The screen and the physics timer are deleted by the core after this
+    _container = nullptr;
+    _box = nullptr;
+    _physics_timer = nullptr;
+
+    return true;
+}
+
+bool GyroGame::restoreState(const std::vector<uint8_t> &state)
+{
+    float values[4] = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(state.size() == sizeof(values), false, "Invalid state size(%d)", (int)state.size());
+    memcpy(values, state.data(), sizeof(values));
+
+    pos_x = values[0];
+    pos_y = values[1];
+    vel_x = values[2];
+    vel_y = values[3];
+    lv_obj_set_pos(_box, (lv_coord_t)pos_x, (lv_coord_t)pos_y);
+
+    return true;
+}
+
 ESP_UTILS_REGISTER_PLUGIN_WITH_CONSTRUCTOR(systems::base::App, GyroGame, GYRO_GAME_APP_NAME, []() {
     return std::shared_ptr<GyroGame>(GyroGame::requestInstance(), [](GyroGame *p) {});
 });
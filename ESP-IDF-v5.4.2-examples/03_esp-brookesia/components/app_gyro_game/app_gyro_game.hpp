@@ -36,6 +36,11 @@ protected:
      */
     GyroGame(bool use_status_bar, bool use_navigation_bar);
 
+    /**
+     * @brief Initialize and calibrate the IMU on the worker thread before `run()`
+     */
+    bool prepare(void) override;
+
     /**
      * @brief App Entry Point
      */
@@ -61,6 +66,16 @@ protected:
      */
     bool resume(void) override;
 
+    /**
+     * @brief Save the box motion before the app hibernates
+     */
+    bool saveState(std::vector<uint8_t> &state) override;
+
+    /**
+     * @brief Restore the box motion after `run()` has rebuilt the UI
+     */
+    bool restoreState(const std::vector<uint8_t> &state) override;
+
 private:
     static GyroGame *_instance;
 
@@ -88,8 +103,8 @@ private:
     qmi8658_dev_t *_qmi_dev;
 
     // Internal methods
-    void init_imu();
-    void perform_calibration();
+    void init_imu(bool refresh_ui = true);
+    void perform_calibration(bool refresh_ui = true);
     void read_imu(float &acc_x, float &acc_y);
     void update_physics(lv_timer_t *timer);
 
@@ -40,6 +40,15 @@ namespace esp_brookesia::apps {
 
 GyroMaze *GyroMaze::_instance = nullptr;
 
+static base::App::Config get_core_config(void)
+{
+    base::App::Config config = base::App::Config::SIMPLE_CONSTRUCTOR(GYRO_MAZE_APP_NAME, &gyro_maze_icon, false);
+    // The IMU init and calibration block for hundreds of ms, run them in `prepare()` instead of the first frame
+    config.flags.enable_prepare = 1;
+
+    return config;
+}
+
 GyroMaze *GyroMaze::requestInstance(bool use_status_bar, bool use_navigation_bar)
 {
     if (_instance == nullptr) {
@@ -49,7 +58,7 @@ GyroMaze *GyroMaze::requestInstance(bool use_status_bar, bool use_navigation_bar
 }
 
 GyroMaze::GyroMaze(bool use_status_bar, bool use_navigation_bar):
-    App(GYRO_MAZE_APP_NAME, &gyro_maze_icon, false, use_status_bar, use_navigation_bar),
+    App(get_core_config(), phone::App::Config::SIMPLE_CONSTRUCTOR(&gyro_maze_icon, use_status_bar, use_navigation_bar)),
     _container(nullptr), _ball(nullptr), _hole(nullptr), _wall_container(nullptr), _game_timer(nullptr),
     start_row(0), start_col(0), hole_row(0), hole_col(0),
     pos_x(0), pos_y(0), vel_x(0), vel_y(0),
@@ -240,13 +249,15 @@ void GyroMaze::generate_maze()
 }
 
 // --- IMU Logic ---
-void GyroMaze::perform_calibration() {
+void GyroMaze::perform_calibration(bool refresh_ui) {
     if (!_qmi_dev) return;
 
     ESP_LOGI(GYRO_MAZE_LOG_TAG, "Starting calibration...");
     
     // UI Feedback could be added here
-    lv_refr_now(NULL);
+    if (refresh_ui) {
+        lv_refr_now(NULL);
+    }
 
     const int samples = 100;
     float sum_x = 0;
@@ -270,7 +281,7 @@ void GyroMaze::perform_calibration() {
     ESP_LOGI(GYRO_MAZE_LOG_TAG, "Calibration done. Bias X: %.3f, Y: %.3f", accel_bias_x, accel_bias_y);
 }
 
-void GyroMaze::init_imu() {
+void GyroMaze::init_imu(bool refresh_ui) {
     if (imu_initialized) return;
 
     i2c_master_bus_handle_t bus_handle = bsp_i2c_get_handle();
@@ -291,7 +302,7 @@ void GyroMaze::init_imu() {
     qmi8658_write_register(_qmi_dev, QMI8658_CTRL5, 0x03); 
 
     imu_initialized = true;
-    perform_calibration();
+    perform_calibration(refresh_ui);
 }
 
 void GyroMaze::read_imu(float &acc_x, float &acc_y) {
@@ -540,6 +551,14 @@ void GyroMaze::draw_maze() {
 
 // --- App Lifecycle ---
 
+bool GyroMaze::prepare(void)
+{
+    // Runs without the LVGL lock, so the calibration must not refresh the screen
+    init_imu(false);
+
+    return true;
+}
+
 bool GyroMaze::run(void)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(startRecordResource(), false, "Start record failed");
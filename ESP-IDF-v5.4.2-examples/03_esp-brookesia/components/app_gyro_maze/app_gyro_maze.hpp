@@ -34,6 +34,7 @@ public:
 
 protected:
     GyroMaze(bool use_status_bar, bool use_navigation_bar);
+    bool prepare(void) override;
     bool run(void) override;
     bool back(void) override;
     bool close(void) override;
@@ -106,8 +107,8 @@ private:
     qmi8658_dev_t *_qmi_dev;
 
     // Internal methods
-    void init_imu();
-    void perform_calibration();
+    void init_imu(bool refresh_ui = true);
+    void perform_calibration(bool refresh_ui = true);
     void read_imu(float &acc_x, float &acc_y);
     void update_game(lv_timer_t *timer);
     
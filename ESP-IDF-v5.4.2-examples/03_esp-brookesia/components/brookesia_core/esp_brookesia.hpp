@@ -12,6 +12,9 @@
 /* C-standard */
 #include "esp_brookesia.h"
 
+/* Trace */
+#include "trace/esp_brookesia_trace.hpp"
+
 /* GUI */
 /* GUI - lvgl */
 #include "style/esp_brookesia_gui_style.hpp"
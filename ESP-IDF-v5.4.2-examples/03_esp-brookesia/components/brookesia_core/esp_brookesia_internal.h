@@ -53,4 +53,23 @@
 #   endif
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////// Trace //////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_ENABLE_TRACE)
+#   if defined(CONFIG_ESP_BROOKESIA_ENABLE_TRACE)
+#       define ESP_BROOKESIA_ENABLE_TRACE  CONFIG_ESP_BROOKESIA_ENABLE_TRACE
+#   else
+#       define ESP_BROOKESIA_ENABLE_TRACE  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_TRACE_RING_SIZE)
+#   if defined(CONFIG_ESP_BROOKESIA_TRACE_RING_SIZE)
+#       define ESP_BROOKESIA_TRACE_RING_SIZE  CONFIG_ESP_BROOKESIA_TRACE_RING_SIZE
+#   else
+#       define ESP_BROOKESIA_TRACE_RING_SIZE  (256)
+#   endif
+#endif
+
 // *INDENT-ON*
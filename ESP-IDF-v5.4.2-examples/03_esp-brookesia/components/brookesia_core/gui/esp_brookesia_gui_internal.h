@@ -35,6 +35,22 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////// LVGL //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if !defined(ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING)
+#   if defined(CONFIG_ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING)
+#       define ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING  CONFIG_ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+#   else
+#       define ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS)
+#   if defined(CONFIG_ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS)
+#       define ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS  CONFIG_ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS
+#   else
+#       define ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS  (33)
+#   endif
+#endif
+
 #if !defined(ESP_BROOKESIA_LVGL_ENABLE_DEBUG_LOG)
 #   if defined(CONFIG_ESP_BROOKESIA_LVGL_ENABLE_DEBUG_LOG)
 #       define ESP_BROOKESIA_LVGL_ENABLE_DEBUG_LOG  CONFIG_ESP_BROOKESIA_LVGL_ENABLE_DEBUG_LOG
@@ -7,11 +7,31 @@
 #if !ESP_BROOKESIA_LVGL_LOCK_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+#   include <algorithm>
+#   include <cstring>
+#   if defined(ESP_PLATFORM)
+#       include "esp_timer.h"
+#   else
+#       include <chrono>
+#   endif
+#endif
 #include "private/esp_brookesia_lv_utils.hpp"
 #include "esp_brookesia_lv_lock.hpp"
 
 namespace esp_brookesia::gui {
 
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+// Outermost lock held by the thread, the nested ones only change the depth
+struct ThreadLockState {
+    int depth;
+    int64_t hold_start_us;
+    LvLockSite site;
+};
+
+static thread_local ThreadLockState s_thread_lock_state = {};
+#endif
+
 LvLock &LvLock::getInstance()
 {
     static LvLock s_instance;
@@ -27,14 +47,21 @@ void LvLock::registerCallbacks(LockCallback lock_cb, UnlockCallback unlock_cb)
     inst.unlock_cb_ = std::move(unlock_cb);
 }
 
-bool LvLock::lock(int timeout_ms)
+bool LvLock::lock(int timeout_ms, const LvLockSite &site)
 {
     ESP_UTILS_LOG_TRACE_GUARD();
 
     ESP_UTILS_LOGD("Param: timeout_ms(%d)", timeout_ms);
 
     ESP_UTILS_CHECK_FALSE_RETURN(lock_cb_.operator bool(), false, "Lock callback not registered");
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    int64_t start_us = getTimeUs();
+    bool is_locked = lock_cb_(timeout_ms);
+    recordLock(site, is_locked, getTimeUs() - start_us);
+    ESP_UTILS_CHECK_FALSE_RETURN(is_locked, false, "Lock callback failed");
+#else
     ESP_UTILS_CHECK_FALSE_RETURN(lock_cb_(timeout_ms), false, "Lock callback failed");
+#endif
     lock_count_++;
     ESP_UTILS_LOGD("Locked count: %d", static_cast<int>(lock_count_));
 
@@ -46,6 +73,13 @@ bool LvLock::unlock()
     ESP_UTILS_LOG_TRACE_GUARD();
 
     ESP_UTILS_CHECK_FALSE_RETURN(unlock_cb_.operator bool(), false, "Unlock callback not registered");
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    // Recorded before the lock is released, so that the next owner is not counted
+    ThreadLockState &state = s_thread_lock_state;
+    if ((state.depth > 0) && (--state.depth == 0)) {
+        recordUnlock(state.site, getTimeUs() - state.hold_start_us);
+    }
+#endif
     ESP_UTILS_CHECK_FALSE_RETURN(unlock_cb_(), false, "Unlock callback failed");
     if (lock_count_ > 0) {
         lock_count_--;
@@ -55,11 +89,115 @@ bool LvLock::unlock()
     return true;
 }
 
-LvLockGuard::LvLockGuard()
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+std::vector<LvLock::SiteStats> LvLock::getSiteStats() const
+{
+    std::vector<SiteStats> stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats.reserve(site_stats_.size());
+        for (auto &[key, site_stats] : site_stats_) {
+            stats.push_back(site_stats);
+        }
+    }
+    std::sort(stats.begin(), stats.end(), [](const SiteStats & a, const SiteStats & b) {
+        return a.hold_total_us > b.hold_total_us;
+    });
+
+    return stats;
+}
+
+void LvLock::resetSiteStats()
+{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    site_stats_.clear();
+}
+
+void LvLock::dump() const
+{
+    std::vector<SiteStats> stats = getSiteStats();
+
+    ESP_UTILS_LOGI(
+        "LVGL lock sites (%d), holds longer than %d ms delay the refresh task:", static_cast<int>(stats.size()),
+        ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS
+    );
+    for (auto &site_stats : stats) {
+        const char *file = (site_stats.site.file != nullptr) ? site_stats.site.file : "?";
+        const char *file_name = strrchr(file, '/');
+        file_name = (file_name != nullptr) ? (file_name + 1) : file;
+        int lock_count = std::max<int>(site_stats.lock_count, 1);
+        ESP_UTILS_LOGI(
+            "\t%s:%d (%s): %d locks, %d failed | wait avg/max %d/%d us | hold avg/max %d/%d us, total %d ms, "
+            "%d long", file_name, site_stats.site.line,
+            (site_stats.site.function != nullptr) ? site_stats.site.function : "?",
+            static_cast<int>(site_stats.lock_count), static_cast<int>(site_stats.fail_count),
+            static_cast<int>(site_stats.wait_total_us / lock_count), static_cast<int>(site_stats.wait_max_us),
+            static_cast<int>(site_stats.hold_total_us / lock_count), static_cast<int>(site_stats.hold_max_us),
+            static_cast<int>(site_stats.hold_total_us / 1000), static_cast<int>(site_stats.long_hold_count)
+        );
+    }
+}
+
+int64_t LvLock::getTimeUs()
+{
+#if defined(ESP_PLATFORM)
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+           ).count();
+#endif
+}
+
+LvLock::SiteStats &LvLock::getSiteStatsLocked(const LvLockSite &site)
+{
+    SiteStats &stats = site_stats_[SiteKey(site.file, site.line)];
+    if ((stats.lock_count == 0) && (stats.fail_count == 0)) {
+        stats.site = site;
+    }
+
+    return stats;
+}
+
+void LvLock::recordLock(const LvLockSite &site, bool is_locked, int64_t wait_us)
+{
+    ThreadLockState &state = s_thread_lock_state;
+
+    // A nested lock can't wait, it is part of the hold of the outermost one
+    if (is_locked && (state.depth++ > 0)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    SiteStats &stats = getSiteStatsLocked(site);
+    if (!is_locked) {
+        stats.fail_count++;
+        return;
+    }
+    stats.lock_count++;
+    stats.wait_total_us += wait_us;
+    stats.wait_max_us = std::max(stats.wait_max_us, wait_us);
+    state.site = site;
+    state.hold_start_us = getTimeUs();
+}
+
+void LvLock::recordUnlock(const LvLockSite &site, int64_t hold_us)
+{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    SiteStats &stats = getSiteStatsLocked(site);
+    stats.hold_total_us += hold_us;
+    stats.hold_max_us = std::max(stats.hold_max_us, hold_us);
+    if (hold_us > ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS * 1000LL) {
+        stats.long_hold_count++;
+    }
+}
+#endif
+
+LvLockGuard::LvLockGuard(const LvLockSite &site)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    locked_ = LvLock::getInstance().lock();
+    locked_ = LvLock::getInstance().lock(-1, site);
 }
 
 LvLockGuard::~LvLockGuard()
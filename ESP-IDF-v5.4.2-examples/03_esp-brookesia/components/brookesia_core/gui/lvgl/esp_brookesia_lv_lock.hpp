@@ -6,18 +6,66 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "esp_brookesia_gui_internal.h"
 
 namespace esp_brookesia::gui {
 
+/**
+ * @brief Call site of a lock, captured through default arguments like `std::source_location::current()`
+ */
+struct LvLockSite {
+    const char *file = nullptr;
+    const char *function = nullptr;
+    int line = 0;
+
+    static constexpr LvLockSite current(
+        const char *file = __builtin_FILE(), const char *function = __builtin_FUNCTION(), int line = __builtin_LINE()
+    )
+    {
+        return {file, function, line};
+    }
+};
+
 class LvLock {
 public:
     using LockCallback = std::function<bool(int timeout_ms)>;
     using UnlockCallback = std::function<bool()>;
 
-    bool lock(int timeout_ms = -1);
+    /**
+     * @brief Statistics of the outermost locks taken from a call site, the nested ones are part of its hold time
+     */
+    struct SiteStats {
+        LvLockSite site;
+        size_t lock_count = 0;
+        size_t fail_count = 0;          // Timeouts and failures of the lock callback
+        int64_t wait_total_us = 0;
+        int64_t wait_max_us = 0;
+        int64_t hold_total_us = 0;
+        int64_t hold_max_us = 0;
+        size_t long_hold_count = 0;     // Holds longer than `ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS`
+    };
+
+    bool lock(int timeout_ms = -1, const LvLockSite &site = LvLockSite::current());
     bool unlock();
 
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    /**
+     * @brief Get the statistics of every call site, the ones holding the lock the longest in total first
+     */
+    std::vector<SiteStats> getSiteStats() const;
+    void resetSiteStats();
+    /**
+     * @brief Print the statistics of every call site. The long holds are the ones which delay the LVGL refresh task
+     */
+    void dump() const;
+#endif
+
     static LvLock &getInstance();
     static void registerCallbacks(LockCallback lock_cb, UnlockCallback unlock_cb);
 
@@ -27,14 +75,27 @@ private:
     LvLock(const LvLock &) = delete;
     LvLock &operator=(const LvLock &) = delete;
 
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    using SiteKey = std::pair<const char *, int>;
+
+    static int64_t getTimeUs();
+    SiteStats &getSiteStatsLocked(const LvLockSite &site);
+    void recordLock(const LvLockSite &site, bool is_locked, int64_t wait_us);
+    void recordUnlock(const LvLockSite &site, int64_t hold_us);
+#endif
+
     LockCallback lock_cb_;
     UnlockCallback unlock_cb_;
     std::atomic<size_t> lock_count_ = 0;
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    mutable std::mutex stats_mutex_;
+    std::map<SiteKey, SiteStats> site_stats_;
+#endif
 };
 
 class LvLockGuard {
 public:
-    LvLockGuard();
+    LvLockGuard(const LvLockSite &site = LvLockSite::current());
     ~LvLockGuard();
 
     LvLockGuard(const LvLockGuard &) = delete;
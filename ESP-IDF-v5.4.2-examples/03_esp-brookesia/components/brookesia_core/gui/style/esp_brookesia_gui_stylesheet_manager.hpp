@@ -17,11 +17,13 @@
 #include <unordered_map>
 // #include "private/esp_brookesia_base_utils.hpp"
 #include "style/esp_brookesia_gui_style.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 
 namespace esp_brookesia::gui {
 
+// The stylesheets are calibrated once when added, then shared and never modified
 template <typename T>
-using NameStylesheetMap = std::unordered_map<std::string, std::shared_ptr<T>>;
+using NameStylesheetMap = std::unordered_map<std::string, std::shared_ptr<const T>>;
 
 template <typename T>
 using ResolutionNameStylesheetMap = std::map<uint32_t, NameStylesheetMap<T>>;
@@ -51,6 +53,14 @@ public:
      */
     const T *getStylesheet(void) const { return &_active_stylesheet; }
 
+    /**
+     * @brief Get the calibrated stylesheet which is active
+     *
+     * @return stylesheet, `nullptr` if none is activated
+     *
+     */
+    std::shared_ptr<const T> getActiveStylesheetPtr(void) const { return _active_stylesheet_ptr; }
+
     /**
      * @brief Get the stylesheet by name and screen size
      *
@@ -76,11 +86,24 @@ protected:
     T _active_stylesheet;
 
     virtual bool calibrateStylesheet(const StyleSize &screen_size, T &stylesheet) = 0;
+    /**
+     * @brief Copy a calibrated stylesheet into `_active_stylesheet`, which is the storage referenced by the widgets. It
+     *        is only called if the stylesheet is not already active, and can be overridden to copy the changed parts only.
+     */
+    virtual bool updateActiveStylesheet(const T &stylesheet)
+    {
+        _active_stylesheet = stylesheet;
+        return true;
+    }
 
     bool del(void);
 
 private:
     ResolutionNameStylesheetMap<T> _resolution_name_stylesheet_map;
+    std::shared_ptr<const T> _active_stylesheet_ptr;
+
+    std::shared_ptr<const T> findStylesheet(const char *name, const StyleSize &screen_size);
+    bool activateCalibratedStylesheet(const std::shared_ptr<const T> &stylesheet);
 
     uint32_t getResolution(const StyleSize &screen_size)
     {
@@ -107,6 +130,8 @@ StylesheetManager<T>::~StylesheetManager()
 template <typename T>
 bool StylesheetManager<T>::addStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet)
 {
+    ESP_BROOKESIA_TRACE_SCOPE("Stylesheet::add");
+
     uint32_t resolution = 0;
     StyleSize calibrate_size = screen_size;
     std::shared_ptr<T> calibration_stylesheet = std::make_shared<T>(stylesheet);
@@ -154,6 +179,8 @@ template <typename T>
 bool StylesheetManager<T>::activateStylesheet(const StyleSize &screen_size,
         const T &stylesheet)
 {
+    ESP_BROOKESIA_TRACE_SCOPE("Stylesheet::activate");
+
     StyleSize calibrate_size = screen_size;
     // ESP_UTILS_CHECK_FALSE_RETURN(calibrateScreenSize(calibrate_size), false, "Invalid screen size");
     if (!calibrateScreenSize(calibrate_size)) {
@@ -173,37 +200,22 @@ bool StylesheetManager<T>::activateStylesheet(const StyleSize &screen_size,
         return false;
     }
 
-    _active_stylesheet = *calibration_stylesheet;
-
-    return true;
+    return activateCalibratedStylesheet(std::shared_ptr<const T>(std::move(calibration_stylesheet)));
 }
 
 template <typename T>
 bool StylesheetManager<T>::activateStylesheet(const char *name, const StyleSize &screen_size)
 {
-    StyleSize calibrate_size = screen_size;
-    const T *stylesheet = nullptr;
+    ESP_BROOKESIA_TRACE_SCOPE("Stylesheet::activate");
 
-    // ESP_UTILS_CHECK_NULL_RETURN(name, false, "Invalid name");
-    if (name == nullptr) {
-        return false;
-    }
-
-    // ESP_UTILS_CHECK_FALSE_RETURN(calibrateScreenSize(calibrate_size), false, "Invalid screen size");
-    if (!calibrateScreenSize(calibrate_size)) {
-        return false;
-    }
-    // ESP_UTILS_LOGD("Activate stylesheet(%s - %dx%d)", name, calibrate_size.width, calibrate_size.height);
-
-    stylesheet = getStylesheet(name, screen_size);
+    // ESP_UTILS_LOGD("Activate stylesheet(%s)", name);
+    std::shared_ptr<const T> stylesheet = findStylesheet(name, screen_size);
     // ESP_UTILS_CHECK_NULL_RETURN(stylesheet, false, "Get stylesheet failed");
     if (stylesheet == nullptr) {
         return false;
     }
 
-    _active_stylesheet = *stylesheet;
-
-    return true;
+    return activateCalibratedStylesheet(stylesheet);
 }
 
 template <typename T>
@@ -250,6 +262,12 @@ typename NameStylesheetMap<T>::iterator StylesheetManager<T>::getNameStylesheetM
 
 template <typename T>
 const T *StylesheetManager<T>::getStylesheet(const char *name, const StyleSize &screen_size)
+{
+    return findStylesheet(name, screen_size).get();
+}
+
+template <typename T>
+std::shared_ptr<const T> StylesheetManager<T>::findStylesheet(const char *name, const StyleSize &screen_size)
 {
     uint32_t resolution = 0;
     StyleSize calibrate_size = screen_size;
@@ -277,7 +295,23 @@ const T *StylesheetManager<T>::getStylesheet(const char *name, const StyleSize &
         return nullptr;
     }
 
-    return it_name_map->second.get();
+    return it_name_map->second;
+}
+
+template <typename T>
+bool StylesheetManager<T>::activateCalibratedStylesheet(const std::shared_ptr<const T> &stylesheet)
+{
+    // Activating the active stylesheet again is free
+    if (stylesheet == _active_stylesheet_ptr) {
+        return true;
+    }
+
+    if (!updateActiveStylesheet(*stylesheet)) {
+        return false;
+    }
+    _active_stylesheet_ptr = stylesheet;
+
+    return true;
 }
 
 template <typename T>
@@ -299,7 +333,7 @@ const T *StylesheetManager<T>::getStylesheet(const StyleSize &screen_size)
         return nullptr;
     }
 
-    auto name_map = it_resolution_map->second;
+    auto &name_map = it_resolution_map->second;
     if (name_map.empty()) {
         return nullptr;
     }
@@ -311,6 +345,7 @@ template <typename T>
 bool StylesheetManager<T>::del(void)
 {
     _active_stylesheet = {};
+    _active_stylesheet_ptr = nullptr;
     _resolution_name_stylesheet_map.clear();
 
     return true;
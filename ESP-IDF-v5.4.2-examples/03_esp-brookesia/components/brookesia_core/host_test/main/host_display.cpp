@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_log.h"
+#include "host_display.hpp"
+
+static const char *TAG = "host_display";
+
+HostDisplay::HostDisplay(int width, int height, int buffer_lines):
+    _width(width),
+    _height(height),
+    _buffer_lines(buffer_lines)
+{
+}
+
+HostDisplay::~HostDisplay()
+{
+    del();
+}
+
+bool HostDisplay::begin(void)
+{
+    ESP_LOGI(TAG, "Create display(%dx%d) with %d buffer lines", _width, _height, _buffer_lines);
+
+    _buffer.resize(_width * _buffer_lines * lv_color_format_get_size(LV_COLOR_FORMAT_RGB565));
+    _display = lv_display_create(_width, _height);
+    if (_display == nullptr) {
+        ESP_LOGE(TAG, "Create display failed");
+        return false;
+    }
+    lv_display_set_color_format(_display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(_display, _buffer.data(), nullptr, _buffer.size(), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(_display, onFlush);
+    lv_display_set_user_data(_display, this);
+
+    return true;
+}
+
+void HostDisplay::del(void)
+{
+    if (_display == nullptr) {
+        return;
+    }
+    lv_display_delete(_display);
+    _display = nullptr;
+    _buffer.clear();
+}
+
+void HostDisplay::onFlush(lv_display_t *display, const lv_area_t *area, uint8_t *px_map)
+{
+    HostDisplay *host_display = static_cast<HostDisplay *>(lv_display_get_user_data(display));
+
+    if (host_display != nullptr) {
+        host_display->_stats.flush_count++;
+        host_display->_stats.flushed_px += lv_area_get_size(area);
+    }
+    lv_display_flush_ready(display);
+}
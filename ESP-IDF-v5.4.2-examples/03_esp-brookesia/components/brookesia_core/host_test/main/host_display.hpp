@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lvgl.h"
+
+/**
+ * @brief LVGL display without panel: the frames are rendered into a partial buffer and the flushes are only counted
+ */
+class HostDisplay {
+public:
+    struct Stats {
+        uint32_t flush_count;
+        uint64_t flushed_px;
+    };
+
+    HostDisplay(int width, int height, int buffer_lines);
+    ~HostDisplay();
+
+    bool begin(void);
+    void del(void);
+
+    lv_display_t *get(void) const
+    {
+        return _display;
+    }
+    const Stats &getStats(void) const
+    {
+        return _stats;
+    }
+    void resetStats(void)
+    {
+        _stats = {};
+    }
+
+private:
+    static void onFlush(lv_display_t *display, const lv_area_t *area, uint8_t *px_map);
+
+    int _width;
+    int _height;
+    int _buffer_lines;
+    std::vector<uint8_t> _buffer;
+    lv_display_t *_display = nullptr;
+    Stats _stats = {};
+};
@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "lvgl.h"
+#include "esp_brookesia.hpp"
+#include "host_display.hpp"
+#include "host_touch.hpp"
+
+using namespace esp_brookesia;
+using namespace esp_brookesia::gui;
+using namespace esp_brookesia::systems::phone;
+
+#define HOST_TEST_SCREEN_WIDTH      CONFIG_HOST_TEST_SCREEN_WIDTH
+#define HOST_TEST_SCREEN_HEIGHT     CONFIG_HOST_TEST_SCREEN_HEIGHT
+#define HOST_TEST_FRAME_PERIOD_MS   CONFIG_HOST_TEST_FRAME_PERIOD_MS
+#define HOST_TEST_FRAME_NUM_MIN     CONFIG_HOST_TEST_FRAME_NUM_MIN
+#define HOST_TEST_BUFFER_LINES      (20)
+// Path of a touch trace to replay instead of the default one
+#define HOST_TEST_TOUCH_TRACE_ENV   "BROOKESIA_HOST_TOUCH_TRACE"
+// Path to write the boot spans to, in the Chrome trace-event JSON format
+#define HOST_TEST_SPAN_TRACE_ENV    "BROOKESIA_HOST_SPAN_TRACE"
+
+/* Try using a stylesheet that corresponds to the resolution */
+#if (HOST_TEST_SCREEN_WIDTH == 320) && (HOST_TEST_SCREEN_HEIGHT == 240)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_320_240_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 320) && (HOST_TEST_SCREEN_HEIGHT == 480)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_320_480_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 480) && (HOST_TEST_SCREEN_HEIGHT == 480)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_480_480_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 720) && (HOST_TEST_SCREEN_HEIGHT == 1280)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_720_1280_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 800) && (HOST_TEST_SCREEN_HEIGHT == 480)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_800_480_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 800) && (HOST_TEST_SCREEN_HEIGHT == 1280)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_800_1280_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 1024) && (HOST_TEST_SCREEN_HEIGHT == 600)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_1024_600_DARK
+#elif (HOST_TEST_SCREEN_WIDTH == 1280) && (HOST_TEST_SCREEN_HEIGHT == 800)
+#define HOST_TEST_PHONE_DARK_STYLESHEET()   STYLESHEET_1280_800_DARK
+#endif
+
+static const char *TAG = "host_test_esp_brookesia";
+
+// LVGL runs on this simulated clock, only advanced by the frame loop
+static uint32_t host_tick_ms = 0;
+static std::recursive_timed_mutex host_lv_mutex;
+
+static void host_append_default_trace(HostTouch &touch)
+{
+    const int32_t width = HOST_TEST_SCREEN_WIDTH;
+    const int32_t height = HOST_TEST_SCREEN_HEIGHT;
+
+    // Scroll the app launcher to the next page and back
+    touch.appendSwipe(500, width * 3 / 4, height / 2, width / 4, height / 2, 300, 10);
+    touch.appendSwipe(1500, width / 4, height / 2, width * 3 / 4, height / 2, 300, 10);
+    // Swipe up from the bottom edge
+    touch.appendSwipe(2500, width / 2, height - 1, width / 2, height / 2, 400, 10);
+    touch.appendTap(3500, width / 2, height / 2, 100);
+}
+
+static bool host_dump_span_trace(void)
+{
+    auto &tracer = trace::Tracer::getInstance();
+    const char *path = getenv(HOST_TEST_SPAN_TRACE_ENV);
+    std::string json;
+
+    tracer.dump();
+    if (path == nullptr) {
+        return true;
+    }
+    if (!tracer.dumpChromeTrace(json)) {
+        ESP_LOGE(TAG, "Dump span trace failed");
+        return false;
+    }
+
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        ESP_LOGE(TAG, "Open span trace file(%s) failed", path);
+        return false;
+    }
+    bool ret = (fwrite(json.data(), 1, json.size(), file) == json.size());
+    fclose(file);
+    if (!ret) {
+        ESP_LOGE(TAG, "Write span trace file(%s) failed", path);
+        return false;
+    }
+    ESP_LOGI(TAG, "Span trace written to %s", path);
+
+    return true;
+}
+
+static Phone *host_phone_init(lv_display_t *display, lv_indev_t *touch)
+{
+    Phone *phone = new (std::nothrow) Phone(display);
+    if (phone == nullptr) {
+        ESP_LOGE(TAG, "Create phone failed");
+        return nullptr;
+    }
+    if (!phone->setTouchDevice(touch)) {
+        ESP_LOGE(TAG, "Set touch device failed");
+        goto err;
+    }
+#ifdef HOST_TEST_PHONE_DARK_STYLESHEET
+    {
+        Stylesheet *stylesheet = new (std::nothrow) Stylesheet(HOST_TEST_PHONE_DARK_STYLESHEET());
+        if ((stylesheet == nullptr) || !phone->addStylesheet(stylesheet) || !phone->activateStylesheet(stylesheet)) {
+            ESP_LOGE(TAG, "Apply stylesheet failed");
+            delete stylesheet;
+            goto err;
+        }
+        delete stylesheet;
+    }
+#endif
+    if (!phone->begin()) {
+        ESP_LOGE(TAG, "Begin phone failed");
+        goto err;
+    }
+
+    return phone;
+
+err:
+    delete phone;
+
+    return nullptr;
+}
+
+extern "C" void app_main(void)
+{
+    ESP_LOGI(TAG, "Initialize LVGL library");
+    lv_init();
+    lv_tick_set_cb([]() {
+        return host_tick_ms;
+    });
+    LvLock::registerCallbacks([](int timeout_ms) {
+        if (timeout_ms < 0) {
+            host_lv_mutex.lock();
+            return true;
+        }
+        return host_lv_mutex.try_lock_for(std::chrono::milliseconds(timeout_ms));
+    }, []() {
+        host_lv_mutex.unlock();
+        return true;
+    });
+
+    HostDisplay display(HOST_TEST_SCREEN_WIDTH, HOST_TEST_SCREEN_HEIGHT, HOST_TEST_BUFFER_LINES);
+    HostTouch touch;
+    Phone *phone = nullptr;
+    int frame_num = 0;
+    int64_t frame_total_us = 0;
+    int64_t frame_max_us = 0;
+    const char *trace_path = getenv(HOST_TEST_TOUCH_TRACE_ENV);
+    bool ret = false;
+
+    if (!display.begin() || !touch.begin(display.get())) {
+        goto end;
+    }
+    if (trace_path != nullptr) {
+        if (!touch.loadTrace(trace_path)) {
+            goto end;
+        }
+    } else {
+        host_append_default_trace(touch);
+    }
+
+    {
+        LvLockGuard gui_guard;
+        phone = host_phone_init(display.get(), touch.get());
+    }
+    if (phone == nullptr) {
+        goto end;
+    }
+
+    // Replay the whole trace, plus a few frames to let the animations end
+    frame_num = std::max<int>(HOST_TEST_FRAME_NUM_MIN, touch.getEndTime() / HOST_TEST_FRAME_PERIOD_MS + 100);
+    ESP_LOGI(TAG, "Run %d frames of %d ms", frame_num, HOST_TEST_FRAME_PERIOD_MS);
+    display.resetStats();
+    phone->resetDataUpdateStats();
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    {
+        LvLockGuard gui_guard;
+        if (!phone->getDisplay().setPerfMonitorEnabled(true)) {
+            goto end;
+        }
+    }
+#endif
+    for (int i = 0; i < frame_num; i++) {
+        host_tick_ms += HOST_TEST_FRAME_PERIOD_MS;
+
+        int64_t start_us = esp_timer_get_time();
+        {
+            LvLockGuard gui_guard;
+            lv_timer_handler();
+        }
+        int64_t frame_us = esp_timer_get_time() - start_us;
+        frame_total_us += frame_us;
+        frame_max_us = std::max(frame_max_us, frame_us);
+    }
+
+    {
+        const HostDisplay::Stats &display_stats = display.getStats();
+        const auto &data_update_stats = phone->getDataUpdateStats();
+        ESP_LOGI(TAG, "Frames: %d, simulated %d ms, touch trace %s",
+                 frame_num, static_cast<int>(host_tick_ms), touch.checkFinished() ? "replayed" : "not finished");
+        ESP_LOGI(TAG, "Timer handler: avg %d us, max %d us", static_cast<int>(frame_total_us / frame_num),
+                 static_cast<int>(frame_max_us));
+        ESP_LOGI(TAG, "Flushes: %d, %d px", static_cast<int>(display_stats.flush_count),
+                 static_cast<int>(display_stats.flushed_px));
+        ESP_LOGI(TAG, "Data updates: %d, %d us, %d px invalidated", static_cast<int>(data_update_stats.dispatch_count),
+                 static_cast<int>(data_update_stats.total_time_us),
+                 static_cast<int>(data_update_stats.total_invalidated_px));
+    }
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+    LvLock::getInstance().dump();
+#endif
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    {
+        // Disabling the monitor logs the frames of every scene
+        LvLockGuard gui_guard;
+        phone->getDisplay().setPerfMonitorEnabled(false);
+    }
+#endif
+    ret = host_dump_span_trace();
+
+end:
+    {
+        LvLockGuard gui_guard;
+        delete phone;
+        touch.del();
+        display.del();
+    }
+    lv_deinit();
+
+    // The Linux target keeps running once `app_main()` returns
+    exit(ret ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstdio>
+#include "esp_log.h"
+#include "host_touch.hpp"
+
+static const char *TAG = "host_touch";
+
+HostTouch::~HostTouch()
+{
+    del();
+}
+
+bool HostTouch::begin(lv_display_t *display)
+{
+    _indev = lv_indev_create();
+    if (_indev == nullptr) {
+        ESP_LOGE(TAG, "Create input device failed");
+        return false;
+    }
+    lv_indev_set_type(_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_display(_indev, display);
+    lv_indev_set_read_cb(_indev, onRead);
+    lv_indev_set_user_data(_indev, this);
+    _index = 0;
+    _last_sample = {};
+
+    return true;
+}
+
+void HostTouch::del(void)
+{
+    if (_indev == nullptr) {
+        return;
+    }
+    lv_indev_delete(_indev);
+    _indev = nullptr;
+}
+
+bool HostTouch::loadTrace(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        ESP_LOGE(TAG, "Open trace(%s) failed", path);
+        return false;
+    }
+
+    char line[128];
+    int line_num = 0;
+    bool ret = true;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        line_num++;
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r')) {
+            continue;
+        }
+        unsigned time_ms = 0;
+        int x = 0;
+        int y = 0;
+        int pressed = 0;
+        if (sscanf(line, "%u %d %d %d", &time_ms, &x, &y, &pressed) != 4) {
+            ESP_LOGE(TAG, "Invalid sample at %s:%d", path, line_num);
+            ret = false;
+            break;
+        }
+        if (!_trace.empty() && (time_ms < _trace.back().time_ms)) {
+            ESP_LOGE(TAG, "Unsorted sample at %s:%d", path, line_num);
+            ret = false;
+            break;
+        }
+        _trace.push_back({time_ms, x, y, pressed != 0});
+    }
+    fclose(file);
+    ESP_LOGI(TAG, "Load %d samples from trace(%s)", static_cast<int>(_trace.size()), path);
+
+    return ret;
+}
+
+void HostTouch::appendTap(uint32_t start_ms, int32_t x, int32_t y, uint32_t duration_ms)
+{
+    _trace.push_back({start_ms, x, y, true});
+    _trace.push_back({start_ms + duration_ms, x, y, false});
+}
+
+void HostTouch::appendSwipe(
+    uint32_t start_ms, int32_t from_x, int32_t from_y, int32_t to_x, int32_t to_y, uint32_t duration_ms,
+    uint32_t step_ms
+)
+{
+    uint32_t steps = (step_ms > 0) ? (duration_ms / step_ms) : 0;
+
+    for (uint32_t i = 0; i <= steps; i++) {
+        int32_t x = from_x;
+        int32_t y = from_y;
+        if (steps > 0) {
+            x += (to_x - from_x) * static_cast<int32_t>(i) / static_cast<int32_t>(steps);
+            y += (to_y - from_y) * static_cast<int32_t>(i) / static_cast<int32_t>(steps);
+        }
+        _trace.push_back({start_ms + i * step_ms, x, y, true});
+    }
+    _trace.push_back({start_ms + duration_ms, to_x, to_y, false});
+}
+
+void HostTouch::onRead(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    HostTouch *touch = static_cast<HostTouch *>(lv_indev_get_user_data(indev));
+    if (touch == nullptr) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+
+    // Deliver the samples due at the current tick one by one, so none of them is dropped between two reads
+    uint32_t now_ms = lv_tick_get();
+    if ((touch->_index < touch->_trace.size()) && (touch->_trace[touch->_index].time_ms <= now_ms)) {
+        touch->_last_sample = touch->_trace[touch->_index++];
+    }
+    data->point.x = touch->_last_sample.x;
+    data->point.y = touch->_last_sample.y;
+    data->state = touch->_last_sample.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = (touch->_index < touch->_trace.size()) &&
+                             (touch->_trace[touch->_index].time_ms <= now_ms);
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lvgl.h"
+
+/**
+ * @brief Pointer input device which replays a touch trace against the LVGL tick, so the same trace always produces
+ *        the same gestures
+ */
+class HostTouch {
+public:
+    struct Sample {
+        uint32_t time_ms;
+        int32_t x;
+        int32_t y;
+        bool pressed;
+    };
+
+    HostTouch() = default;
+    ~HostTouch();
+
+    bool begin(lv_display_t *display);
+    void del(void);
+
+    /**
+     * @brief Load a trace from a text file, one sample per line as `<time_ms> <x> <y> <pressed>`. Empty lines and the
+     *        lines starting with `#` are skipped. The samples must be sorted by time.
+     */
+    bool loadTrace(const char *path);
+    void appendTap(uint32_t start_ms, int32_t x, int32_t y, uint32_t duration_ms);
+    void appendSwipe(uint32_t start_ms, int32_t from_x, int32_t from_y, int32_t to_x, int32_t to_y, uint32_t duration_ms,
+                     uint32_t step_ms);
+
+    lv_indev_t *get(void) const
+    {
+        return _indev;
+    }
+    uint32_t getEndTime(void) const
+    {
+        return _trace.empty() ? 0 : _trace.back().time_ms;
+    }
+    bool checkFinished(void) const
+    {
+        return (_index >= _trace.size());
+    }
+
+private:
+    static void onRead(lv_indev_t *indev, lv_indev_data_t *data);
+
+    std::vector<Sample> _trace;
+    size_t _index = 0;
+    Sample _last_sample = {};
+    lv_indev_t *_indev = nullptr;
+};
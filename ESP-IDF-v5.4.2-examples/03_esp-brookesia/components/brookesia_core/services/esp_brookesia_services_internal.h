@@ -30,4 +30,34 @@
 #           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_STORAGE_NVS_NAMESPACE)
+#       if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_NAMESPACE)
+#           define ESP_BROOKESIA_STORAGE_NVS_NAMESPACE  CONFIG_ESP_BROOKESIA_STORAGE_NVS_NAMESPACE
+#       else
+#           define ESP_BROOKESIA_STORAGE_NVS_NAMESPACE  "storage"
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK)
+#       if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK)
+#           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK  CONFIG_ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+#       else
+#           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK  (0)
+#       endif
+#   endif
+#   if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+#       if !defined(ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS)
+#           if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS)
+#               define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS  CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS
+#           else
+#               define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS  (500)
+#           endif
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD)
+#       if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD)
+#           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD  CONFIG_ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+#       else
+#           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD  (0)
+#       endif
+#   endif
 #endif
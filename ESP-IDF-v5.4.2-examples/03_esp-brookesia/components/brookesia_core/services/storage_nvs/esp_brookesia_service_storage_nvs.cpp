@@ -3,23 +3,50 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
 #include <map>
 #include <chrono>
+#include <cstring>
 #include "nvs_flash.h"
 #include "nvs.h"
 #include "private/esp_brookesia_service_storage_nvs_utils.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "esp_brookesia_service_storage_nvs.hpp"
 
 #define STORAGE_NVS_PARTITION_NAME          NVS_DEFAULT_PART_NAME
-#define STORAGE_NVS_NAMESPACE               "storage"
+#define STORAGE_NVS_NAMESPACE               ESP_BROOKESIA_STORAGE_NVS_NAMESPACE
 
 #define EVENT_THREAD_NAME                   "storage_nvs"
 #define EVENT_THREAD_STACK_SIZE             (4 * 1024)
 #define EVENT_THREAD_STACK_CAPS_EXT         (false)
 #define EVENT_WAIT_FINISH_TIMEOUT_MS_MAX    (60 * 60 * 1000)
 
+#define WRITE_BACK_RETRY_NUM_MAX            (3)
+
+// NVS has no float type, the bits are stored in the low word of a u64 whose high word is this tag ("FLT\0"), so that
+// the integers written by someone else are never read as floats
+#define NVS_FLOAT_TAG                       (0x464C5400ULL)
+
 namespace esp_brookesia::services {
 
+static_assert(StorageKey::NAME_LEN_MAX == NVS_KEY_NAME_MAX_SIZE - 1, "Invalid NVS key name max length");
+
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+static size_t get_value_bytes(const StorageNVS::Value &value)
+{
+    if (std::holds_alternative<std::string>(value)) {
+        return std::get<std::string>(value).size() + 1;
+    } else if (std::holds_alternative<float>(value) || std::holds_alternative<int64_t>(value)) {
+        return sizeof(uint64_t);
+    } else if (std::holds_alternative<StorageNVS::Blob>(value)) {
+        auto &blob = std::get<StorageNVS::Blob>(value);
+        return (blob != nullptr) ? blob->size() : 0;
+    }
+
+    return sizeof(int32_t);
+}
+#endif
+
 static const std::map<nvs_type_t, const char *> type_str_pair = {
     { NVS_TYPE_I8, "i8" },
     { NVS_TYPE_U8, "u8" },
@@ -34,6 +61,118 @@ static const std::map<nvs_type_t, const char *> type_str_pair = {
     { NVS_TYPE_ANY, "any" },
 };
 
+static esp_err_t read_nvs_value(nvs_handle_t nvs_handle, const char *key, nvs_type_t type, StorageNVS::Value &value)
+{
+    esp_err_t ret = ESP_ERR_NOT_SUPPORTED;
+    switch (type) {
+    case NVS_TYPE_I32: {
+        int32_t value_int = 0;
+        ret = nvs_get_i32(nvs_handle, key, &value_int);
+        if (ret == ESP_OK) {
+            value = static_cast<int>(value_int);
+        }
+        break;
+    }
+    case NVS_TYPE_STR: {
+        // The length is probed first, so that the strings of any length are read
+        size_t len = 0;
+        ret = nvs_get_str(nvs_handle, key, nullptr, &len);
+        if ((ret == ESP_OK) && (len > 0)) {
+            std::string value_str(len, '\0');
+            ret = nvs_get_str(nvs_handle, key, value_str.data(), &len);
+            if (ret == ESP_OK) {
+                // Without the terminator
+                value_str.resize(len - 1);
+                value = std::move(value_str);
+            }
+        }
+        break;
+    }
+    case NVS_TYPE_U64: {
+        uint64_t value_tagged = 0;
+        ret = nvs_get_u64(nvs_handle, key, &value_tagged);
+        if (ret != ESP_OK) {
+            break;
+        }
+        // Not a float written by the service
+        if ((value_tagged >> 32) != NVS_FLOAT_TAG) {
+            ret = ESP_ERR_NOT_SUPPORTED;
+            break;
+        }
+        uint32_t value_bits = static_cast<uint32_t>(value_tagged);
+        float value_float = 0;
+        memcpy(&value_float, &value_bits, sizeof(value_float));
+        value = value_float;
+        break;
+    }
+    case NVS_TYPE_I64: {
+        int64_t value_int64 = 0;
+        ret = nvs_get_i64(nvs_handle, key, &value_int64);
+        if (ret == ESP_OK) {
+            value = value_int64;
+        }
+        break;
+    }
+    case NVS_TYPE_BLOB: {
+        size_t len = 0;
+        ret = nvs_get_blob(nvs_handle, key, nullptr, &len);
+        if (ret == ESP_OK) {
+            std::shared_ptr<std::vector<uint8_t>> blob;
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                blob = std::make_shared<std::vector<uint8_t>>(len), ESP_ERR_NO_MEM, "Make key(%s) blob failed", key
+            );
+            ret = nvs_get_blob(nvs_handle, key, blob->data(), &len);
+            if (ret == ESP_OK) {
+                value = StorageNVS::Blob(std::move(blob));
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return ret;
+}
+
+static esp_err_t write_nvs_value(nvs_handle_t nvs_handle, const char *key, const StorageNVS::Value &value)
+{
+    if (std::holds_alternative<int>(value)) {
+        auto value_int = std::get<int>(value);
+        ESP_UTILS_LOGD("Set key(%s) value(%d)", key, value_int);
+
+        return nvs_set_i32(nvs_handle, key, static_cast<int32_t>(value_int));
+    } else if (std::holds_alternative<std::string>(value)) {
+        auto &value_str = std::get<std::string>(value);
+        ESP_UTILS_LOGD("Set key(%s) value(%s)", key, value_str.c_str());
+
+        return nvs_set_str(nvs_handle, key, value_str.c_str());
+    } else if (std::holds_alternative<float>(value)) {
+        auto value_float = std::get<float>(value);
+        ESP_UTILS_LOGD("Set key(%s) value(%f)", key, value_float);
+
+        uint32_t value_bits = 0;
+        memcpy(&value_bits, &value_float, sizeof(value_bits));
+
+        return nvs_set_u64(nvs_handle, key, (NVS_FLOAT_TAG << 32) | value_bits);
+    } else if (std::holds_alternative<int64_t>(value)) {
+        auto value_int64 = std::get<int64_t>(value);
+        ESP_UTILS_LOGD("Set key(%s) value(%lld)", key, static_cast<long long>(value_int64));
+
+        return nvs_set_i64(nvs_handle, key, value_int64);
+    } else if (std::holds_alternative<StorageNVS::Blob>(value)) {
+        auto &blob = std::get<StorageNVS::Blob>(value);
+        if (blob == nullptr) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        ESP_UTILS_LOGD("Set key(%s) blob(%d bytes)", key, static_cast<int>(blob->size()));
+
+        return nvs_set_blob(nvs_handle, key, blob->data(), blob->size());
+    }
+
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 void StorageNVS::Event::dump() const
 {
     ESP_UTILS_LOGI(
@@ -41,49 +180,59 @@ void StorageNVS::Event::dump() const
         "\t-Operation(%d)\n"
         "\t-Key(%s)\n",
         static_cast<int>(operation),
-        key.empty() ? "None" : key.c_str()
+        key.isValid() ? key.c_str() : "None"
+    );
+}
+
+void StorageNVS::WriteStats::dump() const
+{
+    size_t saved_commit_count = (request_count > commit_count) ? (request_count - commit_count) : 0;
+
+    ESP_UTILS_LOGI(
+        "{WriteStats}:\n"
+        "\t-Requests(%d)\n"
+        "\t-Key writes(%d)\n"
+        "\t-Commits(%d), saved(%d)\n"
+        "\t-Coalesced writes(%d), saved bytes(%d)\n",
+        static_cast<int>(request_count), static_cast<int>(key_write_count), static_cast<int>(commit_count),
+        static_cast<int>(saved_commit_count), static_cast<int>(coalesced_count), static_cast<int>(saved_bytes)
     );
 }
 
 bool StorageNVS::begin()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("StorageNVS::begin");
 
+    std::shared_ptr<std::promise<bool>> init_promise;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        init_promise = std::make_shared<std::promise<bool>>(), false, "Make init promise failed"
+    );
+    auto init_future = init_promise->get_future();
     {
         esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
             .name = EVENT_THREAD_NAME,
             .stack_size = EVENT_THREAD_STACK_SIZE,
             .stack_in_ext = EVENT_THREAD_STACK_CAPS_EXT,
         });
-        _event_thread = boost::thread([this]() {
+        _event_thread = boost::thread([this, init_promise]() {
             ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-            // Initialize NVS flash
-            esp_err_t ret = nvs_flash_init();
-            if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
-                ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_erase() == ESP_OK, false, "Erase NVS flash failed");
-                ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_init() == ESP_OK, false, "Init NVS flash failed");
-            } else {
-                ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Initialize NVS flash failed");
-            }
-
-            // Create NVS namespace if not exists
-            {
-                nvs_handle_t nvs_handle;
-                ESP_UTILS_CHECK_ERROR_RETURN(
-                    nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
-                );
-                esp_utils::function_guard nvs_close_guard([&]() {
-                    nvs_close(nvs_handle);
-                });
-                ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
-            }
+            bool is_initialized = initFlash();
+            init_promise->set_value(is_initialized);
+            ESP_UTILS_CHECK_FALSE_EXIT(is_initialized, "Init NVS flash failed");
 
             while (true) {
                 std::unique_lock<std::mutex> lock(_event_mutex);
-                _event_cv.wait(lock, [this] {
-                    return !_event_queue.empty();
-                });
+                if (_pending_writes.empty()) {
+                    _event_cv.wait(lock, [this] {
+                        return !_event_queue.empty() || !_pending_writes.empty();
+                    });
+                } else {
+                    _event_cv.wait_until(lock, _pending_deadline, [this] {
+                        return !_event_queue.empty();
+                    });
+                }
 
                 while (!_event_queue.empty()) {
                     auto event_wrapper = _event_queue.front();
@@ -97,11 +246,27 @@ bool StorageNVS::begin()
                         event_wrapper.promise->set_value(ret);
                     }
                 }
+
+                // The write-back window of the pending writes is over
+                if (!_pending_writes.empty() && (std::chrono::steady_clock::now() >= _pending_deadline)) {
+                    lock.unlock();
+                    if (!flushPendingWrites()) {
+                        ESP_UTILS_LOGE("Flush pending writes failed");
+                    }
+                }
             }
         });
     }
 
+    ESP_UTILS_CHECK_FALSE_RETURN(init_future.get(), false, "Init NVS flash failed");
+
     // Initialize NVS parameters
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+    // Loaded in the background, the parameters read before are loaded from NVS on their own
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+        .operation = Operation::UpdateParam,
+    }), false, "Send update NVS parameters event failed");
+#else
     EventFuture future;
     ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
         .operation = Operation::UpdateParam,
@@ -110,6 +275,7 @@ bool StorageNVS::begin()
     auto status = future.wait_for(std::chrono::milliseconds(EVENT_WAIT_FINISH_TIMEOUT_MS_MAX));
     ESP_UTILS_CHECK_FALSE_RETURN(status == std::future_status::ready, false, "Wait for update param event timeout");
     ESP_UTILS_CHECK_FALSE_RETURN(future.get(), false, "Update param event failed");
+#endif
 
     return true;
 }
@@ -135,6 +301,12 @@ bool StorageNVS::sendEvent(const Event &event, EventFuture *future)
 
     {
         std::lock_guard<std::mutex> lock(_event_mutex);
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+        // Until it is done, the missing keys are read from NVS on their own
+        if (event.operation == Operation::UpdateParam) {
+            _params_lazy_load_count++;
+        }
+#endif
         _event_queue.push(event_wrapper);
         _event_cv.notify_one();
     }
@@ -147,30 +319,89 @@ bool StorageNVS::setLocalParam(const Key &key, const Value &value, const void *s
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     ESP_UTILS_LOGD(
-        "Param: key(%s), value(%s), future(%p)", key.c_str(), std::holds_alternative<int>(value) ?
-        std::to_string(std::get<int>(value)).c_str() : std::get<std::string>(value).c_str(), future
+        "Param: key(%s), value(%s), future(%p)", key.c_str(), getValueString(value).c_str(), future
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(key.isValid(), false, "Invalid NVS key");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        !std::holds_alternative<Blob>(value) || (std::get<Blob>(value) != nullptr), false, "Invalid blob value"
     );
 
     {
         std::lock_guard<std::mutex> lock(_params_mutex);
-        _local_params[key] = value;
+        std::shared_ptr<Params> params;
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            params = std::make_shared<Params>(*_local_params), false, "Make local params failed"
+        );
+        (*params)[key] = value;
+        publishLocalParams(std::move(params));
+        _params_unsaved_counts[key]++;
     }
 
-    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+    std::shared_ptr<EventPromise> promise;
+    if (future != nullptr) {
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            promise = std::make_shared<EventPromise>(), false, "Make event promise failed"
+        );
+        *future = promise->get_future();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        // The window starts with the first pending write, so that continuous writes are still committed in time
+        if (_pending_writes.empty()) {
+            _pending_deadline = std::chrono::steady_clock::now() +
+                                std::chrono::milliseconds(ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS);
+        }
+        auto [it, is_new] = _pending_writes.try_emplace(key);
+        auto &pending_write = it->second;
+        if (!is_new) {
+            _write_stats.coalesced_count++;
+            _write_stats.saved_bytes += pending_write.value_bytes;
+        }
+        pending_write.sender = sender;
+        pending_write.value_bytes = get_value_bytes(value);
+        pending_write.set_count++;
+        if (promise != nullptr) {
+            pending_write.promises.push_back(promise);
+        }
+        _write_stats.request_count++;
+        _event_cv.notify_one();
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        _write_stats.request_count++;
+    }
+
+    bool ret = sendEvent({
         .sender = sender,
         .operation = Operation::UpdateNVS,
         .key = key,
-    }, future), false, "Send update NVS event failed");
+    }, future);
+    if (!ret) {
+        // Never written
+        releaseUnsavedParam(key, 1);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Send update NVS event failed");
+#endif
 
     return true;
 }
 
-bool StorageNVS::getLocalParam(const Key &key, Value &value)
+bool StorageNVS::getLocalParam(const Key &key, Value &value) const
 {
-    std::lock_guard<std::mutex> lock(_params_mutex);
-
-    auto it = _local_params.find(key);
-    if (it == _local_params.end()) {
+    // The reference to the snapshot is only held during the call, so that the replaced snapshots and their blobs are
+    // freed as soon as the writers publish new ones
+    auto params = getLocalParams();
+    auto it = params->find(key);
+    if (it == params->end()) {
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+        // Not loaded yet, read it from NVS on its own
+        if ((_params_lazy_load_count > 0) && loadLocalParam(key, value)) {
+            return true;
+        }
+#endif
         ESP_UTILS_LOGW("NVS key(%s) not found", key.c_str());
         return false;
     }
@@ -180,6 +411,11 @@ bool StorageNVS::getLocalParam(const Key &key, Value &value)
     return true;
 }
 
+std::shared_ptr<const StorageNVS::Params> StorageNVS::getLocalParams() const
+{
+    return std::atomic_load(&_local_params);
+}
+
 bool StorageNVS::eraseNVS(const void *sender, EventFuture *future)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -194,6 +430,34 @@ bool StorageNVS::eraseNVS(const void *sender, EventFuture *future)
     return true;
 }
 
+bool StorageNVS::flush(const void *sender, EventFuture *future)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: future(%p)", future);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+        .sender = sender,
+        .operation = Operation::FlushNVS,
+    }, future), false, "Send flush NVS event failed");
+
+    return true;
+}
+
+StorageNVS::WriteStats StorageNVS::getWriteStats()
+{
+    std::lock_guard<std::mutex> lock(_event_mutex);
+
+    return _write_stats;
+}
+
+void StorageNVS::resetWriteStats()
+{
+    std::lock_guard<std::mutex> lock(_event_mutex);
+
+    _write_stats = {};
+}
+
 boost::signals2::connection StorageNVS::connectEventSignal(EventSignal::slot_type slot)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -201,6 +465,67 @@ boost::signals2::connection StorageNVS::connectEventSignal(EventSignal::slot_typ
     return _event_signal.connect(slot);
 }
 
+void StorageNVS::publishLocalParams(std::shared_ptr<const Params> params) const
+{
+    std::atomic_store(&_local_params, std::move(params));
+}
+
+bool StorageNVS::initFlash()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("StorageNVS::initFlash");
+
+    // Initialize NVS flash
+    esp_err_t ret = nvs_flash_init();
+    if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_erase() == ESP_OK, false, "Erase NVS flash failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_init() == ESP_OK, false, "Init NVS flash failed");
+    } else {
+        ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Initialize NVS flash failed");
+    }
+
+    // Create NVS namespace if not exists
+    nvs_handle_t nvs_handle;
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
+    );
+    esp_utils::function_guard nvs_close_guard([&]() {
+        nvs_close(nvs_handle);
+    });
+    ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
+
+    return true;
+}
+
+StorageNVS::Blob StorageNVS::makeBlob(const void *data, size_t size)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) || (size == 0), nullptr, "Invalid data");
+
+    auto bytes = static_cast<const uint8_t *>(data);
+    Blob blob;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        blob = std::make_shared<const std::vector<uint8_t>>(bytes, bytes + size), nullptr, "Make blob failed"
+    );
+
+    return blob;
+}
+
+std::string StorageNVS::getValueString(const Value &value)
+{
+    if (std::holds_alternative<int>(value)) {
+        return std::to_string(std::get<int>(value));
+    } else if (std::holds_alternative<std::string>(value)) {
+        return std::get<std::string>(value);
+    } else if (std::holds_alternative<float>(value)) {
+        return std::to_string(std::get<float>(value));
+    } else if (std::holds_alternative<int64_t>(value)) {
+        return std::to_string(std::get<int64_t>(value));
+    }
+
+    auto &blob = std::get<Blob>(value);
+    return "blob(" + std::to_string((blob != nullptr) ? blob->size() : 0) + " bytes)";
+}
+
 bool StorageNVS::processEvent(const Event &event)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -212,7 +537,12 @@ bool StorageNVS::processEvent(const Event &event)
 
     switch (event.operation) {
     case Operation::UpdateNVS: {
-        ESP_UTILS_CHECK_FALSE_RETURN(doEventOperationUpdateNVS(event.key), false, "Update NVS failed");
+        std::vector<Key> skipped_keys;
+        bool ret = doEventOperationUpdateNVS({event.key}, skipped_keys);
+        // Written or given up, the value in NVS is as new as the one the event was sent for
+        releaseUnsavedParam(event.key, 1);
+        dropSkippedParams(skipped_keys);
+        ESP_UTILS_CHECK_FALSE_RETURN(ret && skipped_keys.empty(), false, "Update NVS failed");
         break;
     }
     case Operation::UpdateParam: {
@@ -220,9 +550,15 @@ bool StorageNVS::processEvent(const Event &event)
         break;
     }
     case Operation::EraseNVS: {
+        // Written first, so that they are erased too
+        ESP_UTILS_CHECK_FALSE_RETURN(flushPendingWrites(), false, "Flush pending writes failed");
         ESP_UTILS_CHECK_FALSE_RETURN(doEventOperationEraseNVS(), false, "Erase NVS failed");
         break;
     }
+    case Operation::FlushNVS: {
+        ESP_UTILS_CHECK_FALSE_RETURN(flushPendingWrites(), false, "Flush pending writes failed");
+        break;
+    }
     default:
         ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid operation(%d)", static_cast<int>(event.operation));
     }
@@ -232,51 +568,139 @@ bool StorageNVS::processEvent(const Event &event)
     return true;
 }
 
-bool StorageNVS::doEventOperationUpdateNVS(const Key &key)
+bool StorageNVS::flushPendingWrites()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    ESP_UTILS_LOGD("Param: key(%s)", key.c_str());
+    std::map<Key, PendingWrite> pending_writes;
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        pending_writes.swap(_pending_writes);
+    }
+    if (pending_writes.empty()) {
+        return true;
+    }
 
-    std::lock_guard<std::mutex> lock(_params_mutex);
+    std::vector<Key> keys;
+    keys.reserve(pending_writes.size());
+    for (auto &[key, pending_write] : pending_writes) {
+        keys.push_back(key);
+    }
+    ESP_UTILS_LOGD("Flush %d pending keys", static_cast<int>(keys.size()));
+
+    std::vector<Key> skipped_keys;
+    bool is_committed = doEventOperationUpdateNVS(keys, skipped_keys);
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+    if (!is_committed) {
+        // Nothing reached the flash, the keys are retried in the next window and their futures stay pending until the
+        // retries run out. A key written again meanwhile is already pending with its newer value, which resolves them
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        size_t retry_key_count = 0;
+        for (auto it = pending_writes.begin(); it != pending_writes.end();) {
+            auto &pending_write = it->second;
+            if (pending_write.retry_count >= WRITE_BACK_RETRY_NUM_MAX) {
+                it++;
+                continue;
+            }
+            pending_write.retry_count++;
+            if (_pending_writes.empty()) {
+                _pending_deadline = std::chrono::steady_clock::now() +
+                                    std::chrono::milliseconds(ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_WINDOW_MS);
+            }
+            auto [pending_it, is_new] = _pending_writes.try_emplace(it->first, std::move(pending_write));
+            if (!is_new) {
+                auto &newer_write = pending_it->second;
+                newer_write.set_count += pending_write.set_count;
+                newer_write.promises.insert(
+                    newer_write.promises.end(), pending_write.promises.begin(), pending_write.promises.end()
+                );
+            }
+            it = pending_writes.erase(it);
+            retry_key_count++;
+        }
+        if (retry_key_count > 0) {
+            ESP_UTILS_LOGW("Retry %d keys in the next window", static_cast<int>(retry_key_count));
+        }
+        if (!pending_writes.empty()) {
+            ESP_UTILS_LOGE(
+                "Give up %d keys after %d failed commits", static_cast<int>(pending_writes.size()),
+                WRITE_BACK_RETRY_NUM_MAX + 1
+            );
+        }
+    }
+#endif
 
-    auto it = _local_params.find(key);
-    ESP_UTILS_CHECK_FALSE_RETURN(
-        it != _local_params.end(), false, "Invalid NVS key(%s)", key.c_str()
-    );
-    ESP_UTILS_LOGD("Update key(%s) NVS parameter", key.c_str());
+    // Written or given up, the keys are not newer than NVS anymore
+    for (auto &[key, pending_write] : pending_writes) {
+        releaseUnsavedParam(key, pending_write.set_count);
+    }
+    dropSkippedParams(skipped_keys);
+
+    // The futures are resolved once the keys are durable, or given up, and after the signal like the other events
+    for (auto &[key, pending_write] : pending_writes) {
+        bool ret = is_committed && (std::find(skipped_keys.begin(), skipped_keys.end(), key) == skipped_keys.end());
+        if (ret) {
+            _event_signal(Event{
+                .sender = pending_write.sender,
+                .operation = Operation::UpdateNVS,
+                .key = key,
+            });
+        }
+        for (auto &promise : pending_write.promises) {
+            promise->set_value(ret);
+        }
+        pending_write.promises.clear();
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(is_committed && skipped_keys.empty(), false, "Update NVS failed");
 
-    nvs_handle_t nvs_handle;
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
-    );
+    return true;
+}
 
-    esp_utils::function_guard nvs_close_guard([&]() {
-        nvs_close(nvs_handle);
-    });
+bool StorageNVS::doEventOperationUpdateNVS(const std::vector<Key> &keys, std::vector<Key> &skipped_keys)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    auto &value = it->second;
-    const char *key_str = key.c_str();
+    ESP_UTILS_LOGD("Param: keys(%d)", static_cast<int>(keys.size()));
 
-    if (std::holds_alternative<int>(value)) {
-        auto value_int = std::get<int>(value);
-        ESP_UTILS_LOGD("Set key(%s) value(%d)", key_str, value_int);
+    {
+        // The writers are not blocked while the keys are written to NVS
+        auto params = getLocalParams();
 
+        // The keys are written with a single open and commit
+        nvs_handle_t nvs_handle;
         ESP_UTILS_CHECK_ERROR_RETURN(
-            nvs_set_i32(nvs_handle, key_str, static_cast<int32_t>(value_int)), false, "Set NVS parameter failed"
+            nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
         );
-    } else if (std::holds_alternative<std::string>(value)) {
-        auto value_str = std::get<std::string>(value);
-        ESP_UTILS_LOGD("Set key(%s) value(%s)", key_str, value_str.c_str());
 
-        ESP_UTILS_CHECK_ERROR_RETURN(
-            nvs_set_str(nvs_handle, key_str, value_str.c_str()), false, "Set NVS parameter failed"
-        );
-    } else {
-        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid NVS key(%s) value type", key_str);
+        esp_utils::function_guard nvs_close_guard([&]() {
+            nvs_close(nvs_handle);
+        });
+
+        // A bad key is skipped, so that it doesn't hold back the other keys of the batch
+        for (auto &key : keys) {
+            ESP_UTILS_LOGD("Update key(%s) NVS parameter", key.c_str());
+
+            auto it = params->find(key);
+            if (it == params->end()) {
+                ESP_UTILS_LOGE("Invalid NVS key(%s), skip it", key.c_str());
+                skipped_keys.push_back(key);
+                continue;
+            }
+            esp_err_t ret = write_nvs_value(nvs_handle, key.c_str(), it->second);
+            if (ret != ESP_OK) {
+                ESP_UTILS_LOGE("Set NVS key(%s) failed(%s), skip it", key.c_str(), esp_err_to_name(ret));
+                skipped_keys.push_back(key);
+            }
+        }
+
+        ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
     }
 
-    ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        _write_stats.key_write_count += keys.size() - skipped_keys.size();
+        _write_stats.commit_count++;
+    }
 
     return true;
 }
@@ -284,8 +708,96 @@ bool StorageNVS::doEventOperationUpdateNVS(const Key &key)
 bool StorageNVS::doEventOperationUpdateParam()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("StorageNVS::loadParams");
 
-    std::lock_guard<std::mutex> lock(_params_mutex);
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+    esp_utils::function_guard lazy_load_guard([this]() {
+        _params_lazy_load_count--;
+    });
+#endif
+
+    auto start_time = std::chrono::steady_clock::now();
+    // The parameters are not locked while NVS is read, so that the readers loading a key on their own don't wait for
+    // the whole scan. The loaded keys are merged afterwards
+    Params loaded_params;
+
+    {
+        nvs_handle_t nvs_handle;
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            nvs_open(STORAGE_NVS_NAMESPACE, NVS_READONLY, &nvs_handle), false, "Open NVS namespace failed"
+        );
+
+        esp_utils::function_guard nvs_close_guard([&]() {
+            nvs_close(nvs_handle);
+        });
+
+        ESP_UTILS_LOGD("Finding keys in NVS...");
+
+        nvs_iterator_t it = NULL;
+        esp_err_t res = nvs_entry_find(STORAGE_NVS_PARTITION_NAME, STORAGE_NVS_NAMESPACE, NVS_TYPE_ANY, &it);
+        while (res == ESP_OK) {
+            nvs_entry_info_t info;
+            res = nvs_entry_info(it, &info);
+            if (res != ESP_OK) {
+                ESP_UTILS_LOGE("Get key info failed");
+                break;
+            }
+
+            auto type_str_it = type_str_pair.find(info.type);
+            if (type_str_it == type_str_pair.end()) {
+                ESP_UTILS_LOGE("\t- Invalid NVS key(%s) type(%d)", info.key, static_cast<int>(info.type));
+                res = nvs_entry_next(&it);
+                continue;
+            }
+
+            Value value;
+            esp_err_t ret = read_nvs_value(nvs_handle, info.key, info.type, value);
+            if (ret == ESP_ERR_NOT_SUPPORTED) {
+                ESP_UTILS_LOGD("\t- Skip key(%s): type(%s)", info.key, type_str_it->second);
+            } else if (ret != ESP_OK) {
+                ESP_UTILS_LOGE("\t- Get key(%s) value failed", info.key);
+            } else {
+                ESP_UTILS_LOGD(
+                    "\t- Found key(%s): type(%s), value(%s)", info.key, type_str_it->second,
+                    getValueString(value).c_str()
+                );
+                loaded_params.insert_or_assign(Key(std::string_view(info.key)), std::move(value));
+            }
+            res = nvs_entry_next(&it);
+        }
+        nvs_release_iterator(it);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_params_mutex);
+        std::shared_ptr<Params> params;
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            params = std::make_shared<Params>(*_local_params), false, "Make local params failed"
+        );
+        // The first load keeps all the parameters set or loaded before, they are at least as new as the ones in NVS. A
+        // reload only keeps the ones not written to NVS yet
+        for (auto &[key, value] : loaded_params) {
+            auto [it, is_new] = params->try_emplace(key, value);
+            if (!is_new && _is_params_loaded && (_params_unsaved_counts.find(key) == _params_unsaved_counts.end())) {
+                it->second = std::move(value);
+            }
+        }
+        publishLocalParams(std::move(params));
+        _is_params_loaded = true;
+    }
+
+    ESP_UTILS_LOGI(
+        "Loaded %d keys from NVS in %d ms", static_cast<int>(loaded_params.size()), static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count()
+        )
+    );
+
+    return true;
+}
+
+bool StorageNVS::loadLocalParam(const Key &key, Value &value) const
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     nvs_handle_t nvs_handle;
     ESP_UTILS_CHECK_ERROR_RETURN(
@@ -296,63 +808,77 @@ bool StorageNVS::doEventOperationUpdateParam()
         nvs_close(nvs_handle);
     });
 
-    ESP_UTILS_LOGI("Finding keys in NVS...");
+    nvs_type_t type = NVS_TYPE_ANY;
+    if (nvs_find_key(nvs_handle, key.c_str(), &type) != ESP_OK) {
+        return false;
+    }
 
-    nvs_iterator_t it = NULL;
-    esp_err_t res = nvs_entry_find(STORAGE_NVS_PARTITION_NAME, STORAGE_NVS_NAMESPACE, NVS_TYPE_ANY, &it);
-    while (res == ESP_OK) {
-        nvs_entry_info_t info;
-        res = nvs_entry_info(it, &info);
-        if (res != ESP_OK) {
-            ESP_UTILS_LOGE("Get key info failed");
-            break;
-        }
+    Value loaded_value;
+    esp_err_t ret = read_nvs_value(nvs_handle, key.c_str(), type, loaded_value);
+    if (ret == ESP_ERR_NOT_SUPPORTED) {
+        ESP_UTILS_LOGD("Skip key(%s): unsupported value", key.c_str());
+        return false;
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Get key(%s) value failed", key.c_str());
 
-        auto type_str_it = type_str_pair.find(info.type);
-        if (type_str_it == type_str_pair.end()) {
-            ESP_UTILS_LOGE("\t- Invalid NVS key(%s) type(%d)", info.key, static_cast<int>(info.type));
-            res = nvs_entry_next(&it);
-            continue;
+    {
+        std::lock_guard<std::mutex> lock(_params_mutex);
+        std::shared_ptr<Params> params;
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            params = std::make_shared<Params>(*_local_params), false, "Make local params failed"
+        );
+        // Set or loaded meanwhile, the value in the parameters is at least as new
+        auto [it, is_new] = params->try_emplace(key, std::move(loaded_value));
+        value = it->second;
+        if (is_new) {
+            publishLocalParams(std::move(params));
         }
+    }
+    ESP_UTILS_LOGD("Loaded key(%s) on first access", key.c_str());
 
-        esp_err_t ret = ESP_OK;
-        switch (info.type) {
-        case NVS_TYPE_I32: {
-            int32_t value_int;
-            ret = nvs_get_i32(nvs_handle, info.key, &value_int);
-            if (ret != ESP_OK) {
-                ESP_UTILS_LOGE("\t- Get key(%s) value failed", info.key);
-            } else {
-                ESP_UTILS_LOGI(
-                    "\t- Found key(%s): type(%s), value(%d)", info.key, type_str_it->second, static_cast<int>(value_int)
-                );
-                _local_params[info.key] = Value(static_cast<int>(value_int));
-            }
-            break;
-        }
-        case NVS_TYPE_STR: {
-            size_t len = NVS_VALUE_STR_MAX_LEN;
-            std::unique_ptr<char[]> value_str(new char[len]);
-            ret = nvs_get_str(nvs_handle, info.key, value_str.get(), &len);
-            if (ret != ESP_OK) {
-                ESP_UTILS_LOGE("\t- Get key(%s) value failed", info.key);
-            } else {
-                ESP_UTILS_LOGI(
-                    "\t- Found key(%s): type(%s), value(%s)", info.key, type_str_it->second, value_str.get()
-                );
-                _local_params[info.key] = Value(std::string(value_str.get()));
-            }
-            break;
+    return true;
+}
+
+void StorageNVS::releaseUnsavedParam(const Key &key, uint32_t set_count)
+{
+    std::lock_guard<std::mutex> lock(_params_mutex);
+    // The events sent by the users are not counted
+    auto it = _params_unsaved_counts.find(key);
+    if (it == _params_unsaved_counts.end()) {
+        return;
+    }
+    if (it->second <= set_count) {
+        _params_unsaved_counts.erase(it);
+    } else {
+        it->second -= set_count;
+    }
+}
+
+bool StorageNVS::dropSkippedParams(const std::vector<Key> &keys)
+{
+    if (keys.empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_params_mutex);
+    std::shared_ptr<Params> params;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        params = std::make_shared<Params>(*_local_params), false, "Make local params failed"
+    );
+    bool is_changed = false;
+    for (auto &key : keys) {
+        // Set again meanwhile, the newer value is still to be written
+        if (_params_unsaved_counts.find(key) != _params_unsaved_counts.end()) {
+            continue;
         }
-        default:
-            ESP_UTILS_LOGI("\t- Skip key(%s): type(%s)", info.key, type_str_it->second);
-            break;
+        if (params->erase(key) > 0) {
+            ESP_UTILS_LOGW("Drop key(%s) which can't be written to NVS", key.c_str());
+            is_changed = true;
         }
-        res = nvs_entry_next(&it);
     }
-    nvs_release_iterator(it);
-
-    ESP_UTILS_LOGI("Found %d keys in NVS", static_cast<int>(_local_params.size()));
+    if (is_changed) {
+        publishLocalParams(std::move(params));
+    }
 
     return true;
 }
@@ -375,6 +901,20 @@ bool StorageNVS::doEventOperationEraseNVS()
     ESP_UTILS_CHECK_ERROR_RETURN(nvs_erase_all(nvs_handle), false, "Erase NVS failed");
     ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
 
+    {
+        std::lock_guard<std::mutex> lock(_params_mutex);
+        std::shared_ptr<Params> params;
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(params = std::make_shared<Params>(), false, "Make local params failed");
+        // The keys set after the erase was sent are still written to NVS afterwards
+        for (auto &[key, set_count] : _params_unsaved_counts) {
+            auto it = _local_params->find(key);
+            if (it != _local_params->end()) {
+                params->insert_or_assign(key, it->second);
+            }
+        }
+        publishLocalParams(std::move(params));
+    }
+
     return true;
 }
 
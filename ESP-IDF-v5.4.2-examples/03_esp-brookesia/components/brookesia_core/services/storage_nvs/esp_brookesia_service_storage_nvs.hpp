@@ -5,27 +5,140 @@
  */
 #pragma once
 
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <queue>
 #include <future>
 #include <variant>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "boost/thread.hpp"
 #include "boost/signals2.hpp"
 
 namespace esp_brookesia::services {
 
-constexpr size_t NVS_VALUE_STR_MAX_LEN = 128;
+constexpr size_t NVS_VALUE_STR_MAX_LEN = 128;  // Deprecated, the strings are read with their stored length
+
+/**
+ * @brief Key of a `StorageNVS` parameter, the NVS key name with its hash. Created from a literal, the hash is computed
+ *        and the name is checked against the NVS key length limit at compile time. It doesn't allocate, and keys are
+ *        compared by their hash first
+ */
+class StorageKey {
+public:
+    static constexpr size_t NAME_LEN_MAX = 15;  // `NVS_KEY_NAME_MAX_SIZE` without the terminator
+
+    constexpr StorageKey() = default;
+
+    template <size_t N>
+    constexpr StorageKey(const char (&name)[N]):
+        StorageKey(std::string_view(name, getLength(name, N - 1)))
+    {
+        static_assert(N > 1, "NVS key name is empty");
+        static_assert(N - 1 <= NAME_LEN_MAX, "NVS key name is longer than 15 characters");
+    }
+
+    /**
+     * @brief Create a key from a name only known at runtime, such as the ones found in NVS. The key is invalid if the
+     *        name is empty or too long
+     */
+    explicit constexpr StorageKey(std::string_view name)
+    {
+        if (name.empty() || (name.size() > NAME_LEN_MAX)) {
+            return;
+        }
+        for (size_t i = 0; i < name.size(); i++) {
+            _name[i] = name[i];
+        }
+        _length = static_cast<uint8_t>(name.size());
+        _hash = getHash(name);
+    }
+
+    constexpr bool isValid() const
+    {
+        return (_length > 0);
+    }
+
+    constexpr uint32_t getHash() const
+    {
+        return _hash;
+    }
+
+    constexpr std::string_view getName() const
+    {
+        return std::string_view(_name, _length);
+    }
+
+    constexpr const char *c_str() const
+    {
+        return _name;
+    }
+
+    constexpr bool operator==(const StorageKey &other) const
+    {
+        return (_hash == other._hash) && (getName() == other.getName());
+    }
+
+    constexpr bool operator!=(const StorageKey &other) const
+    {
+        return !(*this == other);
+    }
+
+    // Ordered by hash, the names only break the ties
+    constexpr bool operator<(const StorageKey &other) const
+    {
+        return (_hash != other._hash) ? (_hash < other._hash) : (getName() < other.getName());
+    }
+
+    /**
+     * @brief FNV-1a hash of a key name
+     */
+    static constexpr uint32_t getHash(std::string_view name)
+    {
+        uint32_t hash = 2166136261U;
+        for (char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619U;
+        }
+
+        return hash;
+    }
+
+private:
+    static constexpr size_t getLength(const char *name, size_t size_max)
+    {
+        size_t length = 0;
+        while ((length < size_max) && (name[length] != '\0')) {
+            length++;
+        }
+
+        return length;
+    }
+
+    uint32_t _hash = 0;
+    uint8_t _length = 0;
+    char _name[NAME_LEN_MAX + 1] = {};
+};
 
 class StorageNVS {
 public:
-    using Key = std::string;
-    using Value = std::variant<int, std::string>;
+    using Key = StorageKey;
+    // Immutable and shared, so that the readers of a blob never copy it
+    using Blob = std::shared_ptr<const std::vector<uint8_t>>;
+    // Stored in NVS as i32, str, u64 (the bits of the float with a tag), i64 and blob. The u32 and the untagged u64
+    // entries are not loaded
+    using Value = std::variant<int, std::string, float, int64_t, Blob>;
+    using Params = std::map<Key, Value>;
 
     enum class Operation {
         UpdateNVS,
         UpdateParam,
         EraseNVS,
+        FlushNVS,
         Max,
     };
 
@@ -39,6 +152,20 @@ public:
     using EventFuture = std::future<bool>;
     using EventSignal = boost::signals2::signal<void(const Event &event)>;
 
+    /**
+     * @brief Statistics of the writes to NVS. With the write-back, the writes of a key within the window are
+     *        coalesced, and the pending keys are written with a single commit
+     */
+    struct WriteStats {
+        void dump() const;
+
+        size_t request_count = 0;       // Parameters set by `setLocalParam()`
+        size_t key_write_count = 0;     // Keys written to NVS
+        size_t commit_count = 0;        // Commits of the written keys
+        size_t coalesced_count = 0;     // Writes superseded by a later one of the same key before the commit
+        size_t saved_bytes = 0;         // Value bytes of the superseded writes, never written to flash
+    };
+
     StorageNVS(const StorageNVS &) = delete;
     StorageNVS(StorageNVS &&) = delete;
     ~StorageNVS() = default;
@@ -51,11 +178,35 @@ public:
     bool sendEvent(const Event &event, EventFuture *future = nullptr);
 
     bool setLocalParam(const Key &key, const Value &value, const void *sender = nullptr, EventFuture *future = nullptr);
-    bool getLocalParam(const Key &key, Value &value);
+    /**
+     * @brief Get a parameter from the snapshot of the local parameters, without waiting for the writers
+     */
+    bool getLocalParam(const Key &key, Value &value) const;
+    /**
+     * @brief Get the snapshot of the local parameters. It is immutable and stays valid while it is held, so that
+     *        several parameters can be read without copying them
+     */
+    std::shared_ptr<const Params> getLocalParams() const;
+    /**
+     * @brief Erase the parameters from NVS and from the local parameters, except the ones set after the call which are
+     *        still written afterwards
+     */
     bool eraseNVS(const void *sender = nullptr, EventFuture *future = nullptr);
+    /**
+     * @brief Commit the pending writes at once, without waiting for the end of the write-back window
+     */
+    bool flush(const void *sender = nullptr, EventFuture *future = nullptr);
+
+    WriteStats getWriteStats();
+    void resetWriteStats();
 
     boost::signals2::connection connectEventSignal(EventSignal::slot_type slot);
 
+    /**
+     * @brief Make a blob value from a copy of the data. Return `nullptr` if failed
+     */
+    static Blob makeBlob(const void *data, size_t size);
+
     static StorageNVS &requestInstance()
     {
         static StorageNVS instance;
@@ -68,20 +219,57 @@ private:
         Event event;
         std::shared_ptr<EventPromise> promise;
     };
+    struct PendingWrite {
+        const void *sender = nullptr;   // Sender of the last write
+        size_t value_bytes = 0;
+        uint32_t set_count = 0;         // Writes coalesced into this one
+        uint32_t retry_count = 0;       // Commits retried after a failure
+        std::vector<std::shared_ptr<EventPromise>> promises;
+    };
 
     StorageNVS() = default;
 
+    static std::string getValueString(const Value &value);
+
+    void publishLocalParams(std::shared_ptr<const Params> params) const;
+    bool initFlash();
+    bool loadLocalParam(const Key &key, Value &value) const;
     bool processEvent(const Event &event);
-    bool doEventOperationUpdateNVS(const Key &key);
+    bool flushPendingWrites();
+    /**
+     * @brief Record that `set_count` writes of the key have reached NVS, or have been given up
+     */
+    void releaseUnsavedParam(const Key &key, uint32_t set_count);
+    /**
+     * @brief Drop the keys which NVS refused from the local parameters, unless they have been set again meanwhile
+     */
+    bool dropSkippedParams(const std::vector<Key> &keys);
+    /**
+     * @brief Write the keys with a single commit. The keys which can't be written are added to `skipped_keys` and
+     *        the other ones are still committed
+     *
+     * @return `false` if nothing could be committed
+     */
+    bool doEventOperationUpdateNVS(const std::vector<Key> &keys, std::vector<Key> &skipped_keys);
     bool doEventOperationUpdateParam();
     bool doEventOperationEraseNVS();
 
-    std::map<Key, Value> _local_params;
-    std::mutex _params_mutex;
+    // Replaced by the writers on every update, the readers only take a reference to the current one. Mutable since the
+    // const readers may add the keys they load on their own while the parameters are loaded in the background
+    mutable std::shared_ptr<const Params> _local_params = std::make_shared<const Params>();
+    mutable std::mutex _params_mutex;   // Serializes the writers, never held while NVS is read
+    bool _is_params_loaded = false;
+    // Writes of each key set but not in NVS yet, they are newer than NVS and a reload keeps them. Guarded by
+    // `_params_mutex`
+    std::map<Key, uint32_t> _params_unsaved_counts;
+    std::atomic<uint32_t> _params_lazy_load_count = 0;  // Loads not done in lazy mode, the missing keys may be in NVS
 
     std::queue<EventWrapper> _event_queue;
     std::mutex _event_mutex;
     std::condition_variable _event_cv;
+    std::map<Key, PendingWrite> _pending_writes;
+    std::chrono::steady_clock::time_point _pending_deadline;
+    WriteStats _write_stats;
     boost::thread _event_thread;
     EventSignal _event_signal;
 };
@@ -102,11 +102,13 @@ bool App::startRecordResource(void)
 bool App::endRecordResource(void)
 {
     bool ret = true;
+    bool is_new = false;
     uint32_t resource_loop_count = 0;
     lv_display_t *disp = nullptr;
     lv_obj_t *screen = nullptr;
     lv_timer_t *timer_node = nullptr;
     lv_anim_t *anim_node = nullptr;
+    AppResourceTracker::Node *node = nullptr;
     const lv_area_t &visual_area = _app_style.calibrate_visual_area;
 
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
@@ -120,17 +122,22 @@ bool App::endRecordResource(void)
     disp = _system_context->getDisplayDevice();
     ESP_UTILS_CHECK_NULL_RETURN(disp, false, "Invalid display");
 
+    // Only the resources created since `startRecordResource()` are visited: new screens are appended to the display,
+    // new timers and animations are inserted at the head of their lists
     // Screen
     resource_loop_count = 0;
     for (int i = _resource_head_screen_index + 1; (i < (int)disp->screen_cnt) &&
             (resource_loop_count++ <  RESOURCE_LOOP_COUNT_MAX); i++) {
         screen = (lv_obj_t *)disp->screens[i];
         // Record or update the record information of the screen
-        _resource_screens_class_parent_map[screen] = {screen->class_p, (lv_obj_t *)screen->parent};
-        if (find(_resource_screens.begin(), _resource_screens.end(), screen) == _resource_screens.end()) {
-            // Only record the newest timer
-            _resource_screens.push_back(screen);
-            _resource_screen_count++;
+        node = _resource_tracker.attach(
+                   AppResourceTracker::Type::SCREEN, screen, screen->class_p, screen->parent, is_new
+               );
+        if (node == nullptr) {
+            ESP_UTILS_LOGD("Screen(@0x%p) is recorded by another app, skip", screen);
+        } else if (is_new) {
+            node->unhook = unhookTrackedResource;
+            lv_obj_add_event_cb(screen, onTrackedScreenDeleteEventCallback, LV_EVENT_DELETE, nullptr);
             // Move screens to visual area when loaded only if needed
             if (_active_config.flags.enable_resize_visual_area) {
                 lv_obj_set_pos(screen, visual_area.x1, visual_area.y1);
@@ -143,13 +150,11 @@ bool App::endRecordResource(void)
         }
     }
     if ((_resource_head_screen_index >= (int)disp->screen_cnt) || (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX)) {
-        _resource_screens.clear();
-        _resource_screens_class_parent_map.clear();
-        _resource_screen_count = 0;
+        _resource_tracker.reset(AppResourceTracker::Type::SCREEN);
         ret = false;
         ESP_UTILS_LOGE("record screen fail");
     } else {
-        ESP_UTILS_LOGD("record screen(%d): ", _resource_screen_count);
+        ESP_UTILS_LOGD("record screen(%d): ", (int)_resource_tracker.getCount(AppResourceTracker::Type::SCREEN));
     }
 
     // Timer
@@ -158,48 +163,50 @@ bool App::endRecordResource(void)
     while ((timer_node != nullptr) && (timer_node != _resource_head_timer) &&
             (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
         // Record or update the record information of the timer
-        _resource_timers_cb_usr_map[timer_node] = {(lv_timer_cb_t)timer_node->timer_cb, timer_node->user_data};
-        if (find(_resource_timers.begin(), _resource_timers.end(), timer_node) == _resource_timers.end()) {
-            // Only record the newest timer
-            _resource_timers.push_back(timer_node);
-            _resource_timer_count++;
-        } else {
+        node = _resource_tracker.attach(
+                   AppResourceTracker::Type::TIMER, timer_node, (const void *)timer_node->timer_cb, timer_node->user_data,
+                   is_new
+               );
+        if (node == nullptr) {
+            ESP_UTILS_LOGD("Timer(@0x%p) is recorded by another app, skip", timer_node);
+        } else if (!is_new) {
             ESP_UTILS_LOGD("Timer(@0x%p) is already recorded", timer_node);
         }
         timer_node = lv_timer_get_next(timer_node);
     }
     if (((timer_node == nullptr) && (_resource_head_timer != nullptr)) ||
             (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX)) {
-        _resource_timers.clear();
-        _resource_timers_cb_usr_map.clear();
-        _resource_timer_count = 0;
+        _resource_tracker.reset(AppResourceTracker::Type::TIMER);
         ret = false;
         ESP_UTILS_LOGE("record timer fail");
     } else {
-        ESP_UTILS_LOGD("record timer(%d): ", _resource_timer_count);
+        ESP_UTILS_LOGD("record timer(%d): ", (int)_resource_tracker.getCount(AppResourceTracker::Type::TIMER));
     }
 
     // Animation
     anim_node = (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT());
     while ((anim_node != nullptr) && (anim_node != _resource_head_anim)) {
         // Record or update the record information of the animation
-        _resource_anims_var_exec_map[anim_node] = {anim_node->var, anim_node->exec_cb};
-        if (find(_resource_anims.begin(), _resource_anims.end(), anim_node) == _resource_anims.end()) {
-            // Only record the newest timer
-            _resource_anims.push_back(anim_node);
-            _resource_anim_count++;
+        node = _resource_tracker.attach(
+                   AppResourceTracker::Type::ANIM, anim_node, anim_node->var, (const void *)anim_node->exec_cb, is_new
+               );
+        if (node == nullptr) {
+            ESP_UTILS_LOGD("Animation(@0x%p) is recorded by another app, skip", anim_node);
+        } else if (is_new) {
+            // Chain the deleted callback of the animation, it is restored when the node is released
+            node->hook_data = (void *)anim_node->deleted_cb;
+            node->unhook = unhookTrackedResource;
+            anim_node->deleted_cb = onTrackedAnimDeletedCallback;
         } else {
             ESP_UTILS_LOGD("Animation(@0x%p) is already recorded", anim_node);
         }
         anim_node = (lv_anim_t *)_lv_ll_get_next(&LV_ANIM_LL_DEFAULT(), anim_node);
     }
     if ((anim_node == nullptr) && (_resource_head_anim != nullptr)) {
-        _resource_anims.clear();
-        _resource_anims_var_exec_map.clear();
-        _resource_anim_count = 0;
+        _resource_tracker.reset(AppResourceTracker::Type::ANIM);
         ESP_UTILS_LOGE("record animation fail");
     } else {
-        ESP_UTILS_LOGD("record animation(%d): ", _resource_anim_count);
+        ESP_UTILS_LOGD("record animation(%d): ", (int)_resource_tracker.getCount(AppResourceTracker::Type::ANIM));
     }
 
     if (_active_config.flags.enable_resize_visual_area) {
@@ -218,128 +225,79 @@ bool App::cleanRecordResource(void)
     ESP_UTILS_LOGD("App(%s: %d) clean resource", getName(), _id);
 
     bool ret = true;
-    bool do_clean = false;
     int resource_loop_count = 0;
-    int resource_clean_count = 0;
-    lv_display_t *disp = nullptr;
-    lv_obj_t *screen_node = nullptr;
+    size_t resource_record_count = 0;
+    size_t resource_clean_count = 0;
     lv_timer_t *timer_node = nullptr;
-    lv_anim_t *anim_node = nullptr;
 
-    disp = _system_context->getDisplayDevice();
-    ESP_UTILS_CHECK_NULL_RETURN(disp, false, "Invalid display");
-
-    // Screen
-    resource_loop_count = 0;
-    resource_clean_count = 0;
-    for (int i = 0; (i < (int)disp->screen_cnt) && (resource_loop_count++ <  RESOURCE_LOOP_COUNT_MAX);) {
-        do_clean = false;
-        screen_node = (lv_obj_t *)disp->screens[i];
-        auto screen_it = find(_resource_screens.begin(), _resource_screens.end(), screen_node);
-        if (screen_it != _resource_screens.end()) {
-            auto screen_map_it = _resource_screens_class_parent_map.find(screen_node);
-            if (screen_map_it == _resource_screens_class_parent_map.end()) {
-                ESP_UTILS_LOGE("Screen class parent map not found");
-            } else {
-                if ((screen_node->class_p == screen_map_it->second.first) &&
-                        (screen_node->parent == screen_map_it->second.second)) {
-                    lv_obj_del(screen_node);
-                    do_clean = true;
-                    resource_clean_count++;
-                } else {
-                    ESP_UTILS_LOGD("Screen(@0x%p) information is not matched, skip", screen_node);
-                }
-                _resource_screens.erase(screen_it);
-                _resource_screens_class_parent_map.erase(screen_map_it);
-            }
+    // Screen, the recorded ones are all alive since the deleted screens have been detached by their hook
+    resource_record_count = _resource_tracker.getCount(AppResourceTracker::Type::SCREEN);
+    resource_clean_count = _resource_tracker.release(AppResourceTracker::Type::SCREEN,
+    [](const AppResourceTracker::Node & node) {
+        lv_obj_t *screen = (lv_obj_t *)node.handle;
+        // The object might have been moved to another parent, it is not a screen of the app anymore
+        if ((screen->class_p != node.tags[0]) || (screen->parent != node.tags[1])) {
+            ESP_UTILS_LOGD("Screen(@0x%p) information is not matched, skip", screen);
+            return false;
         }
-        i = do_clean ? 0 : i + 1;
-    }
-    if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
-        ret = false;
-        ESP_UTILS_LOGE("Clean screen loop count exceed max");
-    } else {
-        ESP_UTILS_LOGD("Clean screen(%d), miss(%d): ", resource_clean_count, (int)(_resource_screen_count - resource_clean_count));
-    }
+        lv_obj_del(screen);
+        return true;
+    });
+    ESP_UTILS_LOGD("Clean screen(%d), miss(%d): ", (int)resource_clean_count,
+                   (int)(resource_record_count - resource_clean_count));
 
-    // Timer
-    resource_loop_count = 0;
+    // Timer, LVGL has no delete hook for timers, so the alive ones are looked up with a single pass over the timer list
+    resource_record_count = _resource_tracker.getCount(AppResourceTracker::Type::TIMER);
     resource_clean_count = 0;
-    timer_node = lv_timer_get_next(nullptr);
-    while ((timer_node != nullptr) && (_resource_timers.size() > 0) &&
-            (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
-        do_clean = false;
-        auto timer_it = find(_resource_timers.begin(), _resource_timers.end(), timer_node);
-        if (timer_it != _resource_timers.end()) {
-            auto timer_map_it = _resource_timers_cb_usr_map.find(timer_node);
-            if (timer_map_it == _resource_timers_cb_usr_map.end()) {
-                ESP_UTILS_LOGE("Timer cb usr map not found");
-            } else  {
-                if ((timer_map_it->second.first == timer_node->timer_cb) &&
-                        (timer_map_it->second.second == timer_node->user_data)) {
-                    lv_timer_del(timer_node);
-                    do_clean = true;
-                    resource_clean_count++;
-                } else {
-                    ESP_UTILS_LOGD("Timer(@0x%p) information is not matched, skip", timer_node);
-                }
-                _resource_timers.erase(timer_it);
-                _resource_timers_cb_usr_map.erase(timer_map_it);
+    timer_node = (resource_record_count > 0) ? lv_timer_get_next(nullptr) : nullptr;
+    while ((timer_node != nullptr) && (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
+        lv_timer_t *next_timer_node = lv_timer_get_next(timer_node);
+        AppResourceTracker::Node *node = AppResourceTracker::find(timer_node);
+        if ((node != nullptr) && (node->owner == &_resource_tracker)) {
+            if (((const void *)timer_node->timer_cb == node->tags[0]) && (timer_node->user_data == node->tags[1])) {
+                AppResourceTracker::detach(timer_node);
+                lv_timer_del(timer_node);
+                resource_clean_count++;
+            } else {
+                ESP_UTILS_LOGD("Timer(@0x%p) information is not matched, skip", timer_node);
             }
         }
-        timer_node = do_clean ? lv_timer_get_next(nullptr) : lv_timer_get_next(timer_node);
+        timer_node = next_timer_node;
     }
     if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
         ret = false;
         ESP_UTILS_LOGE("Clean timer loop count exceed max");
     } else {
-        ESP_UTILS_LOGD("Clean timer(%d), miss(%d): ", resource_clean_count, _resource_timer_count - resource_clean_count);
+        ESP_UTILS_LOGD("Clean timer(%d), miss(%d): ", (int)resource_clean_count,
+                       (int)(resource_record_count - resource_clean_count));
     }
-
-    // Animation
-    resource_loop_count = 0;
-    resource_clean_count = 0;
-    anim_node = (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT());
-    while ((anim_node != nullptr) && (_resource_anims.size() > 0) &&
-            (resource_loop_count++ < RESOURCE_LOOP_COUNT_MAX)) {
-        do_clean = false;
-        auto anim_it = find(_resource_anims.begin(), _resource_anims.end(), anim_node);
-        if (anim_it != _resource_anims.end()) {
-            auto anim_map_it = _resource_anims_var_exec_map.find(anim_node);
-            if (anim_map_it == _resource_anims_var_exec_map.end()) {
-                ESP_UTILS_LOGE("Animation var exec map not found");
-            } else  {
-                if ((anim_map_it->second.first == anim_node->var) &&
-                        (anim_map_it->second.second == anim_node->exec_cb)) {
-                    if (lv_anim_del(anim_node->var, anim_node->exec_cb)) {
-                        do_clean = true;
-                        resource_clean_count++;
-                    } else {
-                        ESP_UTILS_LOGE("Delete animation failed");
-                    }
-                } else {
-                    ESP_UTILS_LOGD("Anim(@0x%p) information is not matched, skip", anim_node);
-                }
-                _resource_anims.erase(anim_it);
-                _resource_anims_var_exec_map.erase(anim_map_it);
-            }
+    // The remaining ones have already been deleted by the app
+    _resource_tracker.reset(AppResourceTracker::Type::TIMER);
+
+    // Animation, the recorded ones are all alive since the finished animations have been detached by their hook
+    resource_record_count = _resource_tracker.getCount(AppResourceTracker::Type::ANIM);
+    resource_clean_count = _resource_tracker.release(AppResourceTracker::Type::ANIM,
+    [](const AppResourceTracker::Node & node) {
+        lv_anim_t *anim = (lv_anim_t *)node.handle;
+        if ((anim->var != node.tags[0]) || ((const void *)anim->exec_cb != node.tags[1])) {
+            ESP_UTILS_LOGD("Anim(@0x%p) information is not matched, skip", anim);
+            return false;
         }
-        anim_node = do_clean ? (lv_anim_t *)_lv_ll_get_head(&LV_ANIM_LL_DEFAULT()) :
-                    (lv_anim_t *)_lv_ll_get_next(&LV_ANIM_LL_DEFAULT(), anim_node);
-    }
-    if (resource_loop_count >= RESOURCE_LOOP_COUNT_MAX) {
-        ret = false;
-        ESP_UTILS_LOGE("Clean timer loop count exceed max");
-    } else {
-        ESP_UTILS_LOGD("Clean anim(%d), miss(%d): ", resource_clean_count, _resource_anim_count - resource_clean_count);
-    }
+        if (!lv_anim_del(anim->var, anim->exec_cb)) {
+            ESP_UTILS_LOGE("Delete animation failed");
+            return false;
+        }
+        return true;
+    });
+    ESP_UTILS_LOGD("Clean anim(%d), miss(%d): ", (int)resource_clean_count,
+                   (int)(resource_record_count - resource_clean_count));
 
     ESP_UTILS_CHECK_FALSE_RETURN(resetRecordResource(), false, "Reset record resource failed");
 
     return ret;
 }
 
-bool App::processInstall(Context *system_context, int id)
+bool App::processInstall(Context *system_context, int id, bool defer_init)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(!checkInitialized(), false, "Already initialized");
     ESP_UTILS_CHECK_NULL_RETURN(_init_config.name, false, "App name is invalid");
@@ -356,7 +314,12 @@ bool App::processInstall(Context *system_context, int id)
     _id = id;
 
     ESP_UTILS_CHECK_FALSE_GOTO(beginExtra(), err, "Begin extra failed");
-    ESP_UTILS_CHECK_FALSE_GOTO(init(), err, "Init failed");
+    if (defer_init) {
+        ESP_UTILS_LOGD("Defer init until the first start");
+        _flags.is_init_deferred = true;
+    } else {
+        ESP_UTILS_CHECK_FALSE_GOTO(init(), err, "Init failed");
+    }
 
     _status = Status::CLOSED;
 
@@ -368,11 +331,24 @@ err:
     return false;
 }
 
+bool App::processDeferredInit(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_flags.is_init_deferred, false, "Init is not deferred");
+    ESP_UTILS_LOGD("App(%s: %d) deferred init", getName(), _id);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
+    _flags.is_init_deferred = false;
+
+    return true;
+}
+
 bool App::processUninstall(void)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
     ESP_UTILS_LOGD("App(%s: %d) uninstall", getName(), _id);
 
+    bool is_init_deferred = _flags.is_init_deferred;
+
     _system_context = nullptr;
     _active_config = {};
     _status = Status::UNINSTALLED;
@@ -380,10 +356,7 @@ bool App::processUninstall(void)
     _flags = {};
     _display_style = {};
     _app_style = {};
-    _resource_timer_count = 0;
-    _resource_anim_count = 0;
     _resource_head_screen_index = 0;
-    _resource_screen_count = 0;
     if (_active_config.flags.enable_default_screen && checkLvObjIsValid(_active_screen)) {
         lv_obj_del(_active_screen);
     }
@@ -392,20 +365,19 @@ bool App::processUninstall(void)
     // _temp_screen = nullptr;
     _resource_head_timer = nullptr;
     _resource_head_anim = nullptr;
-    _resource_screens.clear();
-    _resource_timers.clear();
-    _resource_anims.clear();
+    _resource_tracker.reset();
 
     ESP_UTILS_CHECK_FALSE_RETURN(delExtra(), false, "Begin extra failed");
-    ESP_UTILS_CHECK_FALSE_RETURN(deinit(), false, "Deinit failed");
+    // `init()` has never been called, so there is nothing to deinit
+    if (!is_init_deferred) {
+        ESP_UTILS_CHECK_FALSE_RETURN(deinit(), false, "Deinit failed");
+    }
 
     return true;
 }
 
 bool App::processRun()
 {
-    bool ret = true;
-
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
     ESP_UTILS_LOGD("App(%s: %d) run", getName(), _id);
 
@@ -414,24 +386,7 @@ bool App::processRun()
     //     // Create a temp screen to recolor the background
     //     ESP_UTILS_CHECK_FALSE_RETURN(createAndloadTempScreen(), false, "Create temp screen failed");
     // }
-    ESP_UTILS_CHECK_FALSE_RETURN(saveRecentScreen(false), false, "Save recent screen before run failed");
-    ESP_UTILS_CHECK_FALSE_RETURN(resetRecordResource(), false, "Reset record resource failed");
-    ESP_UTILS_CHECK_FALSE_RETURN(startRecordResource(), false, "Start record resource failed");
-    if (_active_config.flags.enable_default_screen) {
-        ESP_UTILS_CHECK_FALSE_RETURN(initDefaultScreen(), false, "Create active screen failed");
-    }
-    ESP_UTILS_CHECK_FALSE_RETURN(saveDisplayTheme(), false, "Save display theme failed");
-    ESP_UTILS_LOGD("Do run");
-    if (!run()) {
-        ESP_UTILS_LOGE("Run app failed");
-        ret = false;
-    }
-    ESP_UTILS_CHECK_FALSE_RETURN(endRecordResource(), false, "Start record resource failed");
-    if (!saveRecentScreen(true)) {
-        ESP_UTILS_LOGE("Save recent screen after run failed");
-        ret = false;
-    }
-    ESP_UTILS_CHECK_FALSE_GOTO(ret, err, "App run failed");
+    ESP_UTILS_CHECK_FALSE_GOTO(processRunRecorded(false), err, "App run failed");
 
     _status = Status::RUNNING;
 
@@ -523,6 +478,7 @@ bool App::processClose(bool is_app_active)
         }
     }
     ESP_UTILS_CHECK_FALSE_GOTO(loadDisplayTheme(), err, "Load display theme failed");
+    vector<uint8_t>().swap(_hibernate_state);
 
     _flags.is_closing = false;
     _status = Status::CLOSED;
@@ -535,6 +491,94 @@ err:
     return false;
 }
 
+bool App::processHibernate(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(_status == Status::PAUSED, false, "Only a paused app can hibernate");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _active_config.flags.enable_hibernate && _active_config.flags.enable_recycle_resource, false,
+        "Hibernation is not enabled"
+    );
+    ESP_UTILS_LOGD("App(%s: %d) hibernate", getName(), _id);
+
+    _hibernate_state.clear();
+    ESP_UTILS_LOGD("Do save state");
+    ESP_UTILS_CHECK_FALSE_RETURN(saveState(_hibernate_state), false, "Save state failed");
+    _hibernate_state.shrink_to_fit();
+
+    // From here the app can't go back to the paused status, its resources are gone
+    ESP_UTILS_LOGD("Do clean resource");
+    if (!cleanResource()) {
+        ESP_UTILS_LOGE("Clean resource failed");
+    }
+    if (!cleanRecordResource()) {
+        ESP_UTILS_LOGE("Clean record resource failed");
+    }
+    _active_screen = nullptr;
+
+    _status = Status::HIBERNATED;
+
+    return true;
+}
+
+bool App::processWake(void)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(_status == Status::HIBERNATED, false, "App is not hibernated");
+    ESP_UTILS_LOGD("App(%s: %d) wake (state: %d bytes)", getName(), _id, (int)_hibernate_state.size());
+
+    // Rebuild the UI the same way as `processRun()`, then hand the saved state back to the app
+    ESP_UTILS_CHECK_FALSE_GOTO(processRunRecorded(true), err, "App wake failed");
+
+    vector<uint8_t>().swap(_hibernate_state);
+    _status = Status::RUNNING;
+
+    return true;
+
+err:
+    ESP_UTILS_CHECK_FALSE_RETURN(processClose(true), false, "Close app failed");
+
+    return false;
+}
+
+bool App::processRunRecorded(bool restore_state)
+{
+    bool ret = true;
+
+    ESP_UTILS_CHECK_FALSE_RETURN(saveRecentScreen(false), false, "Save recent screen before run failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(resetRecordResource(), false, "Reset record resource failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(startRecordResource(), false, "Start record resource failed");
+    // From here the recording is always ended, so that the caller can close what has been created so far
+    if (_active_config.flags.enable_default_screen && !initDefaultScreen()) {
+        ESP_UTILS_LOGE("Create active screen failed");
+        ret = false;
+    }
+    if (ret && !saveDisplayTheme()) {
+        ESP_UTILS_LOGE("Save display theme failed");
+        ret = false;
+    }
+    if (ret) {
+        ESP_UTILS_LOGD("Do run");
+        if (!run()) {
+            ESP_UTILS_LOGE("Run app failed");
+            ret = false;
+        } else if (restore_state) {
+            ESP_UTILS_LOGD("Do restore state");
+            if (!restoreState(_hibernate_state)) {
+                ESP_UTILS_LOGE("Restore state failed");
+                ret = false;
+            }
+        }
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(endRecordResource(), false, "End record resource failed");
+    if (!saveRecentScreen(true)) {
+        ESP_UTILS_LOGE("Save recent screen after run failed");
+        ret = false;
+    }
+
+    return ret;
+}
+
 bool App::setVisualArea(const lv_area_t &area)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
@@ -663,20 +707,7 @@ bool App::resetRecordResource(void)
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
     ESP_UTILS_LOGD("App(%s: %d) reset record resource", getName(), _id);
 
-    // Screen
-    _resource_screen_count = 0;
-    _resource_screens.clear();
-    _resource_screens_class_parent_map.clear();
-
-    // Timer
-    _resource_timer_count = 0;
-    _resource_timers.clear();
-    _resource_timers_cb_usr_map.clear();
-
-    // Animation
-    _resource_anim_count = 0;
-    _resource_anims.clear();
-    _resource_anims_var_exec_map.clear();
+    _resource_tracker.reset();
 
     _flags.is_resource_recording = false;
 
@@ -820,6 +851,42 @@ void App::onResizeScreenLoadedEventCallback(lv_event_t *event)
     lv_obj_set_pos(screen, area.x1, area.y1);
 }
 
+void App::onTrackedScreenDeleteEventCallback(lv_event_t *event)
+{
+    ESP_UTILS_CHECK_NULL_EXIT(event, "Invalid event");
+
+    // Also called for the children which bubble their events, they are simply not found
+    AppResourceTracker::detach(lv_event_get_target(event));
+}
+
+void App::onTrackedAnimDeletedCallback(lv_anim_t *anim)
+{
+    AppResourceTracker::Node *node = AppResourceTracker::find(anim);
+    lv_anim_deleted_cb_t deleted_cb = nullptr;
+
+    ESP_UTILS_CHECK_NULL_EXIT(node, "Animation(@0x%p) is not recorded", anim);
+
+    deleted_cb = (lv_anim_deleted_cb_t)node->hook_data;
+    AppResourceTracker::detach(anim);
+    if (deleted_cb != nullptr) {
+        deleted_cb(anim);
+    }
+}
+
+void App::unhookTrackedResource(const AppResourceTracker::Node &node)
+{
+    switch (node.type) {
+    case AppResourceTracker::Type::SCREEN:
+        lv_obj_remove_event_cb((lv_obj_t *)node.handle, onTrackedScreenDeleteEventCallback);
+        break;
+    case AppResourceTracker::Type::ANIM:
+        ((lv_anim_t *)node.handle)->deleted_cb = (lv_anim_deleted_cb_t)node.hook_data;
+        break;
+    default:
+        break;
+    }
+}
+
 // TODO
 // bool App::createAndloadTempScreen(void)
 // {
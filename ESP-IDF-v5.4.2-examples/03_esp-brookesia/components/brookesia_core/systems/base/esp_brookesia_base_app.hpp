@@ -8,9 +8,11 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 #include "lvgl.h"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
 #include "more/esp_utils_plugin_registry.hpp"
+#include "esp_brookesia_base_app_resource.hpp"
 
 namespace esp_brookesia::systems::base {
 
@@ -72,6 +74,14 @@ public:
                                                         status bar. Otherwise, the app's screens will be displayed in full screen,
                                                         but some areas might be not visible. The app can call the `getVisualArea()`
                                                         function to retrieve the final visual area */
+            uint8_t enable_prepare: 1;              /*!< If this flag is enabled, the core will call the app's `prepare()`
+                                                        function on a worker thread before every `run()`, and show a
+                                                        placeholder screen meanwhile */
+            uint8_t enable_hibernate: 1;            /*!< If this flag is enabled, the core may hibernate the app when it is
+                                                        paused instead of closing it: the app's state is saved by
+                                                        `saveState()`, then all recorded resources are cleaned. When the
+                                                        app resumes, `run()` and `restoreState()` are called to rebuild it.
+                                                        This flag requires the `enable_recycle_resource` flag */
         } flags;                                    /*!< Core app config flags */
     };
 
@@ -80,6 +90,7 @@ public:
         RUNNING,
         PAUSED,
         CLOSED,
+        HIBERNATED,
     };
 
     using Registry = esp_utils::PluginRegistry<App>;
@@ -166,6 +177,17 @@ public:
         return _active_config.launcher_icon;
     }
 
+    /**
+     * @brief Get the status
+     *
+     * @return status: the current status of the app
+     *
+     */
+    Status getStatus(void) const
+    {
+        return _status;
+    }
+
     /**
      * @brief Get the visual area
      *
@@ -240,6 +262,21 @@ protected:
      */
     virtual bool run(void) = 0;
 
+    /**
+     * @brief Called on a worker thread before `run()` when the `enable_prepare` flag is set. The app can perform slow
+     *        work which doesn't touch LVGL here, such as initializing a sensor or loading files, without blocking the
+     *        GUI thread.
+     *
+     * @note  The LVGL lock is not held, so no LVGL API should be called in this function.
+     *
+     * @return true if successful, otherwise false. The app won't run if it fails
+     *
+     */
+    virtual bool prepare(void)
+    {
+        return true;
+    }
+
     /**
      * @brief Called when the app receives a back event. To exit, the app can call `notifyCoreClosed()` to notify the
      *        core to close the app.
@@ -316,6 +353,37 @@ protected:
         return true;
     }
 
+    /**
+     * @brief Called when the paused app is going to hibernate. The app should save what it needs to rebuild its UI into
+     *        `state`, which is kept by the core until the app resumes or closes.
+     *
+     * @note  All recorded resources are cleaned after this function, so the app should drop its pointers to them.
+     * @note  The `close()` function might be called while the app is hibernated, it should not touch the UI then.
+     *
+     * @param state The blob to fill, empty when called
+     *
+     * @return true if successful, otherwise false. The core will close the app instead if it fails
+     *
+     */
+    virtual bool saveState(std::vector<uint8_t> &state)
+    {
+        return true;
+    }
+
+    /**
+     * @brief Called after `run()` when the hibernated app resumes. The app can restore the state saved by
+     *        `saveState()` here.
+     *
+     * @param state The blob saved by `saveState()`
+     *
+     * @return true if successful, otherwise false
+     *
+     */
+    virtual bool restoreState(const std::vector<uint8_t> &state)
+    {
+        return true;
+    }
+
     /**
      * @brief Called when the app starts to close. The app can perform extra resource cleanup here.
      *
@@ -405,12 +473,16 @@ private:
     {
         return true;
     }
-    virtual bool processInstall(Context *system_context, int id);
+    virtual bool processInstall(Context *system_context, int id, bool defer_init = false);
+    bool processDeferredInit(void);
     virtual bool processUninstall(void);
     virtual bool processRun(void);
     virtual bool processResume(void);
     virtual bool processPause(void);
     virtual bool processClose(bool is_app_active);
+    bool processHibernate(void);
+    bool processWake(void);
+    bool processRunRecorded(bool restore_state);
 
     bool setVisualArea(const lv_area_t &area);
     bool calibrateVisualArea(void);
@@ -430,6 +502,9 @@ private:
 
     static void onCleanResourceEventCallback(lv_event_t *e);
     static void onResizeScreenLoadedEventCallback(lv_event_t *e);
+    static void onTrackedScreenDeleteEventCallback(lv_event_t *e);
+    static void onTrackedAnimDeletedCallback(lv_anim_t *anim);
+    static void unhookTrackedResource(const AppResourceTracker::Node &node);
 
     // Core
     Config _init_config = {};
@@ -441,6 +516,7 @@ private:
         uint8_t is_closing: 1;
         uint8_t is_screen_small: 1;
         uint8_t is_resource_recording: 1;
+        uint8_t is_init_deferred: 1;    // Installed without calling `init()` yet, see `Manager::setAppLazyInstallEnabled()`
     } _flags = {};
     struct {
         int w;
@@ -453,22 +529,17 @@ private:
         lv_theme_t *theme;
     } _app_style = {};
     // Resources
-    int _resource_timer_count = 0;
-    int _resource_anim_count = 0;
     int _resource_head_screen_index = 0;
-    int _resource_screen_count = 0;
     lv_obj_t *_last_screen = nullptr;
     lv_obj_t *_active_screen = nullptr;
     // lv_obj_t *_temp_screen;
     lv_timer_t *_resource_head_timer = nullptr;
     lv_anim_t *_resource_head_anim = nullptr;
-    std::list <lv_obj_t *> _resource_screens = {};
-    std::list <lv_timer_t *> _resource_timers = {};
-    std::list <lv_anim_t *> _resource_anims = {};
-    // These maps are meant to store additional information about the recorded resources to prevent accidental cleanup
-    std::map<lv_obj_t *, std::pair<const lv_obj_class_t *, lv_obj_t *>> _resource_screens_class_parent_map;
-    std::map<lv_timer_t *, std::pair<lv_timer_cb_t, void *>> _resource_timers_cb_usr_map;
-    std::map<lv_anim_t *, std::pair<void *, lv_anim_exec_xcb_t>> _resource_anims_var_exec_map;
+    // The screens and animations are detached by their delete hooks, the timers are checked when cleaned since LVGL
+    // has no hook for them
+    AppResourceTracker _resource_tracker;
+    // Hibernation
+    std::vector<uint8_t> _hibernate_state;
 };
 
 }
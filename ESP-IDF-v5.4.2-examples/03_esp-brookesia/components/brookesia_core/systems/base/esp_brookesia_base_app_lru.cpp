@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_brookesia_base_app_lru.hpp"
+
+namespace esp_brookesia::systems::base {
+
+void AppLru::touch(int id)
+{
+    remove(id);
+    _ids.push_back(id);
+}
+
+void AppLru::remove(int id)
+{
+    _ids.erase(std::remove(_ids.begin(), _ids.end(), id), _ids.end());
+}
+
+int AppLru::getLeastRecentlyUsed(int exclude_id, const Filter &filter) const
+{
+    for (int id : _ids) {
+        if ((id != exclude_id) && (!filter || filter(id))) {
+            return id;
+        }
+    }
+
+    return -1;
+}
+
+int AppLru::getEvictionCandidate(int active_id, const Filter &is_hibernated) const
+{
+    int id = getLeastRecentlyUsed(active_id, [&is_hibernated](int app_id) {
+        return !is_hibernated(app_id);
+    });
+    if (id == -1) {
+        id = getLeastRecentlyUsed(active_id);
+    }
+
+    return id;
+}
+
+} // namespace esp_brookesia::systems::base
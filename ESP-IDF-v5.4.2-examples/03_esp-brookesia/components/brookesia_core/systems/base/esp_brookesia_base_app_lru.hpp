@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Order in which the running apps were last run or resumed, and the order they are evicted in when the memory
+ *        runs low.
+ *
+ * @note  It doesn't depend on LVGL, the apps are identified by their IDs and the owner tells which ones are hibernated.
+ */
+class AppLru {
+public:
+    using Filter = std::function<bool(int id)>;
+
+    /**
+     * @brief Record a run or a resume of an app, it becomes the most recently used one
+     */
+    void touch(int id);
+    void remove(int id);
+    void clear(void)
+    {
+        _ids.clear();
+    }
+
+    /**
+     * @brief Get the least recently used app, skipping `exclude_id` and the apps rejected by `filter`
+     *
+     * @return ID of the app, `-1` if there is none
+     */
+    int getLeastRecentlyUsed(int exclude_id, const Filter &filter = nullptr) const;
+    /**
+     * @brief Get the next app to evict. The active app is never evicted, the user is looking at it. The resident apps
+     *        go first since the hibernated ones only hold their saved state, each group in LRU order.
+     *
+     * @return ID of the app, `-1` if there is none
+     */
+    int getEvictionCandidate(int active_id, const Filter &is_hibernated) const;
+
+    /**
+     * @brief IDs of the apps, least recently used first
+     */
+    const std::vector<int> &getIds(void) const
+    {
+        return _ids;
+    }
+
+private:
+    std::vector<int> _ids;
+};
+
+} // namespace esp_brookesia::systems::base
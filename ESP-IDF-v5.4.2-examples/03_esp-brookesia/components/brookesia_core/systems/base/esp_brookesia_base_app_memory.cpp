@@ -0,0 +1,347 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstdint>
+#include <new>
+#include "esp_brookesia_systems_internal.h"
+#if defined(ESP_PLATFORM)
+#   include "esp_attr.h"
+#   include "esp_heap_caps.h"
+#   include "freertos/task.h"
+#   if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+#       include "esp_memory_utils.h"
+#   endif
+#else
+#   define IRAM_ATTR
+#endif
+#include "esp_brookesia_base_app_memory.hpp"
+
+namespace esp_brookesia::systems::base {
+
+// The table is filled up to 3/4, so that the probes stay short
+#define ENTRY_LOAD_NUM(capacity)    ((capacity) / 4 * 3)
+#define ENTRY_SIZE_MAX              ((1UL << 31) - 1)
+
+// Constant initialized, so that the heap hooks can use it before the static constructors and without a guard
+static AppMemoryTracker s_tracker;
+
+AppMemoryTracker::~AppMemoryTracker()
+{
+    del();
+}
+
+bool AppMemoryTracker::begin(size_t capacity)
+{
+    if ((capacity == 0) || (capacity > ((SIZE_MAX >> 1) + 1))) {
+        return false;
+    }
+    // The slots are indexed by masking the hash
+    size_t table_capacity = 1;
+    while (table_capacity < capacity) {
+        table_capacity <<= 1;
+    }
+    capacity = table_capacity;
+
+    // Allocate out of the lock, the hooks ignore this allocation since there is no table yet
+    Entry *entries = allocEntries(capacity);
+    if (entries == nullptr) {
+        return false;
+    }
+
+    lock();
+    if (_entries != nullptr) {
+        unlock();
+        freeEntries(entries);
+        return false;
+    }
+    _entries = entries;
+    _capacity = capacity;
+    _entry_count = 0;
+    _untracked_count = 0;
+    for (auto &usage : _usages) {
+        usage = {};
+    }
+    unlock();
+
+    return true;
+}
+
+void AppMemoryTracker::del(void)
+{
+    lock();
+    Entry *entries = _entries;
+    _entries = nullptr;
+    _capacity = 0;
+    _entry_count = 0;
+    for (auto &usage : _usages) {
+        usage = {};
+    }
+    _owner_app_id = -1;
+    _owner_slot = -1;
+    _owner_thread = 0;
+    unlock();
+    // Freed out of the lock, the hooks ignore it since there is no table anymore
+    freeEntries(entries);
+}
+
+void AppMemoryTracker::setOwner(int app_id)
+{
+    lock();
+    _owner_app_id = app_id;
+    _owner_slot = (app_id >= 0) ? claimSlotIndex(app_id) : -1;
+    _owner_thread = getThreadHandle();
+    unlock();
+}
+
+void IRAM_ATTR AppMemoryTracker::recordAlloc(void *ptr, size_t size, bool is_external)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    lock();
+    if (_entries == nullptr) {
+        unlock();
+        return;
+    }
+
+    uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+    size_t mask = _capacity - 1;
+    size_t index = getHash(key) & mask;
+    // A block resized in place, or freed without the hook, is credited back first
+    if (_entry_count > 0) {
+        for (; _entries[index].ptr != 0; index = (index + 1) & mask) {
+            if (_entries[index].ptr == key) {
+                removeEntry(index);
+                index = getHash(key) & mask;
+                break;
+            }
+        }
+    }
+
+    if ((_owner_app_id < 0) || (getThreadHandle() != _owner_thread)) {
+        unlock();
+        return;
+    }
+    if ((_owner_slot < 0) && ((_owner_slot = claimSlotIndex(_owner_app_id)) < 0)) {
+        _untracked_count++;
+        unlock();
+        return;
+    }
+    if (_entry_count >= ENTRY_LOAD_NUM(_capacity)) {
+        _untracked_count++;
+        unlock();
+        return;
+    }
+
+    while (_entries[index].ptr != 0) {
+        index = (index + 1) & mask;
+    }
+    if (size > ENTRY_SIZE_MAX) {
+        size = ENTRY_SIZE_MAX;
+    }
+    _entries[index] = {key, static_cast<uint32_t>(size), is_external, static_cast<uint8_t>(_owner_slot)};
+    _entry_count++;
+
+    Usage &usage = _usages[_owner_slot];
+    usage.alloc_count++;
+    if (is_external) {
+        usage.psram_bytes += size;
+        if (usage.psram_bytes > usage.psram_peak_bytes) {
+            usage.psram_peak_bytes = usage.psram_bytes;
+        }
+    } else {
+        usage.sram_bytes += size;
+        if (usage.sram_bytes > usage.sram_peak_bytes) {
+            usage.sram_peak_bytes = usage.sram_bytes;
+        }
+    }
+    unlock();
+}
+
+void IRAM_ATTR AppMemoryTracker::recordFree(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    lock();
+    if ((_entries == nullptr) || (_entry_count == 0)) {
+        unlock();
+        return;
+    }
+
+    uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+    size_t mask = _capacity - 1;
+    for (size_t index = getHash(key) & mask; _entries[index].ptr != 0; index = (index + 1) & mask) {
+        if (_entries[index].ptr == key) {
+            removeEntry(index);
+            break;
+        }
+    }
+    unlock();
+}
+
+bool AppMemoryTracker::getUsage(int app_id, Usage &usage) const
+{
+    lock();
+    int slot = getSlotIndex(app_id);
+    if (slot >= 0) {
+        usage = _usages[slot];
+    }
+    unlock();
+
+    return (slot >= 0);
+}
+
+void AppMemoryTracker::resetPeak(int app_id)
+{
+    lock();
+    int slot = getSlotIndex(app_id);
+    if (slot >= 0) {
+        _usages[slot].sram_peak_bytes = _usages[slot].sram_bytes;
+        _usages[slot].psram_peak_bytes = _usages[slot].psram_bytes;
+    }
+    unlock();
+}
+
+AppMemoryTracker &AppMemoryTracker::getInstance(void)
+{
+    return s_tracker;
+}
+
+AppMemoryTracker::Entry *AppMemoryTracker::allocEntries(size_t capacity)
+{
+#if defined(ESP_PLATFORM)
+    // The hooks may read it with the flash cache disabled, so it must not be in PSRAM
+    return static_cast<Entry *>(heap_caps_calloc(capacity, sizeof(Entry), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+#else
+    return new (std::nothrow) Entry[capacity]();
+#endif
+}
+
+void AppMemoryTracker::freeEntries(Entry *entries)
+{
+#if defined(ESP_PLATFORM)
+    heap_caps_free(entries);
+#else
+    delete[] entries;
+#endif
+}
+
+uintptr_t IRAM_ATTR AppMemoryTracker::getThreadHandle(void)
+{
+#if defined(ESP_PLATFORM)
+    return reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle());
+#else
+    static thread_local char thread_marker;
+    return reinterpret_cast<uintptr_t>(&thread_marker);
+#endif
+}
+
+size_t IRAM_ATTR AppMemoryTracker::getHash(uintptr_t ptr)
+{
+    // Heap blocks are at least 4 bytes aligned, the low bits carry no information
+    uint32_t hash = static_cast<uint32_t>(ptr >> 2) * 0x9E3779B1U;
+
+    return hash ^ (hash >> 16);
+}
+
+void IRAM_ATTR AppMemoryTracker::lock(void) const
+{
+#if defined(ESP_PLATFORM)
+    portENTER_CRITICAL_SAFE(&_lock);
+#else
+    _lock.lock();
+#endif
+}
+
+void IRAM_ATTR AppMemoryTracker::unlock(void) const
+{
+#if defined(ESP_PLATFORM)
+    portEXIT_CRITICAL_SAFE(&_lock);
+#else
+    _lock.unlock();
+#endif
+}
+
+int IRAM_ATTR AppMemoryTracker::getSlotIndex(int app_id) const
+{
+    if (app_id < 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < APP_NUM_MAX; i++) {
+        if (_usages[i].app_id == app_id) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+int IRAM_ATTR AppMemoryTracker::claimSlotIndex(int app_id)
+{
+    int slot = getSlotIndex(app_id);
+    if (slot >= 0) {
+        return slot;
+    }
+
+    // Take a free slot, or the one of an app which doesn't hold any allocation anymore
+    for (size_t i = 0; i < APP_NUM_MAX; i++) {
+        if ((_usages[i].app_id < 0) || ((_usages[i].alloc_count == 0) && (_usages[i].app_id != _owner_app_id))) {
+            _usages[i] = {};
+            _usages[i].app_id = app_id;
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+void IRAM_ATTR AppMemoryTracker::removeEntry(size_t index)
+{
+    Entry &entry = _entries[index];
+    Usage &usage = _usages[entry.slot];
+
+    usage.alloc_count--;
+    if (entry.is_external) {
+        usage.psram_bytes -= entry.size;
+    } else {
+        usage.sram_bytes -= entry.size;
+    }
+    _entry_count--;
+
+    // Backward shift deletion, the entries after the hole which may be moved into it are moved, so that the probes
+    // never need tombstones
+    size_t mask = _capacity - 1;
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask; _entries[next].ptr != 0; next = (next + 1) & mask) {
+        size_t home = getHash(_entries[next].ptr) & mask;
+        bool is_between = (hole <= next) ? ((hole < home) && (home <= next)) : ((hole < home) || (home <= next));
+        if (!is_between) {
+            _entries[hole] = _entries[next];
+            hole = next;
+        }
+    }
+    _entries[hole] = {};
+}
+
+} // namespace esp_brookesia::systems::base
+
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION && defined(ESP_PLATFORM)
+/**
+ * @brief Heap hooks of `CONFIG_HEAP_USE_HOOKS`, called after every successful allocation and every free. In IRAM like
+ *        the heap functions calling them
+ */
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+    esp_brookesia::systems::base::s_tracker.recordAlloc(ptr, size, esp_ptr_external_ram(ptr));
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void *ptr)
+{
+    esp_brookesia::systems::base::s_tracker.recordFree(ptr);
+}
+#endif
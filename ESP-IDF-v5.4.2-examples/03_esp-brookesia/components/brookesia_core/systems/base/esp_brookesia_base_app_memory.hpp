@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#else
+#   include <mutex>
+#endif
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Attribution of the heap allocations to apps. The allocations made by the owner thread while an owner app is
+ *        set are charged to that app, and credited back when they are freed, whoever frees them and even after the app
+ *        is closed, so an app which leaks keeps a non-zero usage.
+ *
+ * @note  It doesn't depend on LVGL nor on the heap: `recordAlloc()` and `recordFree()` are fed by the heap hooks and
+ *        never allocate, the allocation table is a fixed open addressing hash table created by `begin()`. Everything
+ *        is guarded by a spinlock, so the records can come from any thread.
+ * @note  The heap functions may run while the flash cache is disabled, so the whole record path is in IRAM and the
+ *        table in internal RAM. It only uses plain arrays there, no template which could be emitted out of line.
+ */
+class AppMemoryTracker {
+public:
+    struct Usage {
+        int app_id = -1;
+        size_t sram_bytes = 0;
+        size_t psram_bytes = 0;
+        size_t sram_peak_bytes = 0;
+        size_t psram_peak_bytes = 0;
+        size_t alloc_count = 0;     // Allocations alive
+    };
+
+    // Apps with a usage at the same time, an app beyond that is not attributed until another one is back to zero
+    static constexpr size_t APP_NUM_MAX = 32;
+
+    AppMemoryTracker() = default;
+    ~AppMemoryTracker();
+    AppMemoryTracker(const AppMemoryTracker &) = delete;
+    AppMemoryTracker &operator=(const AppMemoryTracker &) = delete;
+
+    /**
+     * @param capacity Size of the allocation table, rounded up to a power of 2. It is filled up to 3/4
+     */
+    bool begin(size_t capacity);
+    void del(void);
+    bool checkInitialized(void) const
+    {
+        return (_entries != nullptr);
+    }
+    size_t getCapacity(void) const
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief Charge the next allocations of the calling thread to `app_id`, or stop charging them if it is `-1`
+     */
+    void setOwner(int app_id);
+    int getOwner(void) const
+    {
+        return _owner_app_id;
+    }
+
+    void recordAlloc(void *ptr, size_t size, bool is_external);
+    void recordFree(void *ptr);
+
+    bool getUsage(int app_id, Usage &usage) const;
+    /**
+     * @brief Restart the high-water marks of an app from its current usage
+     */
+    void resetPeak(int app_id);
+    /**
+     * @brief Allocations of an owner which could not be attributed, because the table or the app slots were full
+     */
+    size_t getUntrackedCount(void) const
+    {
+        return _untracked_count;
+    }
+
+    static AppMemoryTracker &getInstance(void);
+
+private:
+    struct Entry {
+        uintptr_t ptr;              // `0` if the entry is free
+        uint32_t size: 31;
+        uint32_t is_external: 1;
+        uint8_t slot;
+    };
+
+    static uintptr_t getThreadHandle(void);
+    static size_t getHash(uintptr_t ptr);
+
+    void lock(void) const;
+    void unlock(void) const;
+    int getSlotIndex(int app_id) const;
+    int claimSlotIndex(int app_id);
+    void removeEntry(size_t index);
+
+    static Entry *allocEntries(size_t capacity);
+    static void freeEntries(Entry *entries);
+
+    Entry *_entries = nullptr;
+    size_t _capacity = 0;
+    size_t _entry_count = 0;
+    size_t _untracked_count = 0;
+    Usage _usages[APP_NUM_MAX] = {};
+    int _owner_app_id = -1;
+    int _owner_slot = -1;
+    uintptr_t _owner_thread = 0;
+#if defined(ESP_PLATFORM)
+    mutable portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+#else
+    mutable std::mutex _lock;
+#endif
+};
+
+} // namespace esp_brookesia::systems::base
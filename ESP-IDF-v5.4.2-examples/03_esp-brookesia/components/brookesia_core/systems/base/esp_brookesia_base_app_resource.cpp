@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_brookesia_base_app_resource.hpp"
+
+namespace esp_brookesia::systems::base {
+
+AppResourceTracker::~AppResourceTracker()
+{
+    reset();
+}
+
+AppResourceTracker::Node *AppResourceTracker::attach(
+    Type type, void *handle, const void *tag_0, const void *tag_1, bool &is_new
+)
+{
+    auto &index = getNodeIndex();
+    auto it = index.find(handle);
+
+    is_new = false;
+    if (it != index.end()) {
+        Node *node = it->second;
+        if ((node->owner == this) && (node->type == type)) {
+            node->tags = {tag_0, tag_1};
+            return node;
+        }
+        // A node without delete hook can outlive its resource, then the memory is reused by a new resource with other
+        // tags. Such a node is stale and is dropped, anything else really belongs to another tracker
+        if ((node->unhook != nullptr) || ((node->tags[0] == tag_0) && (node->tags[1] == tag_1))) {
+            return nullptr;
+        }
+        node->owner->unlink(node);
+    }
+
+    size_t type_index = getTypeIndex(type);
+    Node *node = new Node{_tails[type_index], nullptr, this, handle, type, {tag_0, tag_1}, nullptr, nullptr};
+    if (_tails[type_index] != nullptr) {
+        _tails[type_index]->next = node;
+    } else {
+        _heads[type_index] = node;
+    }
+    _tails[type_index] = node;
+    _counts[type_index]++;
+    index.emplace(handle, node);
+    is_new = true;
+
+    return node;
+}
+
+void AppResourceTracker::reset(Type type)
+{
+    release(type, [](const Node &) {
+        return true;
+    });
+}
+
+void AppResourceTracker::reset(void)
+{
+    for (size_t i = 0; i < TYPE_NUM; i++) {
+        reset(static_cast<Type>(i));
+    }
+}
+
+AppResourceTracker::Node *AppResourceTracker::find(void *handle)
+{
+    auto &index = getNodeIndex();
+    auto it = index.find(handle);
+
+    return (it != index.end()) ? it->second : nullptr;
+}
+
+bool AppResourceTracker::detach(void *handle)
+{
+    Node *node = find(handle);
+    if (node == nullptr) {
+        return false;
+    }
+    node->owner->unlink(node);
+
+    return true;
+}
+
+std::unordered_map<void *, AppResourceTracker::Node *> &AppResourceTracker::getNodeIndex(void)
+{
+    static std::unordered_map<void *, Node *> index;
+
+    return index;
+}
+
+void AppResourceTracker::unlink(Node *node)
+{
+    size_t type_index = getTypeIndex(node->type);
+
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        _heads[type_index] = node->next;
+    }
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        _tails[type_index] = node->prev;
+    }
+    _counts[type_index]--;
+    getNodeIndex().erase(node->handle);
+    delete node;
+}
+
+} // namespace esp_brookesia::systems::base
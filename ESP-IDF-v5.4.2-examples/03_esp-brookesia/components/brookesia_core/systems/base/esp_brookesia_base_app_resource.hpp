@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Bookkeeping of the resources (screens, timers and animations) recorded by one app. Each resource is a node
+ *        linked in the owner's list of its type and in an index shared by all trackers, so attaching, detaching from a
+ *        delete hook and cleaning only cost the resources of the app itself, whatever the number of LVGL objects.
+ *
+ * @note  It doesn't depend on LVGL: the resources are opaque handles, and the caller installs the delete hooks and does
+ *        the actual deletion. It is not thread-safe and is meant to be used from the GUI thread only.
+ */
+class AppResourceTracker {
+public:
+    enum class Type : uint8_t {
+        SCREEN = 0,
+        TIMER,
+        ANIM,
+        MAX,
+    };
+
+    struct Node;
+    using UnhookFunc = void (*)(const Node &node);
+
+    struct Node {
+        Node *prev;
+        Node *next;
+        AppResourceTracker *owner;
+        void *handle;
+        Type type;
+        // Identity of the resource when it was recorded (e.g. timer callback and user data), to tell if its memory has
+        // been reused by another resource
+        std::array<const void *, 2> tags;
+        // Delete hook installed by the caller, `unhook` is called when the node is released while the resource is alive
+        void *hook_data;
+        UnhookFunc unhook;
+    };
+
+    AppResourceTracker() = default;
+    ~AppResourceTracker();
+    AppResourceTracker(const AppResourceTracker &) = delete;
+    AppResourceTracker &operator=(const AppResourceTracker &) = delete;
+
+    /**
+     * @brief Attach a resource to this tracker. If it is already attached, only its tags are updated
+     *
+     * @param is_new Set to `true` if the node has just been created, the caller should install its delete hook then
+     *
+     * @return The node, or `nullptr` if the resource is attached to another tracker. A node of another tracker without
+     *         `unhook` and with other tags is considered stale, it is taken over.
+     */
+    Node *attach(Type type, void *handle, const void *tag_0, const void *tag_1, bool &is_new);
+    /**
+     * @brief Release all the resources of `type`. Each node is unlinked and unhooked before `deleter(node)` is called,
+     *        so the deleter can delete the resource even if that fires the hook. Resources attached again by the
+     *        deleter are left for the caller.
+     *
+     * @return Number of resources for which `deleter` returned `true`
+     */
+    template <typename F>
+    size_t release(Type type, F &&deleter)
+    {
+        size_t count = 0;
+        size_t remaining = _counts[getTypeIndex(type)];
+        Node *node = nullptr;
+        while ((remaining-- > 0) && ((node = _heads[getTypeIndex(type)]) != nullptr)) {
+            Node released = *node;
+            unlink(node);
+            if (released.unhook != nullptr) {
+                released.unhook(released);
+            }
+            if (deleter(released)) {
+                count++;
+            }
+        }
+        return count;
+    }
+    /**
+     * @brief Release the resources of `type` without deleting them
+     */
+    void reset(Type type);
+    void reset(void);
+    size_t getCount(Type type) const
+    {
+        return _counts[getTypeIndex(type)];
+    }
+    Node *getHead(Type type) const
+    {
+        return _heads[getTypeIndex(type)];
+    }
+
+    /**
+     * @brief Find the node of a resource among all the trackers
+     */
+    static Node *find(void *handle);
+    /**
+     * @brief Detach a resource from the tracker which owns it, without unhooking it. Meant to be called from the
+     *        delete hooks, when the resource is already being deleted.
+     *
+     * @return `true` if the resource was attached
+     */
+    static bool detach(void *handle);
+
+private:
+    static constexpr size_t TYPE_NUM = static_cast<size_t>(Type::MAX);
+
+    static size_t getTypeIndex(Type type)
+    {
+        return static_cast<size_t>(type);
+    }
+    static std::unordered_map<void *, Node *> &getNodeIndex(void);
+    void unlink(Node *node);
+
+    std::array<Node *, TYPE_NUM> _heads = {};
+    std::array<Node *, TYPE_NUM> _tails = {};
+    std::array<size_t, TYPE_NUM> _counts = {};
+};
+
+} // namespace esp_brookesia::systems::base
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include "esp_brookesia_systems_internal.h"
+#if !ESP_BROOKESIA_BASE_MANAGER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_base_utils.hpp"
+#include "esp_brookesia_base_app_snapshot.hpp"
+
+namespace esp_brookesia::systems::base {
+
+void AppSnapshotCodec::encode(const uint8_t *data, size_t size, size_t unit_size, std::vector<uint8_t> &output)
+{
+    size_t unit_count = (unit_size > 0) ? (size / unit_size) : 0;
+    size_t i = 0;
+
+    output.clear();
+    while (i < unit_count) {
+        size_t run = 1;
+        while ((i + run < unit_count) && (run < BLOCK_UNIT_NUM_MAX) &&
+                (memcmp(data + i * unit_size, data + (i + run) * unit_size, unit_size) == 0)) {
+            run++;
+        }
+        if (run > 1) {
+            output.push_back(RUN_FLAG | (run - 1));
+            output.insert(output.end(), data + i * unit_size, data + (i + 1) * unit_size);
+            i += run;
+            continue;
+        }
+
+        // Collect the literal units until the next run of at least 2
+        size_t literal = 1;
+        while ((i + literal < unit_count) && (literal < BLOCK_UNIT_NUM_MAX) &&
+                ((i + literal + 1 >= unit_count) ||
+                 (memcmp(data + (i + literal) * unit_size, data + (i + literal + 1) * unit_size, unit_size) != 0))) {
+            literal++;
+        }
+        output.push_back(literal - 1);
+        output.insert(output.end(), data + i * unit_size, data + (i + literal) * unit_size);
+        i += literal;
+    }
+}
+
+bool AppSnapshotCodec::decode(const std::vector<uint8_t> &input, size_t unit_size, uint8_t *data, size_t size)
+{
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+
+    ESP_UTILS_CHECK_FALSE_RETURN(unit_size > 0, false, "Invalid unit size");
+
+    while (in_pos < input.size()) {
+        uint8_t control = input[in_pos++];
+        size_t count = (control & ~RUN_FLAG) + 1;
+        size_t copy_size = (control & RUN_FLAG) ? unit_size : count * unit_size;
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (in_pos + copy_size <= input.size()) && (out_pos + count * unit_size <= size), false, "Corrupted data"
+        );
+        if (control & RUN_FLAG) {
+            for (size_t i = 0; i < count; i++, out_pos += unit_size) {
+                memcpy(data + out_pos, input.data() + in_pos, unit_size);
+            }
+        } else {
+            memcpy(data + out_pos, input.data() + in_pos, copy_size);
+            out_pos += copy_size;
+        }
+        in_pos += copy_size;
+    }
+
+    return true;
+}
+
+void AppSnapshotBudget::update(int id, size_t stored_bytes)
+{
+    auto it = _entries.find(id);
+    if (it != _entries.end()) {
+        _stored_bytes -= it->second.stored_bytes;
+        it->second = {stored_bytes, ++_view_tick};
+    } else {
+        _entries.emplace(id, Entry{stored_bytes, ++_view_tick});
+    }
+    _stored_bytes += stored_bytes;
+}
+
+bool AppSnapshotBudget::touch(int id)
+{
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return false;
+    }
+    it->second.view_tick = ++_view_tick;
+
+    return true;
+}
+
+void AppSnapshotBudget::remove(int id)
+{
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return;
+    }
+    _stored_bytes -= it->second.stored_bytes;
+    _entries.erase(it);
+}
+
+void AppSnapshotBudget::clear(void)
+{
+    _entries.clear();
+    _stored_bytes = 0;
+}
+
+std::vector<int> AppSnapshotBudget::trim(size_t budget_bytes, int keep_id)
+{
+    std::vector<int> evicted_ids;
+
+    if (budget_bytes == 0) {
+        return evicted_ids;
+    }
+
+    while (_stored_bytes > budget_bytes) {
+        auto victim_it = _entries.end();
+        for (auto it = _entries.begin(); it != _entries.end(); it++) {
+            if ((it->first != keep_id) &&
+                    ((victim_it == _entries.end()) || (it->second.view_tick < victim_it->second.view_tick))) {
+                victim_it = it;
+            }
+        }
+        if (victim_it == _entries.end()) {
+            ESP_UTILS_LOGW("App snapshot(%d) alone exceeds the budget(%d)", keep_id, static_cast<int>(budget_bytes));
+            break;
+        }
+
+        ESP_UTILS_LOGD("Evict app(%d) snapshot", victim_it->first);
+        evicted_ids.push_back(victim_it->first);
+        _stored_bytes -= victim_it->second.stored_bytes;
+        _entries.erase(victim_it);
+        _evicted_count++;
+    }
+
+    return evicted_ids;
+}
+
+} // namespace esp_brookesia::systems::base
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief RLE codec of the app snapshots, in units of one pixel so that the runs of a flat UI are found whatever the
+ *        color format. Each block starts with a control byte, `0x80 | (n - 1)` is followed by one unit repeated `n`
+ *        times and `n - 1` is followed by `n` literal units.
+ *
+ * @note  It doesn't depend on LVGL, the snapshot buffers are passed as plain bytes.
+ */
+class AppSnapshotCodec {
+public:
+    static constexpr uint8_t RUN_FLAG = 0x80;
+    static constexpr size_t BLOCK_UNIT_NUM_MAX = 0x80;
+
+    /**
+     * @brief Encode `size` bytes of `data`, a trailing partial unit is dropped
+     */
+    static void encode(const uint8_t *data, size_t size, size_t unit_size, std::vector<uint8_t> &output);
+    /**
+     * @brief Decode `input` into `data`, which must be large enough for all of it
+     *
+     * @return `false` if `input` is corrupted or doesn't fit in `size` bytes
+     */
+    static bool decode(const std::vector<uint8_t> &input, size_t unit_size, uint8_t *data, size_t size);
+};
+
+/**
+ * @brief Memory budget of the stored app snapshots. It only tracks their sizes and the order they were viewed in, the
+ *        owner destroys the snapshots it evicts.
+ */
+class AppSnapshotBudget {
+public:
+    /**
+     * @brief Record a snapshot which has just been saved, it becomes the most recently viewed one
+     */
+    void update(int id, size_t stored_bytes);
+    /**
+     * @brief Record a view of a snapshot
+     *
+     * @return `false` if the snapshot is not tracked
+     */
+    bool touch(int id);
+    void remove(int id);
+    void clear(void);
+    /**
+     * @brief Evict the least recently viewed snapshots until they fit in `budget_bytes`, `0` means no limit. The
+     *        snapshot `keep_id` is never evicted, even if it alone exceeds the budget.
+     *
+     * @return IDs of the evicted snapshots, in the order they were evicted
+     */
+    std::vector<int> trim(size_t budget_bytes, int keep_id);
+
+    size_t getCount(void) const
+    {
+        return _entries.size();
+    }
+    size_t getStoredBytes(void) const
+    {
+        return _stored_bytes;
+    }
+    size_t getEvictedCount(void) const
+    {
+        return _evicted_count;
+    }
+
+private:
+    struct Entry {
+        size_t stored_bytes;
+        uint32_t view_tick;
+    };
+
+    std::unordered_map<int, Entry> _entries;
+    uint32_t _view_tick = 0;
+    size_t _stored_bytes = 0;
+    size_t _evicted_count = 0;
+};
+
+} // namespace esp_brookesia::systems::base
@@ -3,12 +3,15 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
 #include <cstring>
+#include "esp_timer.h"
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_BASE_CORE_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_base_utils.hpp"
+#include "gui/lvgl/esp_brookesia_lv.hpp"
 #include "gui/lvgl/esp_brookesia_lv_lock.hpp"
 #include "squareline/ui_comp/ui_comp.h"
 #include "esp_brookesia_base_context.hpp"
@@ -97,12 +100,147 @@ bool Context::sendDataUpdateEvent(void *param)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
 
-    ESP_UTILS_CHECK_FALSE_RETURN(lv_obj_send_event(_event_obj.get(), _data_update_event_code, param) == LV_RES_OK, false,
-                                 "Send data update event failed");
+    if (_data_update_coalesce_enabled) {
+        // Delivered by the event post timer at the next refresh
+        _data_update_pending_param = param;
+        _data_update_pending_count++;
+        _data_update_pending_all = true;
+        _data_update_pending_ranges.clear();
+        return true;
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(dispatchDataUpdateEvent(param), false, "Send data update event failed");
+
+    return true;
+}
+
+bool Context::sendDataUpdateEvent(const std::vector<DataUpdateRange> &changed_ranges, void *param)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
+
+    ESP_UTILS_LOGD("Send data update event with %d changed ranges", static_cast<int>(changed_ranges.size()));
+    if (changed_ranges.empty()) {
+        return true;
+    }
+
+    if (_data_update_coalesce_enabled) {
+        _data_update_pending_param = param;
+        _data_update_pending_count++;
+        if (!_data_update_pending_all) {
+            _data_update_pending_ranges.insert(
+                _data_update_pending_ranges.end(), changed_ranges.begin(), changed_ranges.end()
+            );
+        }
+        return true;
+    }
+
+    _data_update_all = false;
+    _data_update_ranges = changed_ranges;
+    bool ret = dispatchDataUpdateEvent(param);
+    _data_update_all = true;
+    _data_update_ranges.clear();
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Send data update event failed");
+
+    return true;
+}
+
+bool Context::checkDataUpdated(const void *data, size_t size) const
+{
+    if (_data_update_all) {
+        return true;
+    }
+
+    const uint8_t *begin = static_cast<const uint8_t *>(data);
+    const uint8_t *end = begin + size;
+    for (auto &range : _data_update_ranges) {
+        const uint8_t *range_begin = static_cast<const uint8_t *>(range.data);
+        if ((range_begin < end) && (begin < (range_begin + range.size))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Context::setDataUpdateCoalesceEnabled(bool enabled)
+{
+    ESP_UTILS_LOGD("Set data update coalesce enabled(%d)", enabled);
+
+    _data_update_coalesce_enabled = enabled;
+    if (!enabled) {
+        ESP_UTILS_CHECK_FALSE_RETURN(flushDataUpdateEvent(), false, "Flush data update event failed");
+    }
+
+    return true;
+}
+
+bool Context::flushDataUpdateEvent(void)
+{
+    if ((_data_update_pending_count == 0) || !checkCoreInitialized()) {
+        return true;
+    }
+
+    void *param = _data_update_pending_param;
+    _data_update_merged_count = _data_update_pending_count;
+    _data_update_coalesced_count += _data_update_pending_count - 1;
+    _data_update_pending_param = nullptr;
+    _data_update_pending_count = 0;
+    _data_update_all = _data_update_pending_all;
+    _data_update_ranges.swap(_data_update_pending_ranges);
+    _data_update_pending_all = false;
+    _data_update_pending_ranges.clear();
+    ESP_UTILS_LOGD("Flush %d data update events", static_cast<int>(_data_update_merged_count));
+
+    bool ret = dispatchDataUpdateEvent(param);
+    _data_update_merged_count = 1;
+    _data_update_all = true;
+    _data_update_ranges.clear();
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Send data update event failed");
 
     return true;
 }
 
+bool Context::dispatchDataUpdateEvent(void *param)
+{
+    lv_display_t *display = lv_obj_get_display(_event_obj.get());
+    uint32_t inv_index = (display != nullptr) ? display->inv_p : 0;
+    int64_t start_us = esp_timer_get_time();
+
+    bool ret = (lv_obj_send_event(_event_obj.get(), _data_update_event_code, param) == LV_RES_OK);
+
+    int64_t time_us = esp_timer_get_time() - start_us;
+    uint32_t invalidated_px = getInvalidatedAreaSince(display, inv_index);
+    _data_update_stats.dispatch_count++;
+    _data_update_stats.total_time_us += time_us;
+    _data_update_stats.max_time_us = max(_data_update_stats.max_time_us, time_us);
+    _data_update_stats.total_invalidated_px += invalidated_px;
+    _data_update_stats.max_invalidated_px = max(_data_update_stats.max_invalidated_px, invalidated_px);
+    ESP_UTILS_LOGD(
+        "Dispatch data update event in %d us, invalidated %d px", static_cast<int>(time_us),
+        static_cast<int>(invalidated_px)
+    );
+
+    return ret;
+}
+
+uint32_t Context::getInvalidatedAreaSince(lv_display_t *display, uint32_t inv_index)
+{
+    if (display == nullptr) {
+        return 0;
+    }
+    // Once its buffer of areas is full, LVGL starts over with the whole screen
+    if (display->inv_p < inv_index) {
+        return lv_area_get_size(&display->inv_areas[0]);
+    }
+
+    uint32_t size = 0;
+    for (uint32_t i = inv_index; i < display->inv_p; i++) {
+        size += lv_area_get_size(&display->inv_areas[i]);
+    }
+
+    return size;
+}
+
 bool Context::registerNavigateEventCallback(lv_event_cb_t callback, void *user_data)
 {
     ESP_UTILS_CHECK_NULL_RETURN(callback, false, "Invalid callback function");
@@ -165,9 +303,9 @@ bool Context::sendAppEvent(const Context::AppEventData *data)
     return true;
 }
 
-bool Context::lockLv(int timeout)
+bool Context::lockLv(int timeout, const gui::LvLockSite &site)
 {
-    ESP_UTILS_CHECK_FALSE_RETURN(LvLock::getInstance().lock(timeout), false, "Lock failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(LvLock::getInstance().lock(timeout, site), false, "Lock failed");
 
     return true;
 }
@@ -214,6 +352,13 @@ bool Context::begin(void)
     ESP_UTILS_CHECK_FALSE_RETURN(esp_brookesia_core_utils_check_event_code_valid(app_event_code), false,
                                  "Create app event code failed");
 
+    // Drain the events posted from other threads and the coalesced data updates once per refresh period
+    _event_post_timer = std::make_unique<LvTimer>([this](void *) {
+        _event.processPostedEvents();
+        ESP_UTILS_CHECK_FALSE_EXIT(flushDataUpdateEvent(), "Flush data update event failed");
+    }, LV_DEF_REFR_PERIOD, this);
+    ESP_UTILS_CHECK_NULL_RETURN(_event_post_timer, false, "Create event post timer failed");
+
     // Save data
     _event_obj = event_obj;
     _data_update_event_code = data_update_event_code;
@@ -260,9 +405,15 @@ bool Context::del(void)
     _touch_device = nullptr;
     _free_event_code = _LV_EVENT_LAST;
     _event_obj.reset();
+    _event_post_timer.reset();
     _data_update_event_code = _LV_EVENT_LAST;
     _navigate_event_code = _LV_EVENT_LAST;
     _app_event_code = _LV_EVENT_LAST;
+    _data_update_pending_param = nullptr;
+    _data_update_pending_count = 0;
+    _data_update_pending_all = false;
+    _data_update_pending_ranges.clear();
+    _data_update_merged_count = 1;
 
     return ret;
 }
@@ -297,6 +448,9 @@ void Context::onCoreDataUpdateEventCallback(lv_event_t *event)
     core = (Context *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(core, "Invalid core object");
 
+    if (!core->checkDataUpdated(&core->_display._core_data, sizeof(core->_display._core_data))) {
+        return;
+    }
     ESP_UTILS_CHECK_FALSE_EXIT(core->_display.updateByNewData(), "Context display update failed");
 }
 
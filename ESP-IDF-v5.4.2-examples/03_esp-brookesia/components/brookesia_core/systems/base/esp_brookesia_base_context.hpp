@@ -6,6 +6,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "style/esp_brookesia_gui_style.hpp"
 #include "esp_brookesia_base_display.hpp"
 #include "esp_brookesia_base_manager.hpp"
@@ -22,6 +23,26 @@ public:
         Manager::Data manager;
     };
 
+    /**
+     * @brief Data changed by a data update, in the storage referenced by the widgets
+     */
+    struct DataUpdateRange {
+        const void *data;
+        size_t size;
+    };
+
+    /**
+     * @brief Cost of the data update dispatches, accumulated since the last reset. The invalidated area only counts the
+     *        areas invalidated by the callbacks themselves, not the ones caused later by the layout refresh.
+     */
+    struct DataUpdateStats {
+        size_t dispatch_count;
+        int64_t total_time_us;
+        int64_t max_time_us;
+        uint64_t total_invalidated_px;
+        uint32_t max_invalidated_px;
+    };
+
     enum class AppEventType : uint8_t {
         START,
         STOP,
@@ -90,10 +111,53 @@ public:
     bool registerDateUpdateEventCallback(lv_event_cb_t callback, void *user_data);
     bool unregisterDateUpdateEventCallback(lv_event_cb_t callback, void *user_data);
     bool sendDataUpdateEvent(void *param = nullptr);
+    /**
+     * @brief Send a data update event which only changed `changed_ranges`, the receivers can skip their update with
+     *        `checkDataUpdated()`. An empty list means nothing changed, no event is sent then.
+     */
+    bool sendDataUpdateEvent(const std::vector<DataUpdateRange> &changed_ranges, void *param = nullptr);
+    /**
+     * @brief Check if the data update being delivered changed the data at `data`, only meaningful inside the callbacks.
+     *        Always `true` for the events sent without changed ranges.
+     */
+    bool checkDataUpdated(const void *data, size_t size) const;
+    template <typename T>
+    bool checkDataUpdated(const T &data) const
+    {
+        return checkDataUpdated(&data, sizeof(T));
+    }
     lv_event_code_t getDataUpdateEventCode(void) const
     {
         return _data_update_event_code;
     }
+    /**
+     * @brief Enable or disable the coalescing of data update events. When enabled, the events sent within one refresh
+     *        period are delivered once at the next refresh, with the latest `param`. Disabling it flushes the pending
+     *        event immediately. The default is `CONFIG_ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE`.
+     */
+    bool setDataUpdateCoalesceEnabled(bool enabled);
+    /**
+     * @brief Get the number of events merged into the data update being delivered, only valid inside the callbacks
+     */
+    size_t getDataUpdateMergedCount(void) const
+    {
+        return _data_update_merged_count;
+    }
+    /**
+     * @brief Get the number of data update dispatches saved by coalescing
+     */
+    size_t getDataUpdateCoalescedCount(void) const
+    {
+        return _data_update_coalesced_count;
+    }
+    const DataUpdateStats &getDataUpdateStats(void) const
+    {
+        return _data_update_stats;
+    }
+    void resetDataUpdateStats(void)
+    {
+        _data_update_stats = {};
+    }
     // Navigate
     bool registerNavigateEventCallback(lv_event_cb_t callback, void *user_data);
     bool unregisterNavigateEventCallback(lv_event_cb_t callback, void *user_data);
@@ -116,7 +180,7 @@ public:
     }
 
     /* LVGL */
-    bool lockLv(int timeout = -1);
+    bool lockLv(int timeout = -1, const gui::LvLockSite &site = gui::LvLockSite::current());
     bool unlockLv();
 
     /* App */
@@ -168,15 +232,31 @@ protected:
     lv_indev_t   *_touch_device = nullptr;
 
 private:
+    bool flushDataUpdateEvent(void);
+    bool dispatchDataUpdateEvent(void *param);
+    static uint32_t getInvalidatedAreaSince(lv_display_t *display, uint32_t inv_index);
     static void onCoreDataUpdateEventCallback(lv_event_t *event);
     static void onCoreNavigateEventCallback(lv_event_t *event);
 
     // Event
     uint32_t _free_event_code;
     esp_brookesia::gui::LvObjSharedPtr _event_obj;
+    esp_brookesia::gui::LvTimerUniquePtr _event_post_timer;
     lv_event_code_t _data_update_event_code;
     lv_event_code_t _navigate_event_code;
     lv_event_code_t _app_event_code;
+    // Data update coalescing
+    bool _data_update_coalesce_enabled = ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE;
+    void *_data_update_pending_param = nullptr;
+    size_t _data_update_pending_count = 0;
+    size_t _data_update_merged_count = 1;
+    size_t _data_update_coalesced_count = 0;
+    // Data update ranges, empty with `*_all` set means everything changed
+    bool _data_update_pending_all = false;
+    std::vector<DataUpdateRange> _data_update_pending_ranges;
+    bool _data_update_all = true;
+    std::vector<DataUpdateRange> _data_update_ranges;
+    DataUpdateStats _data_update_stats = {};
 };
 
 } // namespace esp_brookesia::systems::base
@@ -3,6 +3,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <iterator>
+#include "esp_timer.h"
 #include "esp_brookesia_systems_internal.h"
 #include "lvgl/esp_brookesia_lv_container.hpp"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
@@ -17,6 +20,9 @@
 #include "esp_brookesia_base_app.hpp"
 #include "esp_brookesia_base_context.hpp"
 
+#define PERF_OVERLAY_UPDATE_PERIOD_MS   (500)
+#define PERF_OVERLAY_BG_OPA             (LV_OPA_70)
+
 using namespace std;
 using namespace esp_brookesia::gui;
 
@@ -123,6 +129,59 @@ bool Display::calibrateCoreIconImage(const StyleImage &target) const
     return true;
 }
 
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+bool Display::setPerfMonitorEnabled(bool enabled)
+{
+    lv_display_t *display = _system_context.getDisplayDevice();
+
+    ESP_UTILS_LOGD("Set performance monitor enabled(%d)", enabled);
+    ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_NULL_RETURN(display, false, "Invalid display device");
+
+    if (enabled == _perf_monitor_enabled) {
+        return true;
+    }
+
+    if (enabled) {
+        _perf_overlay_label = lv_label_create(getSystemScreenObject());
+        ESP_UTILS_CHECK_NULL_RETURN(_perf_overlay_label, false, "Create overlay label failed");
+        lv_obj_add_flag(_perf_overlay_label, LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_clear_flag(_perf_overlay_label, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_align(_perf_overlay_label, LV_ALIGN_TOP_RIGHT, 0, 0);
+        lv_obj_set_style_bg_color(_perf_overlay_label, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(_perf_overlay_label, PERF_OVERLAY_BG_OPA, 0);
+        lv_obj_set_style_text_color(_perf_overlay_label, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(_perf_overlay_label, 2, 0);
+        lv_label_set_text(_perf_overlay_label, "");
+
+        // The overlay updates are recorded like any other frame, they are kept rare to barely weigh in
+        _perf_overlay_timer = std::make_unique<LvTimer>([this](void *) {
+            updatePerfOverlay();
+        }, PERF_OVERLAY_UPDATE_PERIOD_MS, this);
+        if (_perf_overlay_timer == nullptr) {
+            lv_obj_delete(_perf_overlay_label);
+            _perf_overlay_label = nullptr;
+            ESP_UTILS_CHECK_NULL_RETURN(_perf_overlay_timer, false, "Create overlay timer failed");
+        }
+
+        _perf_monitor.reset();
+        _perf_frame = {};
+        _perf_last_log_us = esp_timer_get_time();
+        lv_display_add_event_cb(display, onPerfDisplayEventCallback, LV_EVENT_ALL, this);
+    } else {
+        lv_display_remove_event_cb_with_user_data(display, onPerfDisplayEventCallback, this);
+        _perf_overlay_timer = nullptr;
+        lv_obj_delete(_perf_overlay_label);
+        _perf_overlay_label = nullptr;
+        _perf_monitor.dump();
+    }
+    _perf_monitor_enabled = enabled;
+    ESP_UTILS_LOGI("Display performance monitor %s", enabled ? "enabled" : "disabled");
+
+    return true;
+}
+#endif
+
 bool Display::processMainScreenLoad(void)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Not initialized");
@@ -133,6 +192,17 @@ bool Display::processMainScreenLoad(void)
     return true;
 }
 
+DisplayPerfMonitor::Scene Display::getPerfScene(void) const
+{
+    App *active_app = _system_context.getManager().getActiveApp();
+
+    if (active_app != nullptr) {
+        return {DisplayPerfMonitor::SceneType::APP, active_app->getId()};
+    }
+
+    return {DisplayPerfMonitor::SceneType::MAIN, -1};
+}
+
 bool Display::begin(void)
 {
     lv_display_t *display = _system_context.getDisplayDevice();
@@ -199,6 +269,11 @@ bool Display::del(void)
         return true;
     }
 
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    if (!setPerfMonitorEnabled(false)) {
+        ESP_UTILS_LOGE("Disable performance monitor failed");
+    }
+#endif
     loadLvScreens();
 
     for (auto &style : _container_styles) {
@@ -209,10 +284,8 @@ bool Display::del(void)
     _main_screen = nullptr;
     _system_screen = nullptr;
     _container_style_index = 0;
-    _default_size_font_map.clear();
-    _default_height_font_map.clear();
-    _update_size_font_map.clear();
-    _update_height_font_map.clear();
+    _size_font_table.fill(nullptr);
+    _height_font_table.clear();
 
     return true;
 }
@@ -248,9 +321,6 @@ bool Display::updateByNewData(void)
         _system_screen_obj->setStyleAttribute(STYLE_FLAG_CLIP_CORNER, true), false, "Set system screen clip corner failed"
     );
 
-    // Text
-    _default_size_font_map = _update_size_font_map;
-
     // Container styles
     for (size_t i = 0; i < _container_styles.size(); i++) {
         lv_style_set_outline_width(&_container_styles[i], _core_data.container.styles[i].outline_width);
@@ -265,32 +335,32 @@ bool Display::updateByNewData(void)
 bool Display::calibrateCoreData(Data &data)
 {
     const lv_font_t *font_resource = nullptr;
+    std::map<uint8_t, const lv_font_t *> size_font_map;
+    std::map<uint8_t, const lv_font_t *> height_font_map;
 
     // Text
-    _update_size_font_map.clear();
-    _update_height_font_map.clear();
     for (int i = 0; i < data.text.default_fonts_num; i++) {
         ESP_UTILS_CHECK_VALUE_RETURN(data.text.default_fonts[i].size_px, StyleFont::FONT_SIZE_MIN,
                                      StyleFont::FONT_SIZE_MAX, false, "Invalid default font(%d) size", i);
         ESP_UTILS_CHECK_NULL_RETURN(data.text.default_fonts[i].font_resource, false, "Invalid default font(%d) dsc", i);
         font_resource = (lv_font_t *)data.text.default_fonts[i].font_resource;
-        // Save font for function ``
-        _update_size_font_map[data.text.default_fonts[i].size_px] = font_resource;
-        _update_height_font_map[font_resource->line_height] = font_resource;
+        size_font_map[data.text.default_fonts[i].size_px] = font_resource;
+        height_font_map[font_resource->line_height] = font_resource;
     }
     // Check if all default fonts are set, if not, use internal fonts
     for (int i = StyleFont::FONT_SIZE_MIN; i <= StyleFont::FONT_SIZE_MAX; i += 2) {
-        if (_update_size_font_map.find(i) == _update_size_font_map.end()) {
+        if (size_font_map.find(i) == size_font_map.end()) {
             ESP_UTILS_LOGW("Default font size(%d) is not found, try to use internal font instead", i);
             if (!esp_brookesia_core_utils_get_internal_font_by_size(i, &font_resource)) {
                 continue;
             }
-            _update_size_font_map[i] = font_resource;
-            if (_update_height_font_map.find(font_resource->line_height) == _update_height_font_map.end()) {
-                _update_height_font_map[font_resource->line_height] = font_resource;
+            size_font_map[i] = font_resource;
+            if (height_font_map.find(font_resource->line_height) == height_font_map.end()) {
+                height_font_map[font_resource->line_height] = font_resource;
             }
         }
     }
+    ESP_UTILS_CHECK_FALSE_RETURN(buildFontTables(size_font_map, height_font_map), false, "Build font tables failed");
 
     return true;
 }
@@ -309,6 +379,53 @@ void Display::loadLvScreens(void)
     lv_scr_load(_lv_main_screen);
 }
 
+bool Display::buildFontTables(
+    const std::map<uint8_t, const lv_font_t *> &size_font_map, const std::map<uint8_t, const lv_font_t *> &height_font_map
+)
+{
+    ESP_UTILS_LOGD("Build font tables");
+
+    _size_font_table.fill(nullptr);
+    _height_font_table.clear();
+    if (size_font_map.empty() || height_font_map.empty()) {
+        ESP_UTILS_LOGW("No font available");
+        return true;
+    }
+
+    // Size, ties go to the smaller font
+    for (int size_px = StyleFont::FONT_SIZE_MIN; size_px <= StyleFont::FONT_SIZE_MAX; size_px++) {
+        auto upper = size_font_map.lower_bound(size_px);
+        if (upper == size_font_map.end()) {
+            upper--;
+        } else if ((upper->first != size_px) && (upper != size_font_map.begin())) {
+            auto lower = std::prev(upper);
+            if ((size_px - lower->first) <= (upper->first - size_px)) {
+                upper = lower;
+            }
+        }
+        _size_font_table[size_px] = upper->second;
+    }
+
+    // Height, the heights lower than the smallest font use it, and the ones above the table use the last item
+    _height_font_table.resize(height_font_map.rbegin()->first + 1);
+    auto height_it = height_font_map.begin();
+    for (size_t height = 0; height < _height_font_table.size(); height++) {
+        auto next_it = std::next(height_it);
+        if ((next_it != height_font_map.end()) && (next_it->first <= height)) {
+            height_it = next_it;
+        }
+        // The size of a font is the smallest one which uses it
+        auto size_it = std::find_if(size_font_map.begin(), size_font_map.end(), [&](const auto & item) {
+            return item.second == height_it->second;
+        });
+        ESP_UTILS_CHECK_FALSE_RETURN(size_it != size_font_map.end(), false, "Font height(%d) size is not found",
+                                     height_it->first);
+        _height_font_table[height] = {height_it->second, size_it->first};
+    }
+
+    return true;
+}
+
 bool Display::calibrateStyleSizeInternal(StyleSize &target) const
 {
     if (target.width == StyleSize::LENGTH_AUTO) {
@@ -330,34 +447,103 @@ const lv_font_t *Display::getFontBySize(int size_px) const
         size_px, StyleFont::FONT_SIZE_MIN, StyleFont::FONT_SIZE_MAX, nullptr, "Invalid size"
     );
 
-    auto it = _update_size_font_map.find(size_px);
-    ESP_UTILS_CHECK_FALSE_RETURN(it != _update_size_font_map.end(), nullptr, "Font size(%d) is not found", size_px);
+    const lv_font_t *font = _size_font_table[size_px];
+    ESP_UTILS_CHECK_NULL_RETURN(font, nullptr, "Font size(%d) is not found", size_px);
 
-    return it->second;
+    return font;
 }
 
 const lv_font_t *Display::getFontByHeight(int height, int *size_px) const
 {
-    int ret_size = 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(!_height_font_table.empty(), nullptr, "Font height(%d) is not found", height);
 
-    auto lower = _update_height_font_map.lower_bound(height);
-    if ((lower->first != height) && (lower != _update_height_font_map.begin())) {
-        lower--;
+    const HeightFontItem &item =
+        _height_font_table[std::clamp(height, 0, static_cast<int>(_height_font_table.size()) - 1)];
+    if (size_px != nullptr) {
+        *size_px = item.size_px;
     }
-    ESP_UTILS_CHECK_FALSE_RETURN(lower != _update_height_font_map.end(), nullptr, "Font height(%d) is not found", height);
 
-    if (size_px != nullptr) {
-        for (auto &it : _update_size_font_map) {
-            if (it.second == lower->second) {
-                ret_size = it.first;
-                break;
+    return item.font;
+}
+
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+void Display::processPerfDisplayEvent(lv_event_code_t code)
+{
+    lv_display_t *display = _system_context.getDisplayDevice();
+    int64_t now_us = esp_timer_get_time();
+
+    switch (code) {
+    case LV_EVENT_REFR_START:
+        _perf_frame = {};
+        _perf_frame.start_us = now_us;
+        break;
+    case LV_EVENT_RENDER_START:
+        // Only sent when there is something to render, the areas are joined by now
+        if (_perf_frame.start_us < 0) {
+            break;
+        }
+        _perf_frame.is_rendered = true;
+        for (uint32_t i = 0; i < display->inv_p; i++) {
+            if (!display->inv_area_joined[i]) {
+                _perf_frame.frame.invalidated_px += lv_area_get_size(&display->inv_areas[i]);
             }
         }
-        ESP_UTILS_CHECK_FALSE_RETURN(ret_size != 0, nullptr, "Font size is not found");
-        *size_px = ret_size;
+        break;
+    case LV_EVENT_FLUSH_START:
+        _perf_frame.flush_start_us = now_us;
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+        if (_perf_frame.flush_start_us >= 0) {
+            _perf_frame.frame.flush_us += now_us - _perf_frame.flush_start_us;
+            _perf_frame.flush_start_us = -1;
+        }
+        break;
+    case LV_EVENT_REFR_READY:
+        if ((_perf_frame.start_us >= 0) && _perf_frame.is_rendered) {
+            _perf_frame.frame.render_us = std::max<int64_t>(
+                                              now_us - _perf_frame.start_us - _perf_frame.frame.flush_us, 0
+                                          );
+            _perf_monitor.recordFrame(getPerfScene(), _perf_frame.start_us, _perf_frame.frame);
+        }
+        _perf_frame.start_us = -1;
+        break;
+    default:
+        break;
+    }
+}
+
+void Display::updatePerfOverlay(void)
+{
+    DisplayPerfMonitor::Report report;
+    const DisplayPerfMonitor::Scene &scene = _perf_monitor.getLastScene();
+
+    if (_perf_monitor.getReport(scene, report)) {
+        lv_label_set_text_fmt(
+            _perf_overlay_label, "%s(%d) %d.%d fps, %d dropped\nrender %d/%d us, flush %d/%d us\n%d px/frame",
+            DisplayPerfMonitor::getSceneTypeName(scene.type), scene.index, static_cast<int>(report.fps),
+            static_cast<int>(report.fps * 10) % 10, static_cast<int>(report.dropped_count),
+            static_cast<int>(report.render_us.p50), static_cast<int>(report.render_us.p90),
+            static_cast<int>(report.flush_us.p50), static_cast<int>(report.flush_us.p90),
+            static_cast<int>(report.avg_invalidated_px)
+        );
     }
 
-    return lower->second;
+    if (ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS > 0) {
+        int64_t now_us = esp_timer_get_time();
+        if ((now_us - _perf_last_log_us) >= (ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS * 1000LL)) {
+            _perf_last_log_us = now_us;
+            _perf_monitor.dump();
+        }
+    }
 }
 
+void Display::onPerfDisplayEventCallback(lv_event_t *event)
+{
+    Display *display = static_cast<Display *>(lv_event_get_user_data(event));
+    ESP_UTILS_CHECK_NULL_EXIT(display, "Invalid display");
+
+    display->processPerfDisplayEvent(lv_event_get_code(event));
+}
+#endif
+
 } // namespace esp_brookesia::systems::base
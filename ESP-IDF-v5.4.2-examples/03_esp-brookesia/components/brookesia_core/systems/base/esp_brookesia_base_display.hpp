@@ -7,9 +7,12 @@
 
 #include <map>
 #include <array>
+#include <vector>
 #include "lvgl.h"
+#include "esp_brookesia_systems_internal.h"
 #include "lvgl/esp_brookesia_lv.hpp"
 #include "esp_brookesia_base_app.hpp"
+#include "esp_brookesia_base_display_perf.hpp"
 
 namespace esp_brookesia::systems::base {
 
@@ -116,6 +119,30 @@ public:
     bool calibrateCoreFont(const esp_brookesia::gui::StyleSize *parent, esp_brookesia::gui::StyleFont &target) const;
     bool calibrateCoreIconImage(const esp_brookesia::gui::StyleImage &target) const;
 
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    /**
+     * @brief Enable or disable the display performance monitor at runtime. While it is enabled, every rendered frame
+     *        is recorded under the scene returned by `getPerfScene()`, and an overlay on the system screen shows the
+     *        numbers of the current scene. The percentiles of all the scenes are logged when it is disabled.
+     *
+     * @note  The render time is the refresh time minus the time spent in the flush callback, so with an asynchronous
+     *        flush the wait for the previous transfer counts as render time.
+     */
+    bool setPerfMonitorEnabled(bool enabled);
+    bool togglePerfMonitor(void)
+    {
+        return setPerfMonitorEnabled(!checkPerfMonitorEnabled());
+    }
+    bool checkPerfMonitorEnabled(void) const
+    {
+        return _perf_monitor_enabled;
+    }
+    const DisplayPerfMonitor &getPerfMonitor(void) const
+    {
+        return _perf_monitor;
+    }
+#endif
+
 protected:
     Context &_system_context;
     const Data &_core_data;
@@ -141,6 +168,11 @@ private:
     {
         return true;
     }
+    /**
+     * @brief Get what is on the screen, for the performance monitor. The base implementation only tells the active app
+     *        from the main screen.
+     */
+    virtual DisplayPerfMonitor::Scene getPerfScene(void) const;
 
     bool begin(void);
     bool del(void);
@@ -149,9 +181,23 @@ private:
     void saveLvScreens(void);
     void loadLvScreens(void);
 
+    struct HeightFontItem {
+        const lv_font_t *font;
+        int size_px;
+    };
+
+    bool buildFontTables(
+        const std::map<uint8_t, const lv_font_t *> &size_font_map,
+        const std::map<uint8_t, const lv_font_t *> &height_font_map
+    );
     bool calibrateStyleSizeInternal(esp_brookesia::gui::StyleSize &target) const;
     const lv_font_t *getFontBySize(int size) const;
     const lv_font_t *getFontByHeight(int height, int *size_px) const;
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    void processPerfDisplayEvent(lv_event_code_t code);
+    void updatePerfOverlay(void);
+    static void onPerfDisplayEventCallback(lv_event_t *event);
+#endif
 
     lv_obj_t *_lv_main_screen = nullptr;
     lv_obj_t *_lv_system_screen = nullptr;
@@ -163,10 +209,27 @@ private:
 
     uint8_t _container_style_index = 0;
     std::array<lv_style_t, DEBUG_STYLES_NUM> _container_styles;
-    std::map<uint8_t, const lv_font_t *> _default_size_font_map;
-    std::map<uint8_t, const lv_font_t *> _default_height_font_map;
-    std::map<uint8_t, const lv_font_t *> _update_size_font_map;
-    std::map<uint8_t, const lv_font_t *> _update_height_font_map;
+    // Font lookup tables, built once per calibration of the core data so that each query is a single index:
+    //  - by size in pixels, every size maps to the nearest available font
+    //  - by line height, every height maps to the largest font not higher than it
+    std::array<const lv_font_t *, esp_brookesia::gui::StyleFont::FONT_SIZE_MAX + 1> _size_font_table{};
+    std::vector<HeightFontItem> _height_font_table;
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    // Frame being refreshed, `start_us` is `-1` out of a refresh
+    struct PerfFrameState {
+        int64_t start_us = -1;
+        int64_t flush_start_us = -1;
+        bool is_rendered = false;
+        DisplayPerfMonitor::Frame frame = {};
+    };
+
+    bool _perf_monitor_enabled = false;
+    DisplayPerfMonitor _perf_monitor{ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM, ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS};
+    PerfFrameState _perf_frame;
+    int64_t _perf_last_log_us = 0;
+    lv_obj_t *_perf_overlay_label = nullptr;
+    esp_brookesia::gui::LvTimerUniquePtr _perf_overlay_timer;
+#endif
 };
 
 } // namespace esp_brookesia::systems::base
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_brookesia_systems_internal.h"
+#if !ESP_BROOKESIA_BASE_DISPLAY_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_base_utils.hpp"
+#include "esp_brookesia_base_display_perf.hpp"
+
+namespace esp_brookesia::systems::base {
+
+// Nearest-rank percentiles of the sorted values
+static DisplayPerfMonitor::Percentiles get_percentiles(std::vector<int64_t> &values)
+{
+    DisplayPerfMonitor::Percentiles percentiles;
+
+    if (values.empty()) {
+        return percentiles;
+    }
+    std::sort(values.begin(), values.end());
+    auto get_rank = [&](size_t percent) {
+        size_t rank = (values.size() * percent + 99) / 100;
+        return values[std::max<size_t>(rank, 1) - 1];
+    };
+    percentiles.p50 = get_rank(50);
+    percentiles.p90 = get_rank(90);
+    percentiles.p99 = get_rank(99);
+    percentiles.max = values.back();
+
+    return percentiles;
+}
+
+DisplayPerfMonitor::DisplayPerfMonitor(size_t sample_num, int target_fps):
+    _sample_num(std::max<size_t>(sample_num, 1)),
+    _frame_budget_us(1000 * 1000 / std::max(target_fps, 1))
+{
+}
+
+void DisplayPerfMonitor::recordFrame(const Scene &scene, int64_t start_us, const Frame &frame)
+{
+    SceneStats &stats = _scene_stats[getSceneKey(scene)];
+    int64_t frame_us = frame.render_us + frame.flush_us;
+
+    if (stats.samples.size() < _sample_num) {
+        stats.samples.push_back(frame);
+    } else {
+        stats.samples[stats.next_sample] = frame;
+    }
+    stats.next_sample = (stats.next_sample + 1) % _sample_num;
+    stats.frame_count++;
+    stats.total_invalidated_px += frame.invalidated_px;
+    if (frame_us > _frame_budget_us) {
+        stats.dropped_count += (frame_us - 1) / _frame_budget_us;
+    }
+
+    // Only consecutive frames of the same scene close enough are part of an animation
+    if ((_last_frame_start_us >= 0) && (scene == _last_scene) && (start_us >= _last_frame_start_us) &&
+            ((start_us - _last_frame_start_us) <= IDLE_GAP_US)) {
+        stats.animating_frame_count++;
+        stats.animating_us += start_us - _last_frame_start_us;
+    }
+    _last_scene = scene;
+    _last_frame_start_us = start_us;
+}
+
+void DisplayPerfMonitor::reset(void)
+{
+    _scene_stats.clear();
+    _last_scene = {};
+    _last_frame_start_us = -1;
+}
+
+bool DisplayPerfMonitor::getReport(const Scene &scene, Report &report) const
+{
+    auto it = _scene_stats.find(getSceneKey(scene));
+    if (it == _scene_stats.end()) {
+        return false;
+    }
+    fillReport(it->first, it->second, report);
+
+    return true;
+}
+
+std::vector<DisplayPerfMonitor::Report> DisplayPerfMonitor::getReports(void) const
+{
+    std::vector<Report> reports(_scene_stats.size());
+    size_t i = 0;
+
+    for (auto &[key, stats] : _scene_stats) {
+        fillReport(key, stats, reports[i++]);
+    }
+
+    return reports;
+}
+
+void DisplayPerfMonitor::dump(void) const
+{
+    std::vector<Report> reports = getReports();
+
+    std::stable_sort(reports.begin(), reports.end(), [](const Report & a, const Report & b) {
+        return a.dropped_count > b.dropped_count;
+    });
+    ESP_UTILS_LOGI("Display performance (budget %d us/frame):", static_cast<int>(_frame_budget_us));
+    for (auto &report : reports) {
+        ESP_UTILS_LOGI(
+            "\t%s(%d): %d frames, %d dropped, %d.%d fps, avg %d px | render p50/p90/p99/max %d/%d/%d/%d us | "
+            "flush %d/%d/%d/%d us", getSceneTypeName(report.scene.type), report.scene.index,
+            static_cast<int>(report.frame_count), static_cast<int>(report.dropped_count), static_cast<int>(report.fps),
+            static_cast<int>(report.fps * 10) % 10, static_cast<int>(report.avg_invalidated_px),
+            static_cast<int>(report.render_us.p50), static_cast<int>(report.render_us.p90),
+            static_cast<int>(report.render_us.p99), static_cast<int>(report.render_us.max),
+            static_cast<int>(report.flush_us.p50), static_cast<int>(report.flush_us.p90),
+            static_cast<int>(report.flush_us.p99), static_cast<int>(report.flush_us.max)
+        );
+    }
+}
+
+const char *DisplayPerfMonitor::getSceneTypeName(SceneType type)
+{
+    switch (type) {
+    case SceneType::MAIN:
+        return "Main";
+    case SceneType::APP:
+        return "App";
+    case SceneType::RECENTS:
+        return "Recents";
+    case SceneType::QUICK_SETTINGS:
+        return "Quick settings";
+    default:
+        return "Unknown";
+    }
+}
+
+void DisplayPerfMonitor::fillReport(const SceneKey &key, const SceneStats &stats, Report &report) const
+{
+    std::vector<int64_t> render_values;
+    std::vector<int64_t> flush_values;
+    std::vector<int64_t> frame_values;
+
+    render_values.reserve(stats.samples.size());
+    flush_values.reserve(stats.samples.size());
+    frame_values.reserve(stats.samples.size());
+    for (auto &frame : stats.samples) {
+        render_values.push_back(frame.render_us);
+        flush_values.push_back(frame.flush_us);
+        frame_values.push_back(frame.render_us + frame.flush_us);
+    }
+
+    report.scene = {static_cast<SceneType>(key.first), key.second};
+    report.frame_count = stats.frame_count;
+    report.dropped_count = stats.dropped_count;
+    report.fps = (stats.animating_us > 0) ? (stats.animating_frame_count * 1000000.0f / stats.animating_us) : 0;
+    report.render_us = get_percentiles(render_values);
+    report.flush_us = get_percentiles(flush_values);
+    report.frame_us = get_percentiles(frame_values);
+    report.avg_invalidated_px = (stats.frame_count > 0) ? (stats.total_invalidated_px / stats.frame_count) : 0;
+}
+
+} // namespace esp_brookesia::systems::base
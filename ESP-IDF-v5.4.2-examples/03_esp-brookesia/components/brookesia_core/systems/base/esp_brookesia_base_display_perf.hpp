@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace esp_brookesia::systems::base {
+
+/**
+ * @brief Per-scene statistics of the rendered frames: render and flush time percentiles, invalidated area, FPS and
+ *        dropped frames. A scene is what is on the screen while a frame is rendered, such as a launcher page or an app.
+ *
+ * @note  It doesn't depend on LVGL, `Display` feeds it from the display refresh events. It is not thread-safe and is
+ *        meant to be used from the GUI thread only.
+ */
+class DisplayPerfMonitor {
+public:
+    enum class SceneType : uint8_t {
+        MAIN = 0,
+        APP,
+        RECENTS,
+        QUICK_SETTINGS,
+        MAX,
+    };
+
+    struct Scene {
+        SceneType type = SceneType::MAIN;
+        int index = -1;         // Launcher page of `MAIN`, app ID of `APP`, `-1` if unused
+
+        bool operator==(const Scene &other) const
+        {
+            return (type == other.type) && (index == other.index);
+        }
+        bool operator!=(const Scene &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    struct Frame {
+        int64_t render_us;
+        int64_t flush_us;
+        uint32_t invalidated_px;
+    };
+
+    struct Percentiles {
+        int64_t p50 = 0;
+        int64_t p90 = 0;
+        int64_t p99 = 0;
+        int64_t max = 0;
+    };
+
+    /**
+     * @brief Statistics of a scene. The percentiles only cover the last `sample_num` frames, the counts cover all
+     *        the frames since the last `reset()`.
+     */
+    struct Report {
+        Scene scene;
+        size_t frame_count = 0;
+        // Budget periods missed, a frame taking 2.5 budgets drops 2 frames
+        size_t dropped_count = 0;
+        // Rendered frames per second while the scene is animating, the idle gaps are not counted
+        float fps = 0;
+        Percentiles render_us;
+        Percentiles flush_us;
+        Percentiles frame_us;
+        uint32_t avg_invalidated_px = 0;
+    };
+
+    // Gap between two frames of a scene above which it is considered idle instead of animating
+    static constexpr int64_t IDLE_GAP_US = 250 * 1000;
+
+    DisplayPerfMonitor(size_t sample_num, int target_fps);
+
+    /**
+     * @param start_us Time at which the refresh of the frame started
+     */
+    void recordFrame(const Scene &scene, int64_t start_us, const Frame &frame);
+    void reset(void);
+
+    bool getReport(const Scene &scene, Report &report) const;
+    std::vector<Report> getReports(void) const;
+    const Scene &getLastScene(void) const
+    {
+        return _last_scene;
+    }
+    int64_t getFrameBudgetUs(void) const
+    {
+        return _frame_budget_us;
+    }
+
+    /**
+     * @brief Print the report of each scene, the ones with dropped frames first
+     */
+    void dump(void) const;
+    static const char *getSceneTypeName(SceneType type);
+
+private:
+    using SceneKey = std::pair<uint8_t, int>;
+
+    struct SceneStats {
+        std::vector<Frame> samples;     // Ring of the last frames
+        size_t next_sample = 0;
+        size_t frame_count = 0;
+        size_t dropped_count = 0;
+        size_t animating_frame_count = 0;
+        int64_t animating_us = 0;
+        uint64_t total_invalidated_px = 0;
+    };
+
+    static SceneKey getSceneKey(const Scene &scene)
+    {
+        return {static_cast<uint8_t>(scene.type), scene.index};
+    }
+    void fillReport(const SceneKey &key, const SceneStats &stats, Report &report) const;
+
+    size_t _sample_num;
+    int64_t _frame_budget_us;
+    std::map<SceneKey, SceneStats> _scene_stats;
+    Scene _last_scene;
+    int64_t _last_frame_start_us = -1;
+};
+
+} // namespace esp_brookesia::systems::base
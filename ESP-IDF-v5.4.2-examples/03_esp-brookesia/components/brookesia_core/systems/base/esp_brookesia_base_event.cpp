@@ -8,16 +8,60 @@
 #if !ESP_BROOKESIA_BASE_EVENT_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+#   if defined(ESP_PLATFORM)
+#       include "esp_timer.h"
+#   else
+#       include <chrono>
+#   endif
+#endif
 #include "private/esp_brookesia_base_utils.hpp"
 #include "esp_brookesia_base_event.hpp"
 
+#define POST_QUEUE_SIZE     ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE
+
 using namespace std;
 
 namespace esp_brookesia::systems::base {
 
+static_assert((POST_QUEUE_SIZE > 0) && ((POST_QUEUE_SIZE & (POST_QUEUE_SIZE - 1)) == 0),
+              "Event post queue size must be a power of 2");
+
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+static int64_t getProfileTimeUs(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+           ).count();
+#endif
+}
+
+static size_t getProfileBucket(int64_t elapsed_us)
+{
+    size_t bucket = 0;
+    while ((elapsed_us > 0) && (bucket < Event::PROFILE_HISTOGRAM_BUCKET_NUM - 1)) {
+        elapsed_us >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+#endif
+
 Event::Event():
-    _free_event_id(ID::CUSTOM)
+    _free_event_id(ID::CUSTOM),
+    _post_cells(new PostCell[POST_QUEUE_SIZE]),
+    _post_mask(POST_QUEUE_SIZE - 1),
+    _post_enqueue_pos(0),
+    _post_dequeue_pos(0),
+    _post_dropped_count(0)
 {
+    for (size_t i = 0; i < POST_QUEUE_SIZE; i++) {
+        _post_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
 }
 
 Event::~Event()
@@ -42,8 +86,24 @@ Event::ID operator++(Event::ID &id, int)
 void Event::reset(void)
 {
     _free_event_id = ID::CUSTOM;
-    _event_handlers.clear();
+    _object_slots.clear();
+    _free_object_slots.clear();
+    _object_slot_table.clear();
+    _object_slot_table_used = 0;
+    _handler_index.clear();
+    _id_slots.clear();
     _available_event_ids.clear();
+    _available_event_id_flags.clear();
+
+    // Discard the pending posted events, their objects are not registered anymore
+    PostedEvent event = {};
+    while (popPostedEvent(event)) {
+    }
+    _post_dropped_count.store(0, std::memory_order_relaxed);
+    _coalesced_count = 0;
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    resetProfile();
+#endif
 }
 
 bool Event::registerEvent(void *object, Handler handler, ID id, void *user_data)
@@ -52,8 +112,15 @@ bool Event::registerEvent(void *object, Handler handler, ID id, void *user_data)
                    handler, user_data);
     ESP_UTILS_CHECK_NULL_RETURN(handler, false, "Invalid handler");
 
-    auto &handlers_for_object = _event_handlers[object];
-    handlers_for_object[id].emplace_back(handler, user_data);
+    size_t slot = acquireObjectSlot(object);
+    auto &object_slot = _object_slots[slot];
+    size_t index = getIndex(id);
+    if (index >= object_slot.id_handlers.size()) {
+        object_slot.id_handlers.resize(index + 1);
+    }
+    object_slot.id_handlers[index].push_back({handler, user_data});
+    object_slot.handlers_count++;
+    addHandlerIndex(slot, index, handler);
 
     return true;
 }
@@ -62,31 +129,51 @@ bool Event::sendEvent(void *object, ID id, void *param) const
 {
     ESP_UTILS_LOGD("Send event for object(0x%p) ID(%d) param(0x%p)", object, static_cast<int>(id), param);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    return dispatchEvent(object, id, param, 1);
+}
+
+bool Event::dispatchEvent(void *object, ID id, void *param, size_t merged_count) const
+{
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    if (getIndex(id) >= _profile_dispatch_counts.size()) {
+        _profile_dispatch_counts.resize(getIndex(id) + 1, 0);
+    }
+    _profile_dispatch_counts[getIndex(id)]++;
+#endif
+
+    size_t slot = 0;
+    if (!findObjectSlot(object, slot)) {
         return true;
     }
 
-    auto &handlers_for_object = object_it->second;
-    auto handler_it = handlers_for_object.find(id);
-    if (handler_it == handlers_for_object.end()) {
+    size_t index = getIndex(id);
+    if (index >= _object_slots[slot].id_handlers.size()) {
         return true;
     }
 
-    HandlerData data = {};
+    uint32_t generation = _object_slots[slot].generation;
     bool ret = true;
-    for (auto &handler_data_pair : handler_it->second) {
-        auto &handler = handler_data_pair.first;
-        auto &user_data = handler_data_pair.second;
-        if (handler == nullptr) {
+    // Handlers are allowed to (un)register events, so the row is re-indexed on every iteration and the dispatch stops
+    // once the object has been unregistered
+    for (size_t i = 0; i < _object_slots[slot].id_handlers[index].size(); i++) {
+        HandlerEntry entry = _object_slots[slot].id_handlers[index][i];
+        if (entry.handler == nullptr) {
             ESP_UTILS_LOGE("Handler is nullptr");
             continue;
         }
-        data = {id, object, param, user_data};
-        if (!handler(data)) {
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+        int64_t start_us = getProfileTimeUs();
+#endif
+        if (!entry.handler({id, object, param, entry.user_data, merged_count})) {
             ret = false;
             ESP_UTILS_LOGE("Do handler failed");
         }
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+        profileHandler(entry.handler, id, getProfileTimeUs() - start_us);
+#endif
+        if (_object_slots[slot].generation != generation) {
+            break;
+        }
     }
 
     return ret;
@@ -96,28 +183,28 @@ void Event::unregisterEvent(void *object)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p)", object);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    size_t slot = 0;
+    if (!findObjectSlot(object, slot)) {
         return;
     }
 
     // Save event IDs to be removed
-    std::unordered_set<ID> event_ids;
-    for (auto &id_handlers_pair : object_it->second) {
-        event_ids.insert(id_handlers_pair.first);
+    std::vector<ID> event_ids;
+    size_t removed_count = 0;
+    for (size_t index = 0; index < _object_slots[slot].id_handlers.size(); index++) {
+        if (!_object_slots[slot].id_handlers[index].empty()) {
+            removed_count += clearObjectSlotID(slot, index);
+            event_ids.push_back(static_cast<ID>(index));
+        }
     }
 
     // Remove handlers for the given object
-    size_t handlers_count = getEventHandlersCount();
-    _event_handlers.erase(object_it);
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    releaseObjectSlot(slot);
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
     for (const auto &id : event_ids) {
-        if (!checkUsedEventID(id)) {
-            ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-            _available_event_ids.insert(id);
-        }
+        recycleEventID(id);
     }
 }
 
@@ -125,172 +212,492 @@ void Event::unregisterEvent(void *object, ID id)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p) ID(%d)", object, static_cast<int>(id));
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    size_t slot = 0;
+    if (!findObjectSlot(object, slot)) {
         return;
     }
 
-    auto &handlers_for_object = object_it->second;
-    size_t handlers_count = getEventHandlersCount();
-    if (handlers_for_object.erase(id) == 0) {
+    size_t removed_count = clearObjectSlotID(slot, getIndex(id));
+    if (removed_count == 0) {
         return;
     }
-    if (handlers_for_object.empty()) {
-        _event_handlers.erase(object_it);
-    }
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    releaseObjectSlotIfEmpty(slot);
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
-    if (!checkUsedEventID(id)) {
-        ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-        _available_event_ids.insert(id);
-    }
+    recycleEventID(id);
 }
 
 void Event::unregisterEvent(void *object, Handler handler, ID id)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p) ID(%d) handler(0x%p)", object, static_cast<int>(id), handler);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    size_t slot = 0;
+    if (!findObjectSlot(object, slot)) {
         return;
     }
 
-    auto &handlers_for_object = object_it->second;
-    auto handler_it = handlers_for_object.find(id);
-    if (handler_it == handlers_for_object.end()) {
+    size_t removed_count = removeObjectSlotHandler(slot, getIndex(id), handler);
+    if (removed_count == 0) {
         return;
     }
+    releaseObjectSlotIfEmpty(slot);
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
-    auto &handlers = handler_it->second;
-    auto it = std::remove_if(handlers.begin(), handlers.end(),
-    [&](const std::pair<Handler, void *> &pair) {
-        return handler == pair.first;
-    });
-    if (it == handlers.end()) {
+    // Add removed event IDs to available event IDs
+    recycleEventID(id);
+}
+
+void Event::unregisterEvent(ID id)
+{
+    ESP_UTILS_LOGD("Unregister event for ID(%d)", static_cast<int>(id));
+
+    size_t index = getIndex(id);
+    size_t removed_count = 0;
+    if (index < _id_slots.size()) {
+        // Copy the slots, since clearing them updates the index
+        std::vector<size_t> slots(_id_slots[index].begin(), _id_slots[index].end());
+        for (auto slot : slots) {
+            removed_count += clearObjectSlotID(slot, index);
+            releaseObjectSlotIfEmpty(slot);
+        }
+    }
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
+
+    // Add removed event IDs to available event IDs
+    recycleEventID(id);
+}
+
+void Event::unregisterEvent(Handler handler)
+{
+    ESP_UTILS_LOGD("Unregister event for handler(0x%p)", handler);
+
+    auto handler_it = _handler_index.find(handler);
+    if (handler_it == _handler_index.end()) {
         return;
     }
 
-    size_t handlers_count = getEventHandlersCount();
-    handlers.erase(it, handlers.end());
-    if (handlers.empty()) {
-        handlers_for_object.erase(handler_it);
+    // Save the registrations to be removed, since removing them updates the index
+    std::vector<uint64_t> keys;
+    keys.reserve(handler_it->second.size());
+    for (auto &key_count_pair : handler_it->second) {
+        keys.push_back(key_count_pair.first);
     }
-    if (handlers_for_object.empty()) {
-        _event_handlers.erase(object_it);
+
+    std::vector<ID> event_ids;
+    size_t removed_count = 0;
+    for (auto key : keys) {
+        size_t slot = static_cast<size_t>(key >> 32);
+        size_t index = static_cast<size_t>(key & UINT32_MAX);
+        removed_count += removeObjectSlotHandler(slot, index, handler);
+        releaseObjectSlotIfEmpty(slot);
+        event_ids.push_back(static_cast<ID>(index));
     }
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
-    if (!checkUsedEventID(id)) {
-        _available_event_ids.insert(id);
+    for (const auto &id : event_ids) {
+        recycleEventID(id);
     }
 }
 
-void Event::unregisterEvent(ID id)
+bool Event::postEvent(void *object, ID id, void *param)
 {
-    ESP_UTILS_LOGD("Unregister event for ID(%d)", static_cast<int>(id));
-
-    size_t handlers_count = getEventHandlersCount();
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        if (handlers_for_object.find(id) != handlers_for_object.end()) {
-            handlers_for_object.erase(id);
+    size_t pos = _post_enqueue_pos.load(std::memory_order_relaxed);
+    PostCell *cell = nullptr;
+    while (true) {
+        cell = &_post_cells[pos & _post_mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (_post_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The consumer has not released this cell yet, the queue is full
+            _post_dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = _post_enqueue_pos.load(std::memory_order_relaxed);
         }
     }
-    cleanEmptyHandlers();
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
 
-    // Add removed event IDs to available event IDs
-    ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-    _available_event_ids.insert(id);
+    cell->event = {object, id, param};
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
 }
 
-void Event::unregisterEvent(Handler handler)
+size_t Event::processPostedEvents(void)
 {
-    ESP_UTILS_LOGD("Unregister event for handler(0x%p)", handler);
+    // Only drain what was queued before this batch, so a handler which posts again cannot starve the GUI thread
+    size_t pending_count = _post_enqueue_pos.load(std::memory_order_acquire) - _post_dequeue_pos;
+    if (_coalesce_enabled) {
+        return processCoalescedEvents(pending_count);
+    }
 
-    // Save event IDs to be removed
-    std::unordered_set<ID> event_ids;
-    size_t handlers_count = getEventHandlersCount();
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        for (auto &id_handlers_pair : handlers_for_object) {
-            auto &handlers = id_handlers_pair.second;
-            auto it = std::remove_if(handlers.begin(), handlers.end(),
-            [&](const std::pair<Handler, void *> &pair) {
-                return handler == pair.first;
-            });
-            if (it != handlers.end()) {
-                event_ids.insert(id_handlers_pair.first);
-                handlers.erase(it, handlers.end());
+    size_t processed_count = 0;
+    PostedEvent event = {};
+    while ((processed_count < pending_count) && popPostedEvent(event)) {
+        dispatchEvent(event.object, event.id, event.param, 1);
+        processed_count++;
+    }
+
+    if (processed_count > 0) {
+        ESP_UTILS_LOGD("Processed %d posted events", static_cast<int>(processed_count));
+    }
+
+    return processed_count;
+}
+
+size_t Event::processCoalescedEvents(size_t pending_count)
+{
+    // Merge the batch by (object, ID), keeping the position of the first event and the param of the latest one
+    size_t processed_count = 0;
+    PostedEvent event = {};
+    while ((processed_count < pending_count) && popPostedEvent(event)) {
+        auto result = _coalesce_batch_index.emplace(std::make_pair(event.object, event.id), _coalesce_batch.size());
+        if (result.second) {
+            _coalesce_batch.push_back({event, 1});
+        } else {
+            auto &coalesced_event = _coalesce_batch[result.first->second];
+            coalesced_event.event.param = event.param;
+            coalesced_event.merged_count++;
+        }
+        processed_count++;
+    }
+    _coalesce_batch_index.clear();
+
+    // Handlers may post again, but they never touch the batch since only this thread consumes the queue
+    for (auto &coalesced_event : _coalesce_batch) {
+        dispatchEvent(coalesced_event.event.object, coalesced_event.event.id, coalesced_event.event.param,
+                      coalesced_event.merged_count);
+    }
+    _coalesced_count += processed_count - _coalesce_batch.size();
+    if (processed_count > 0) {
+        ESP_UTILS_LOGD("Processed %d posted events in %d dispatches", static_cast<int>(processed_count),
+                       static_cast<int>(_coalesce_batch.size()));
+    }
+    _coalesce_batch.clear();
+
+    return processed_count;
+}
+
+void Event::dump(void) const
+{
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    ESP_UTILS_LOGI("Event profile:");
+    for (size_t i = 0; i < _profile_dispatch_counts.size(); i++) {
+        if (_profile_dispatch_counts[i] > 0) {
+            ESP_UTILS_LOGI("\tID(%d): %d dispatches", static_cast<int>(i), static_cast<int>(_profile_dispatch_counts[i]));
+        }
+    }
+    for (auto &[handler, profile] : _profile_handlers) {
+        char histogram_str[PROFILE_HISTOGRAM_BUCKET_NUM * 12] = {};
+        int len = 0;
+        for (size_t i = 0; i < profile.histogram.size(); i++) {
+            if (profile.histogram[i] > 0) {
+                bool is_last = (i == profile.histogram.size() - 1);
+                len += snprintf(histogram_str + len, sizeof(histogram_str) - len, " %s%dus:%d", is_last ? ">=" : "<",
+                                is_last ? (1 << (i - 1)) : (1 << i), static_cast<int>(profile.histogram[i]));
             }
         }
+        ESP_UTILS_LOGI(
+            "\tHandler(0x%p)%s: %d calls, avg %d us, max %d us (ID(%d)), histogram:%s", handler,
+            (handler == _profile_worst_handler) ? " [worst]" : "", static_cast<int>(profile.call_count),
+            static_cast<int>(profile.total_us / profile.call_count), static_cast<int>(profile.max_us),
+            static_cast<int>(profile.max_id), histogram_str
+        );
     }
-    cleanEmptyHandlers();
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+#else
+    ESP_UTILS_LOGI("Event profiling is disabled, enable `ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING` first");
+#endif
+}
 
-    // Add removed event IDs to available event IDs
-    for (const auto &id : event_ids) {
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+size_t Event::getDispatchCount(ID id) const
+{
+    return (getIndex(id) < _profile_dispatch_counts.size()) ? _profile_dispatch_counts[getIndex(id)] : 0;
+}
+
+const Event::HandlerProfile *Event::getHandlerProfile(Handler handler) const
+{
+    auto it = _profile_handlers.find(handler);
+
+    return (it != _profile_handlers.end()) ? &it->second : nullptr;
+}
+
+void Event::resetProfile(void)
+{
+    _profile_dispatch_counts.clear();
+    _profile_handlers.clear();
+    _profile_worst_handler = nullptr;
+}
+
+void Event::profileHandler(Handler handler, ID id, int64_t elapsed_us) const
+{
+    auto &profile = _profile_handlers[handler];
+    profile.call_count++;
+    profile.total_us += elapsed_us;
+    profile.histogram[getProfileBucket(elapsed_us)]++;
+    if ((profile.call_count == 1) || (elapsed_us > profile.max_us)) {
+        profile.max_us = elapsed_us;
+        profile.max_id = id;
+    }
+
+    auto worst_it = _profile_handlers.find(_profile_worst_handler);
+    if ((worst_it == _profile_handlers.end()) || (profile.max_us > worst_it->second.max_us)) {
+        _profile_worst_handler = handler;
+    }
+}
+#endif
+
+bool Event::popPostedEvent(PostedEvent &event)
+{
+    PostCell &cell = _post_cells[_post_dequeue_pos & _post_mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    // The producer may have reserved the cell without publishing it yet
+    if (sequence != _post_dequeue_pos + 1) {
+        return false;
+    }
+
+    event = cell.event;
+    cell.sequence.store(_post_dequeue_pos + _post_mask + 1, std::memory_order_release);
+    _post_dequeue_pos++;
+
+    return true;
+}
+
+bool Event::checkUsedEventID(ID id) const
+{
+    size_t index = getIndex(id);
+
+    return (index < _id_slots.size()) && !_id_slots[index].empty();
+}
+
+void Event::recycleEventID(ID id)
+{
+    // Only the IDs handed out by `getFreeEventID()` can be recycled
+    size_t index = getIndex(id);
+    if ((id <= ID::CUSTOM) || checkUsedEventID(id) ||
+            ((index < _available_event_id_flags.size()) && _available_event_id_flags[index])) {
+        return;
+    }
+
+    ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
+    if (index >= _available_event_id_flags.size()) {
+        _available_event_id_flags.resize(index + 1, false);
+    }
+    _available_event_id_flags[index] = true;
+    _available_event_ids.push_back(id);
+}
+
+Event::ID Event::getFreeEventID()
+{
+    while (!_available_event_ids.empty()) {
+        ID id = _available_event_ids.back();
+        _available_event_ids.pop_back();
+        _available_event_id_flags[getIndex(id)] = false;
+        // The ID may have been registered directly after being recycled
         if (!checkUsedEventID(id)) {
-            ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-            _available_event_ids.insert(id);
+            return id;
         }
     }
+
+    return ++_free_event_id;
 }
 
-bool Event::checkUsedEventID(ID id) const
+bool Event::findObjectSlot(void *object, size_t &slot) const
 {
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        if (handlers_for_object.find(id) != handlers_for_object.end()) {
+    if (_object_slot_table.empty()) {
+        return false;
+    }
+
+    size_t mask = _object_slot_table.size() - 1;
+    for (size_t i = getObjectHash(object) & mask; ; i = (i + 1) & mask) {
+        uint32_t entry = _object_slot_table[i];
+        if (entry == 0) {
+            return false;
+        }
+        if ((entry != OBJECT_SLOT_TOMBSTONE) && (_object_slots[entry - 1].object == object)) {
+            slot = entry - 1;
             return true;
         }
     }
-    return false;
 }
 
-Event::ID Event::getFreeEventID()
+void Event::insertObjectSlot(void *object, size_t slot)
 {
-    if (!_available_event_ids.empty()) {
-        ID id = *_available_event_ids.begin();
-        _available_event_ids.erase(id);
+    // The object is not in the table, the first erased entry of its probe sequence can be reused without adding to the
+    // load
+    if (!_object_slot_table.empty()) {
+        size_t mask = _object_slot_table.size() - 1;
+        for (size_t i = getObjectHash(object) & mask; _object_slot_table[i] != 0; i = (i + 1) & mask) {
+            if (_object_slot_table[i] == OBJECT_SLOT_TOMBSTONE) {
+                _object_slot_table[i] = static_cast<uint32_t>(slot + 1);
+                return;
+            }
+        }
+    }
 
-        return id;
+    // Keep the load factor (including tombstones) under 1/2, so probe sequences stay short. The capacity follows the
+    // live objects, a rehash which only drops tombstones keeps it
+    if ((_object_slot_table_used + 1) * 2 > _object_slot_table.size()) {
+        size_t live_count = _object_slots.size() - _free_object_slots.size();
+        size_t capacity = OBJECT_SLOT_TABLE_MIN_CAPACITY;
+        while (capacity < live_count * 4) {
+            capacity *= 2;
+        }
+        rehashObjectSlots(capacity);
     }
 
-    return ++_free_event_id;
+    size_t mask = _object_slot_table.size() - 1;
+    size_t i = getObjectHash(object) & mask;
+    while (_object_slot_table[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    _object_slot_table[i] = static_cast<uint32_t>(slot + 1);
+    _object_slot_table_used++;
 }
 
-size_t Event::getEventHandlersCount(void) const
+void Event::eraseObjectSlot(void *object)
 {
-    size_t count = 0;
-    for (auto &object_handler_pair : _event_handlers) {
-        for (auto &id_handlers_pair : object_handler_pair.second) {
-            count += id_handlers_pair.second.size();
+    size_t mask = _object_slot_table.size() - 1;
+    for (size_t i = getObjectHash(object) & mask; _object_slot_table[i] != 0; i = (i + 1) & mask) {
+        uint32_t entry = _object_slot_table[i];
+        if ((entry != OBJECT_SLOT_TOMBSTONE) && (_object_slots[entry - 1].object == object)) {
+            _object_slot_table[i] = OBJECT_SLOT_TOMBSTONE;
+            return;
         }
     }
-
-    return count;
 }
 
-void Event::cleanEmptyHandlers()
+void Event::rehashObjectSlots(size_t capacity)
 {
-    for (auto it = _event_handlers.begin(); it != _event_handlers.end(); ) {
-        auto &id_map = it->second;
-        for (auto id_it = id_map.begin(); id_it != id_map.end(); ) {
-            if (id_it->second.empty()) {
-                id_it = id_map.erase(id_it);
-            } else {
-                ++id_it;
-            }
+    _object_slot_table.assign(capacity, 0);
+    _object_slot_table_used = 0;
+
+    size_t mask = capacity - 1;
+    for (size_t slot = 0; slot < _object_slots.size(); slot++) {
+        if (!_object_slots[slot].used) {
+            continue;
         }
-        if (id_map.empty()) {
-            it = _event_handlers.erase(it);
-        } else {
-            ++it;
+        size_t i = getObjectHash(_object_slots[slot].object) & mask;
+        while (_object_slot_table[i] != 0) {
+            i = (i + 1) & mask;
         }
+        _object_slot_table[i] = static_cast<uint32_t>(slot + 1);
+        _object_slot_table_used++;
+    }
+}
+
+size_t Event::acquireObjectSlot(void *object)
+{
+    size_t slot = 0;
+    if (findObjectSlot(object, slot)) {
+        return slot;
+    }
+
+    if (!_free_object_slots.empty()) {
+        slot = _free_object_slots.back();
+        _free_object_slots.pop_back();
+    } else {
+        slot = _object_slots.size();
+        _object_slots.emplace_back();
+    }
+    _object_slots[slot].object = object;
+    _object_slots[slot].used = true;
+    insertObjectSlot(object, slot);
+
+    return slot;
+}
+
+void Event::releaseObjectSlot(size_t slot)
+{
+    auto &object_slot = _object_slots[slot];
+    eraseObjectSlot(object_slot.object);
+    // The handler lists have been emptied by the caller and keep their capacity, so the row can be reused without new
+    // allocations
+    object_slot.object = nullptr;
+    object_slot.used = false;
+    object_slot.handlers_count = 0;
+    object_slot.generation++;
+    _free_object_slots.push_back(slot);
+}
+
+void Event::releaseObjectSlotIfEmpty(size_t slot)
+{
+    if (_object_slots[slot].used && (_object_slots[slot].handlers_count == 0)) {
+        releaseObjectSlot(slot);
+    }
+}
+
+void Event::addHandlerIndex(size_t slot, size_t index, Handler handler)
+{
+    _handler_index[handler][getHandlerIndexKey(slot, index)]++;
+    if (index >= _id_slots.size()) {
+        _id_slots.resize(index + 1);
     }
+    _id_slots[index].insert(slot);
+}
+
+void Event::removeHandlerIndex(size_t slot, size_t index, Handler handler)
+{
+    auto handler_it = _handler_index.find(handler);
+    if (handler_it == _handler_index.end()) {
+        return;
+    }
+
+    auto key_it = handler_it->second.find(getHandlerIndexKey(slot, index));
+    if ((key_it != handler_it->second.end()) && (--key_it->second == 0)) {
+        handler_it->second.erase(key_it);
+        if (handler_it->second.empty()) {
+            _handler_index.erase(handler_it);
+        }
+    }
+}
+
+size_t Event::removeObjectSlotHandler(size_t slot, size_t index, Handler handler)
+{
+    auto &object_slot = _object_slots[slot];
+    if (index >= object_slot.id_handlers.size()) {
+        return 0;
+    }
+
+    auto &handlers = object_slot.id_handlers[index];
+    auto it = std::remove_if(handlers.begin(), handlers.end(), [&](const HandlerEntry & entry) {
+        return handler == entry.handler;
+    });
+    size_t removed_count = std::distance(it, handlers.end());
+    for (size_t i = 0; i < removed_count; i++) {
+        removeHandlerIndex(slot, index, handler);
+    }
+    handlers.erase(it, handlers.end());
+    object_slot.handlers_count -= removed_count;
+    if (handlers.empty()) {
+        _id_slots[index].erase(slot);
+    }
+
+    return removed_count;
+}
+
+size_t Event::clearObjectSlotID(size_t slot, size_t index)
+{
+    auto &object_slot = _object_slots[slot];
+    if ((index >= object_slot.id_handlers.size()) || object_slot.id_handlers[index].empty()) {
+        return 0;
+    }
+
+    auto &handlers = object_slot.id_handlers[index];
+    size_t removed_count = handlers.size();
+    for (auto &entry : handlers) {
+        removeHandlerIndex(slot, index, entry.handler);
+    }
+    handlers.clear();
+    object_slot.handlers_count -= removed_count;
+    _id_slots[index].erase(slot);
+
+    return removed_count;
 }
 
 } // namespace esp_brookesia::systems::base
@@ -5,11 +5,16 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
 #include <memory>
+#include <utility>
+#include "esp_brookesia_systems_internal.h"
 
 namespace esp_brookesia::systems::base {
 
@@ -26,6 +31,7 @@ public:
         void *object;
         void *param;
         void *user_data;
+        size_t merged_count;    // Number of posted events merged into this delivery, `1` if not coalesced
     };
     using Handler = bool (*)(const HandlerData &data);
 
@@ -41,18 +47,191 @@ public:
     void unregisterEvent(ID id);
     void unregisterEvent(Handler handler);
 
+    /**
+     * @brief Queue an event from any thread without taking the LVGL lock. The event is dispatched by
+     *        `processPostedEvents()` on the GUI thread, so `param` must stay valid until then.
+     *
+     * @return `false` if the queue is full
+     */
+    bool postEvent(void *object, ID id, void *param = nullptr);
+    /**
+     * @brief Dispatch the events queued by `postEvent()` in one batch. Must be called from the thread which owns the
+     *        handlers (the LVGL task). Events posted by handlers during the batch are left for the next call.
+     *
+     * @return Number of dispatched events
+     */
+    size_t processPostedEvents(void);
+    size_t getPostDroppedCount(void) const
+    {
+        return _post_dropped_count.load(std::memory_order_relaxed);
+    }
+    /**
+     * @brief Enable or disable the coalescing of posted events. When enabled, the events with the same object and ID in
+     *        one batch of `processPostedEvents()` are delivered once, with the latest `param` and the number of merged
+     *        events in `HandlerData::merged_count`. Events sent by `sendEvent()` are never coalesced.
+     */
+    void setCoalesceEnabled(bool enabled)
+    {
+        _coalesce_enabled = enabled;
+    }
+    bool isCoalesceEnabled(void) const
+    {
+        return _coalesce_enabled;
+    }
+    /**
+     * @brief Get the number of dispatches saved by coalescing since the last `reset()`
+     */
+    size_t getCoalescedCount(void) const
+    {
+        return _coalesced_count;
+    }
+
     ID getFreeEventID();
+    /**
+     * @brief Get the capacity of the table from the registered objects to their dispatch rows. It follows the number of
+     *        registered objects, not the number of registrations
+     */
+    size_t getObjectSlotTableCapacity(void) const
+    {
+        return _object_slot_table.size();
+    }
+
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    static constexpr size_t PROFILE_HISTOGRAM_BUCKET_NUM = 16;
+    /**
+     * @brief Latency statistics of a handler. Bucket `0` counts the calls shorter than 1 us, bucket `i` counts the calls
+     *        in [2^(i-1), 2^i) us, and the last bucket also takes everything longer.
+     */
+    struct HandlerProfile {
+        size_t call_count = 0;
+        int64_t total_us = 0;
+        int64_t max_us = 0;
+        ID max_id = ID::APP;
+        std::array<size_t, PROFILE_HISTOGRAM_BUCKET_NUM> histogram = {};
+    };
+
+    size_t getDispatchCount(ID id) const;
+    const HandlerProfile *getHandlerProfile(Handler handler) const;
+    /**
+     * @brief Get the handler with the slowest single call since the last reset, `nullptr` if no handler has been called
+     */
+    Handler getWorstHandler(void) const
+    {
+        return _profile_worst_handler;
+    }
+    void resetProfile(void);
+#endif
+    /**
+     * @brief Print the dispatch counts and the handler latency histograms. Only prints a notice when
+     *        `ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING` is disabled.
+     */
+    void dump(void) const;
 
 private:
-    using HandlerList = std::vector<std::pair<Handler, void *>>;
+    static constexpr uint32_t OBJECT_SLOT_TOMBSTONE = UINT32_MAX;
+    static constexpr size_t OBJECT_SLOT_TABLE_MIN_CAPACITY = 16;
+
+    struct HandlerEntry {
+        Handler handler;
+        void *user_data;
+    };
+    struct PostedEvent {
+        void *object;
+        ID id;
+        void *param;
+    };
+    struct CoalescedEvent {
+        PostedEvent event;
+        size_t merged_count;
+    };
+    struct PostedEventKeyHash {
+        size_t operator()(const std::pair<void *, ID> &key) const
+        {
+            return getObjectHash(key.first) ^ getIndex(key.second);
+        }
+    };
+    /**
+     * @brief Cell of the bounded multi-producer/single-consumer ring. `sequence` tells whether the cell is free for the
+     *        producer at position `sequence` or ready for the consumer at position `sequence - 1`.
+     */
+    struct PostCell {
+        std::atomic<size_t> sequence;
+        PostedEvent event;
+    };
+    using HandlerList = std::vector<HandlerEntry>;
+    /**
+     * @brief Dispatch row of a registered object. Rows are recycled instead of erased, the generation is bumped every
+     *        time a row is released so that an in-flight dispatch can detect that its object has been unregistered.
+     */
+    struct ObjectSlot {
+        void *object = nullptr;
+        bool used = false;
+        uint32_t generation = 0;
+        size_t handlers_count = 0;
+        std::vector<HandlerList> id_handlers;   // Indexed by `ID`
+    };
 
+    static size_t getIndex(ID id)
+    {
+        return static_cast<size_t>(id);
+    }
+    static size_t getObjectHash(void *object)
+    {
+        size_t hash = static_cast<size_t>(reinterpret_cast<uintptr_t>(object)) * 2654435761U;
+        return hash ^ (hash >> 16);
+    }
+    bool dispatchEvent(void *object, ID id, void *param, size_t merged_count) const;
+    bool findObjectSlot(void *object, size_t &slot) const;
+    void insertObjectSlot(void *object, size_t slot);
+    void eraseObjectSlot(void *object);
+    void rehashObjectSlots(size_t capacity);
+    size_t acquireObjectSlot(void *object);
+    void releaseObjectSlot(size_t slot);
+    void releaseObjectSlotIfEmpty(size_t slot);
+    static uint64_t getHandlerIndexKey(size_t slot, size_t index)
+    {
+        return (static_cast<uint64_t>(slot) << 32) | static_cast<uint64_t>(index);
+    }
+    void addHandlerIndex(size_t slot, size_t index, Handler handler);
+    void removeHandlerIndex(size_t slot, size_t index, Handler handler);
+    size_t removeObjectSlotHandler(size_t slot, size_t index, Handler handler);
+    size_t clearObjectSlotID(size_t slot, size_t index);
     bool checkUsedEventID(ID id) const;
-    size_t getEventHandlersCount(void) const;
-    void cleanEmptyHandlers();
+    void recycleEventID(ID id);
+    bool popPostedEvent(PostedEvent &event);
+    size_t processCoalescedEvents(size_t pending_count);
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    void profileHandler(Handler handler, ID id, int64_t elapsed_us) const;
+#endif
 
     ID _free_event_id;
-    std::unordered_map<void *, std::unordered_map<ID, HandlerList>> _event_handlers;
-    std::unordered_set<ID> _available_event_ids;
+    std::vector<ObjectSlot> _object_slots;
+    std::vector<size_t> _free_object_slots;
+    // Open addressing table from object to slot, `0` means empty and `OBJECT_SLOT_TOMBSTONE` means erased
+    std::vector<uint32_t> _object_slot_table;
+    size_t _object_slot_table_used = 0;
+    // Reverse indexes, kept up to date on every (un)register so that no path has to scan all the objects
+    std::unordered_map<Handler, std::unordered_map<uint64_t, size_t>> _handler_index;   // Handler -> (slot, ID) -> count
+    std::vector<std::unordered_set<size_t>> _id_slots;                                   // ID -> slots using it
+    std::vector<ID> _available_event_ids;
+    std::vector<bool> _available_event_id_flags;                                         // Indexed by `ID`
+    // Post queue
+    std::unique_ptr<PostCell[]> _post_cells;
+    size_t _post_mask;
+    std::atomic<size_t> _post_enqueue_pos;
+    size_t _post_dequeue_pos;
+    std::atomic<size_t> _post_dropped_count;
+    // Coalescing, only touched by the consumer
+    bool _coalesce_enabled = false;
+    size_t _coalesced_count = 0;
+    std::vector<CoalescedEvent> _coalesce_batch;
+    std::unordered_map<std::pair<void *, ID>, size_t, PostedEventKeyHash> _coalesce_batch_index;
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+    // Profiling, updated by the const dispatch path
+    mutable std::vector<size_t> _profile_dispatch_counts;                    // Indexed by `ID`
+    mutable std::unordered_map<Handler, HandlerProfile> _profile_handlers;
+    mutable Handler _profile_worst_handler = nullptr;
+#endif
 };
 
 } // namespace esp_brookesia::systems::base
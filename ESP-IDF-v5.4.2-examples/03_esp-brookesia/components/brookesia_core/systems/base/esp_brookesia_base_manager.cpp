@@ -5,23 +5,66 @@
  */
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_BASE_MANAGER_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_base_utils.hpp"
 #include "lvgl/esp_brookesia_lv.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "esp_brookesia_base_manager.hpp"
 #include "esp_brookesia_base_context.hpp"
 
+#define APP_PREINSTALL_CHECK_PERIOD_MS  (200)
+
+#define APP_PREPARE_THREAD_NAME             "app_prepare"
+#define APP_PREPARE_THREAD_STACK_SIZE       (6 * 1024)
+#define APP_PREPARE_THREAD_STACK_CAPS_EXT   (false)
+#define APP_PREPARE_POST_RETRY_MS           (10)
+
 using namespace std;
 using namespace esp_brookesia::gui;
 
 namespace esp_brookesia::systems::base {
 
+/**
+ * @brief Nearest neighbour downscale, the thumbnails are small enough that filtering is not worth the capture time
+ */
+static void snapshot_downscale(const lv_draw_buf_t *src, lv_draw_buf_t *dst, size_t pixel_size)
+{
+    uint32_t src_w = src->header.w;
+    uint32_t src_h = src->header.h;
+    uint32_t dst_w = dst->header.w;
+    uint32_t dst_h = dst->header.h;
+
+    for (uint32_t y = 0; y < dst_h; y++) {
+        const uint8_t *src_row = src->data + (y * src_h / dst_h) * src->header.stride;
+        uint8_t *dst_row = dst->data + y * dst->header.stride;
+        for (uint32_t x = 0; x < dst_w; x++) {
+            memcpy(dst_row + x * pixel_size, src_row + (x * src_w / dst_w) * pixel_size, pixel_size);
+        }
+    }
+}
+
+static size_t snapshot_get_unit_size(const lv_image_header_t &header, size_t data_size)
+{
+    size_t pixel_size = lv_color_format_get_size(static_cast<lv_color_format_t>(header.cf));
+
+    return ((pixel_size > 0) && (data_size % pixel_size == 0)) ? pixel_size : 1;
+}
+
 Manager::Manager(Context &core, const Data &data):
     _system_context(core),
-    _core_data(data)
+    _core_data(data),
+    _memory_watermark{
+        ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB * 1024, ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB * 1024,
+        ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB * 1024
+    },
+    _app_snapshot_config{0, 0, ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB * 1024,
+                         ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION}
 {
 }
 
@@ -34,6 +77,11 @@ Manager::~Manager()
 }
 
 int Manager::installApp(App *app)
+{
+    return processAppInstall(app, false);
+}
+
+int Manager::processAppInstall(App *app, bool is_lazy)
 {
     bool app_installed = false;
     bool display_process_app_installed = false;
@@ -42,22 +90,26 @@ int Manager::installApp(App *app)
 
     ESP_UTILS_CHECK_NULL_RETURN(app, -1, "Invalid app");
 
-    ESP_UTILS_LOGD("Install App(%p)", app);
+    ESP_UTILS_LOGD("Install App(%p), lazy(%d)", app, is_lazy);
 
     // Check if the app is already installed
     for (auto it = _id_installed_app_map.begin(); it != _id_installed_app_map.end(); it++) {
         ESP_UTILS_CHECK_FALSE_RETURN(it->second != app, -1, "Already installed");
     }
 
-    // Initialize app
-    ESP_UTILS_CHECK_FALSE_GOTO(app_installed = app->processInstall(&_system_context, _app_free_id), err, "App install failed");
+    // Initialize app, a lazy install only keeps what the launcher icon needs
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        app_installed = app->processInstall(&_system_context, _app_free_id, is_lazy), err, "App install failed"
+    );
     // Insert app to installed_app_map
     ESP_UTILS_CHECK_FALSE_GOTO(_id_installed_app_map.insert(pair <int, App *>(app->_id, app)).second, err,
                                "Insert app failed");
 
-    ESP_UTILS_CHECK_FALSE_GOTO(display.getAppVisualArea(app, app_visual_area), err, "Display get app visual area failed");
-    ESP_UTILS_CHECK_FALSE_GOTO(app->setVisualArea(app_visual_area), err, "App set visual area failed");
-    ESP_UTILS_CHECK_FALSE_GOTO(app->calibrateVisualArea(), err, "App calibrate visual area failed");
+    if (!is_lazy) {
+        ESP_UTILS_CHECK_FALSE_GOTO(display.getAppVisualArea(app, app_visual_area), err, "Display get app visual area failed");
+        ESP_UTILS_CHECK_FALSE_GOTO(app->setVisualArea(app_visual_area), err, "App set visual area failed");
+        ESP_UTILS_CHECK_FALSE_GOTO(app->calibrateVisualArea(), err, "App calibrate visual area failed");
+    }
 
     // Process display
     ESP_UTILS_CHECK_FALSE_GOTO(display_process_app_installed = display.processAppInstall(app), err,
@@ -142,6 +194,7 @@ bool Manager::uninstallApp(int id)
 bool Manager::initAppFromRegistry(std::vector<RegistryAppInfo> &app_infos)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("Manager::initAppFromRegistry");
 
     app_infos.clear();
 
@@ -164,6 +217,7 @@ bool Manager::initAppFromRegistry(std::vector<RegistryAppInfo> &app_infos)
 bool Manager::installAppFromRegistry(std::vector<RegistryAppInfo> &app_infos, std::vector<std::string> *ordered_app_names)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("Manager::installAppFromRegistry");
 
     // Reorder app_infos according to the order in ordered_app_names
     if (ordered_app_names != nullptr && !ordered_app_names->empty()) {
@@ -192,22 +246,120 @@ bool Manager::installAppFromRegistry(std::vector<RegistryAppInfo> &app_infos, st
 
     // Install apps
     for (auto &[name, app] : app_infos) {
-        ESP_UTILS_LOGI("Install app: %s", name.c_str());
+        ESP_UTILS_LOGI("Install app: %s%s", name.c_str(), _app_lazy_install_enabled ? " (lazy)" : "");
 
-        auto app_id = installApp(app.get());
+        int64_t start_us = esp_timer_get_time();
+        auto trace_id = ESP_BROOKESIA_TRACE_BEGIN("Manager::installApp");
+        auto app_id = processAppInstall(app.get(), _app_lazy_install_enabled);
+        ESP_BROOKESIA_TRACE_END(trace_id);
         if (!checkAppID_Valid(app_id)) {
             ESP_UTILS_LOGE("\t - Install failed");
         }
         ESP_UTILS_LOGI("\t - Install success (id: %d)", app_id);
+        _app_install_timeline.push_back({
+            name, app_id, esp_timer_get_time() - start_us, _app_lazy_install_enabled ? -1 : 0
+        });
 
         if (ordered_app_names != nullptr) {
             ordered_app_names->emplace_back(name);
         }
     }
+#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
+    printAppInstallTimeline();
+#endif
+
+    if (_app_lazy_install_enabled && (_app_lazy_preinstall_idle_ms > 0)) {
+        if (_app_preinstall_timer == nullptr) {
+            _app_preinstall_timer = std::make_unique<LvTimer>([this](void *) {
+                processAppIdlePreinstall();
+            }, APP_PREINSTALL_CHECK_PERIOD_MS, this);
+            ESP_UTILS_CHECK_NULL_RETURN(_app_preinstall_timer, false, "Create app preinstall timer failed");
+        } else {
+            ESP_UTILS_CHECK_FALSE_RETURN(_app_preinstall_timer->resume(), false, "Resume app preinstall timer failed");
+        }
+    }
 
     return true;
 }
 
+void Manager::printAppInstallTimeline(void) const
+{
+    int64_t boot_us = 0;
+    int64_t deferred_us = 0;
+
+    ESP_UTILS_LOGI("App install timeline:");
+    for (auto &record : _app_install_timeline) {
+        if (record.deferred_us < 0) {
+            ESP_UTILS_LOGI("\t%s(%d): boot %d us, deferred install pending", record.name.c_str(), record.id,
+                           (int)record.boot_us);
+        } else {
+            ESP_UTILS_LOGI("\t%s(%d): boot %d us, deferred %d us", record.name.c_str(), record.id, (int)record.boot_us,
+                           (int)record.deferred_us);
+        }
+        boot_us += record.boot_us;
+        deferred_us += max(record.deferred_us, (int64_t)0);
+    }
+    ESP_UTILS_LOGI("\tTotal: boot %d us, saved at boot %d us so far", (int)boot_us, (int)deferred_us);
+}
+
+bool Manager::processAppDeferredInstall(App *app)
+{
+    lv_area_t app_visual_area = {};
+    Display &display = _system_context.getDisplay();
+
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    if (!app->_flags.is_init_deferred) {
+        return true;
+    }
+    ESP_UTILS_LOGD("Process app(%d) deferred install", app->_id);
+
+    int64_t start_us = esp_timer_get_time();
+    // Calibrate first, so that the app is still deferred if it fails and `init()` is not run twice by a retry
+    ESP_UTILS_CHECK_FALSE_RETURN(display.getAppVisualArea(app, app_visual_area), false, "Display get app visual area failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(app->setVisualArea(app_visual_area), false, "App set visual area failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(app->calibrateVisualArea(), false, "App calibrate visual area failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(app->processDeferredInit(), false, "App deferred init failed");
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+    _app_preinstall_failed_ids.erase(app->_id);
+
+    auto it = std::find_if(_app_install_timeline.begin(), _app_install_timeline.end(), [app](const AppInstallRecord & record) {
+        return record.id == app->_id;
+    });
+    if (it != _app_install_timeline.end()) {
+        it->deferred_us = elapsed_us;
+    }
+    ESP_UTILS_LOGD("App(%s: %d) deferred install done in %d us", app->getName(), app->_id, (int)elapsed_us);
+
+    return true;
+}
+
+void Manager::processAppIdlePreinstall(void)
+{
+    if (lv_display_get_inactive_time(_system_context.getDisplayDevice()) < _app_lazy_preinstall_idle_ms) {
+        return;
+    }
+
+    // One app per tick, so that a touch in the meantime is still handled quickly
+    for (auto &[id, app] : _id_installed_app_map) {
+        if (app->_flags.is_init_deferred && (_app_preinstall_failed_ids.count(id) == 0)) {
+            ESP_UTILS_LOGD("Preinstall app(%d) while idle", id);
+            if (!processAppDeferredInstall(app)) {
+                // Don't retry it on every tick, it is installed again when the user starts it
+                ESP_UTILS_LOGE("Preinstall app(%d) failed, skip it", id);
+                _app_preinstall_failed_ids.insert(id);
+            }
+            return;
+        }
+    }
+
+    // Only pause it, the timer can't be deleted from its own callback
+    ESP_UTILS_LOGD("No app left to preinstall, pause the preinstall timer");
+#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
+    printAppInstallTimeline();
+#endif
+    ESP_UTILS_CHECK_FALSE_EXIT(_app_preinstall_timer->pause(), "Pause app preinstall timer failed");
+}
+
 bool Manager::startApp(int id)
 {
     App *app = NULL;
@@ -228,19 +380,27 @@ bool Manager::startApp(int id)
     find_ret = _id_installed_app_map.find(id);
     ESP_UTILS_CHECK_FALSE_RETURN(find_ret != _id_installed_app_map.end(), false, "Can't find app in installed app map");
     app = find_ret->second;
+    ESP_UTILS_CHECK_FALSE_RETURN(processAppDeferredInstall(app), false, "Process app deferred install failed");
 
-    // Check if the running app num is at the limit
-    if ((_core_data.app.max_running_num != 0) && (int)_id_running_app_map.size() >= _core_data.app.max_running_num) {
-        for (auto it = _id_running_app_map.begin(); it != _id_running_app_map.end(); it++) {
-            app_old = it->second;
-        }
+    // Run `prepare()` on the worker thread first, `startApp()` is called again once it is done
+    if (app->getCoreActiveData().flags.enable_prepare && (_app_prepared != app)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(processAppPrepare(app), false, "Process app prepare failed");
+
+        return true;
+    }
+
+    // Check if the resident app num is at the limit, the hibernated apps only keep their saved state
+    if ((_core_data.app.max_running_num != 0) && (int)getResidentAppCount() >= _core_data.app.max_running_num) {
+        app_old = getLeastRecentlyUsedApp(app, true);
         ESP_UTILS_CHECK_NULL_RETURN(app_old, false, "Get old app failed");
 
-        ESP_UTILS_LOGW("Running app num(%d) is already at the limit, will close the oldest app(%d)",
-                       (int)_id_running_app_map.size(), app_old->_id);
+        ESP_UTILS_LOGW("Resident app num(%d) is already at the limit, will evict the oldest app(%d)",
+                       (int)getResidentAppCount(), app_old->_id);
 
-        ESP_UTILS_CHECK_FALSE_RETURN(processAppClose(app_old), false, "Close app failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(processAppEvict(app_old), false, "Evict app failed");
     }
+    // Make room before the new app allocates its resources rather than after the allocator fails
+    processMemoryPressure();
 
     // Start app
     ESP_UTILS_CHECK_FALSE_RETURN(processAppRun(app), false, "Start app failed");
@@ -248,6 +408,7 @@ bool Manager::startApp(int id)
     // Add app to running_app_map
     ESP_UTILS_CHECK_FALSE_GOTO(_id_running_app_map.insert(pair <int, App *>(id, app)).second, err,
                                "Insert app to running map failed");
+    touchRunningApp(app);
 
     return true;
 
@@ -257,11 +418,104 @@ err:
     return false;
 }
 
+bool Manager::processAppPrepare(App *app)
+{
+    lv_obj_t *screen = nullptr;
+    lv_obj_t *label = nullptr;
+
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_CHECK_FALSE_RETURN(_app_preparing == nullptr, false, "App(%d) is still preparing", _app_preparing->_id);
+    ESP_UTILS_LOGD("Process app(%d) prepare", app->_id);
+
+    // The previous worker has already posted its result, it only needs to be reaped
+    if (_app_prepare_thread.joinable()) {
+        _app_prepare_thread.join();
+    }
+
+    // Show a placeholder made of the launcher icon and the name, it is cheap enough to not delay the touch feedback
+    screen = lv_obj_create(nullptr);
+    ESP_UTILS_CHECK_NULL_RETURN(screen, false, "Create app prepare screen failed");
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(screen, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    if (app->getLauncherIcon().resource != nullptr) {
+        lv_obj_t *icon = lv_image_create(screen);
+        ESP_UTILS_CHECK_NULL_GOTO(icon, err, "Create app prepare icon failed");
+        lv_image_set_src(icon, app->getLauncherIcon().resource);
+    }
+    label = lv_label_create(screen);
+    ESP_UTILS_CHECK_NULL_GOTO(label, err, "Create app prepare label failed");
+    lv_label_set_text(label, app->getName());
+    lv_screen_load(screen);
+
+    _app_prepare_screen = screen;
+    _app_preparing = app;
+    {
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = APP_PREPARE_THREAD_NAME,
+            .stack_size = APP_PREPARE_THREAD_STACK_SIZE,
+            .stack_in_ext = APP_PREPARE_THREAD_STACK_CAPS_EXT,
+        });
+        _app_prepare_thread = boost::thread([this, app]() {
+            int64_t start_us = esp_timer_get_time();
+            bool ret = app->prepare();
+            void *param = reinterpret_cast<void *>(static_cast<uintptr_t>(ret));
+
+            ESP_UTILS_LOGI("App(%s) prepared in %d ms, result: %d", app->getName(),
+                           (int)((esp_timer_get_time() - start_us) / 1000), ret);
+
+            // Hand the result over to the GUI thread, the post queue is drained there so just retry while it is full
+            while (!_system_context.getEvent().postEvent(this, Event::ID::APP, param)) {
+                if (_app_prepare_abort.load()) {
+                    return;
+                }
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(APP_PREPARE_POST_RETRY_MS));
+            }
+        });
+    }
+
+    return true;
+
+err:
+    lv_obj_delete(screen);
+
+    return false;
+}
+
+void Manager::finishAppPrepare(bool result)
+{
+    App *app = _app_preparing;
+    lv_obj_t *screen = _app_prepare_screen;
+    Display &display = _system_context.getDisplay();
+
+    _app_preparing = nullptr;
+    _app_prepare_screen = nullptr;
+    ESP_UTILS_CHECK_FALSE_EXIT((app != nullptr) && (screen != nullptr), "No app is preparing");
+
+    if (!result) {
+        ESP_UTILS_LOGE("App(%d) prepare failed", app->_id);
+    } else if (lv_screen_active() != screen) {
+        // The user has navigated away from the placeholder, don't bring the app up behind their back
+        ESP_UTILS_LOGW("App(%d) is not started since its placeholder is not shown anymore", app->_id);
+    } else {
+        _app_prepared = app;
+        if (!startApp(app->_id)) {
+            ESP_UTILS_LOGE("Start app(%d) failed", app->_id);
+        }
+        _app_prepared = nullptr;
+    }
+
+    if ((lv_screen_active() == screen) && !display.processMainScreenLoad()) {
+        ESP_UTILS_LOGE("Display load main screen failed");
+    }
+    lv_obj_delete(screen);
+}
+
 bool Manager::processAppRun(App *app)
 {
     bool is_display_run = false;
     bool is_app_run = false;
     Display &display = _system_context.getDisplay();
+    int64_t start_us = esp_timer_get_time();
 
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
     ESP_UTILS_LOGD("Process app(%d) run", app->_id);
@@ -269,7 +523,11 @@ bool Manager::processAppRun(App *app)
     // Process display, and get the visual area of the app
     ESP_UTILS_CHECK_FALSE_RETURN(is_display_run = display.processAppRun(app), false, "Process display before app run failed");
 
-    // Process app
+    // Process app, its peak memory usage only covers this run
+    setAppMemoryOwner(app);
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    AppMemoryTracker::getInstance().resetPeak(app->_id);
+#endif
     ESP_UTILS_CHECK_FALSE_GOTO(is_app_run = app->processRun(), err, "Process app run failed");
 
     // Process extra
@@ -277,6 +535,7 @@ bool Manager::processAppRun(App *app)
 
     // Update active app
     _active_app = app;
+    updateAppLaunchLatency(_app_launch_stats.cold_start, esp_timer_get_time() - start_us);
 
     return true;
 
@@ -287,6 +546,7 @@ err:
     if (is_app_run && !app->processClose(true)) {
         ESP_UTILS_LOGE("App process close failed");
     }
+    setAppMemoryOwner(nullptr);
     ESP_UTILS_CHECK_FALSE_RETURN(display.processMainScreenLoad(), false, "Display load main screen failed");
 
     return false;
@@ -295,10 +555,14 @@ err:
 bool Manager::processAppResume(App *app)
 {
     Display &display = _system_context.getDisplay();
+    int64_t start_us = esp_timer_get_time();
+    bool is_hibernated = false;
 
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
     ESP_UTILS_LOGD("Process app(%d) resume", app->_id);
 
+    is_hibernated = (app->_status == App::Status::HIBERNATED);
+
     // Check if the screen is showing app and the app is not the active one
     if ((_active_app != nullptr) && (_active_app != app)) {
         // if so, pause the active app
@@ -308,16 +572,45 @@ bool Manager::processAppResume(App *app)
     // Process display
     ESP_UTILS_CHECK_FALSE_RETURN(display.processAppResume(app), false, "Display process resume failed");
 
-    // Process app, only load active screen if the app is not shown
-    ESP_UTILS_CHECK_FALSE_RETURN(app->processResume(), false, "App process resume failed");
+    // Process app, only load active screen if the app is not shown. A hibernated app rebuilds its resources instead
+    setAppMemoryOwner(app);
+    if (is_hibernated) {
+        ESP_UTILS_CHECK_FALSE_GOTO(app->processWake(), err, "App process wake failed");
+    } else {
+        ESP_UTILS_CHECK_FALSE_RETURN(app->processResume(), false, "App process resume failed");
+    }
 
     // Process extra
     ESP_UTILS_CHECK_FALSE_RETURN(processAppResumeExtra(app), false, "Process app resume extra failed");
 
     // Update active app
     _active_app = app;
+    touchRunningApp(app);
+    updateAppLaunchLatency(
+        is_hibernated ? _app_launch_stats.hibernate_resume : _app_launch_stats.warm_resume,
+        esp_timer_get_time() - start_us
+    );
 
     return true;
+
+err:
+    // A failed wake closes the app itself. If that failed too, clean what it rebuilt right away, since the app is
+    // dropped from the running apps and nothing would close it later
+    if ((app->_status != App::Status::CLOSED) && !app->processClose(false)) {
+        ESP_UTILS_LOGE("App process close failed");
+    }
+    setAppMemoryOwner(nullptr);
+    if (!display.processAppClose(app)) {
+        ESP_UTILS_LOGE("Display process close failed");
+    }
+    if (_core_data.flags.enable_app_save_snapshot && !releaseAppSnapshot(app)) {
+        ESP_UTILS_LOGE("Release app snapshot failed");
+    }
+    _id_running_app_map.erase(app->_id);
+    _running_app_lru.remove(app->_id);
+    ESP_UTILS_CHECK_FALSE_RETURN(display.processMainScreenLoad(), false, "Display load main screen failed");
+
+    return false;
 }
 
 bool Manager::processAppPause(App *app)
@@ -327,8 +620,9 @@ bool Manager::processAppPause(App *app)
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
     ESP_UTILS_LOGD("Process app(%d) pause", app->_id);
 
-    // Process app
+    // Process app, the allocations made from now on are not its own anymore
     ESP_UTILS_CHECK_FALSE_RETURN(app->processPause(), false, "App process pause failed");
+    setAppMemoryOwner(nullptr);
     if (_core_data.flags.enable_app_save_snapshot) {
         if (!saveAppSnapshot(app)) {
             ESP_UTILS_LOGE("Save app snapshot failed");
@@ -372,13 +666,28 @@ bool Manager::processAppClose(App *app)
 
     // Remove app from running map and update active app
     ESP_UTILS_CHECK_FALSE_RETURN(_id_running_app_map.erase(app->_id) > 0, false, "Remove app from running map failed");
+    _running_app_lru.remove(app->_id);
     if (_active_app == app) {
         _active_app = nullptr;
+        setAppMemoryOwner(nullptr);
     }
 
     return true;
 }
 
+bool Manager::processAppHibernate(App *app)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+    ESP_UTILS_CHECK_FALSE_RETURN(app != _active_app, false, "Can't hibernate the active app");
+    ESP_UTILS_LOGD("Process app(%d) hibernate", app->_id);
+
+    // The snapshot is kept, so the app still shows up in the recents screen
+    ESP_UTILS_CHECK_FALSE_RETURN(app->processHibernate(), false, "App process hibernate failed");
+    _app_launch_stats.hibernated_count++;
+
+    return true;
+}
+
 bool Manager::saveAppSnapshot(App *app)
 {
 #if !LV_USE_SNAPSHOT
@@ -387,7 +696,10 @@ bool Manager::saveAppSnapshot(App *app)
     bool resize_app_screen = false;
     lv_res_t ret = LV_RES_INV;
     lv_area_t app_screen_area = {};
+    lv_draw_buf_t *capture_buffer = nullptr;
     lv_draw_buf_t *snapshot_buffer = nullptr;
+    AppSnapshot snapshot = {};
+    int64_t start_us = esp_timer_get_time();
 
     ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
     ESP_UTILS_LOGD("Save app(%d) snapshot", app->_id);
@@ -408,31 +720,104 @@ bool Manager::saveAppSnapshot(App *app)
 
     auto it = _id_app_snapshot_map.find(app->_id);
     auto color_format = _system_context.getDisplayDevice()->color_format;
-    snapshot_buffer = (it != _id_app_snapshot_map.end()) ? it->second : nullptr;
-
-    if ((snapshot_buffer == nullptr) || (snapshot_buffer->header.w != lv_area_get_width(&app_screen_area)) ||
-            (snapshot_buffer->header.h != lv_area_get_height(&app_screen_area))) {
-        if (snapshot_buffer != nullptr) {
-            lv_draw_buf_destroy(snapshot_buffer);
+    int screen_w = lv_area_get_width(&app->_active_screen->coords);
+    int screen_h = lv_area_get_height(&app->_active_screen->coords);
+    size_t pixel_size = lv_color_format_get_size(color_format);
+    float scale = 1;
+    if ((_app_snapshot_config.width > 0) && (_app_snapshot_config.height > 0) && (pixel_size > 0)) {
+        scale = min({1.0f, (float)_app_snapshot_config.width / screen_w, (float)_app_snapshot_config.height / screen_h});
+    }
+    bool downscale = (scale < 1);
+
+    if (!downscale && !_app_snapshot_config.enable_compression) {
+        // The capture is the snapshot, reuse the previous one of the app if it has the same size
+        capture_buffer = (it != _id_app_snapshot_map.end()) ? it->second.buffer : nullptr;
+        if ((capture_buffer != nullptr) &&
+                ((capture_buffer->header.w != screen_w) || (capture_buffer->header.h != screen_h))) {
+            capture_buffer = nullptr;
+        }
+        if (capture_buffer != nullptr) {
+            it->second.buffer = nullptr;
+        } else {
+            capture_buffer = lv_snapshot_create_draw_buf(app->_active_screen, color_format);
         }
-        snapshot_buffer = lv_snapshot_create_draw_buf(app->_active_screen, color_format);
-        ESP_UTILS_CHECK_NULL_GOTO(snapshot_buffer, err, "Create snapshot buffer failed");
+    } else {
+        // Only the thumbnail or the compressed data is kept, so the full size capture is shared by all the apps
+        // instead of being allocated again on every pause
+        capture_buffer = getAppSnapshotCaptureBuffer(app->_active_screen, color_format);
     }
+    ESP_UTILS_CHECK_NULL_GOTO(capture_buffer, err, "Create snapshot buffer failed");
 
     // And take snapshot for recent screen
-    ret = lv_snapshot_take_to_draw_buf(app->_active_screen, color_format, snapshot_buffer);
+    ret = lv_snapshot_take_to_draw_buf(app->_active_screen, color_format, capture_buffer);
     ESP_UTILS_CHECK_FALSE_GOTO(ret == LV_RESULT_OK, err, "Take snapshot fail");
+    snapshot.full_size = capture_buffer->data_size;
+
+    // Only the thumbnail is kept
+    if (downscale) {
+        snapshot_buffer = lv_draw_buf_create(
+                              max(1, (int)(screen_w * scale)), max(1, (int)(screen_h * scale)), color_format, LV_STRIDE_AUTO
+                          );
+        ESP_UTILS_CHECK_NULL_GOTO(snapshot_buffer, err, "Create snapshot thumbnail buffer failed");
+        snapshot_downscale(capture_buffer, snapshot_buffer, pixel_size);
+    } else {
+        snapshot_buffer = capture_buffer;
+    }
+    capture_buffer = nullptr;
+    snapshot.header = snapshot_buffer->header;
+    snapshot.data_size = snapshot_buffer->data_size;
+
+    // Keep the compressed data only if it is actually smaller
+    if (_app_snapshot_config.enable_compression) {
+        AppSnapshotCodec::encode(
+            snapshot_buffer->data, snapshot_buffer->data_size,
+            snapshot_get_unit_size(snapshot.header, snapshot.data_size), snapshot.compressed_data
+        );
+        if (snapshot.compressed_data.size() < snapshot_buffer->data_size) {
+            snapshot.compressed_data.shrink_to_fit();
+            if (snapshot_buffer != _app_snapshot_capture_buffer) {
+                lv_draw_buf_destroy(snapshot_buffer);
+            }
+            snapshot_buffer = nullptr;
+        } else {
+            vector<uint8_t>().swap(snapshot.compressed_data);
+        }
+    }
+    // Kept uncompressed at full size, the shared capture buffer now belongs to the snapshot
+    if (snapshot_buffer == _app_snapshot_capture_buffer) {
+        _app_snapshot_capture_buffer = nullptr;
+    }
+    snapshot.buffer = snapshot_buffer;
 
-    _id_app_snapshot_map[app->_id] = snapshot_buffer;
+    if (it != _id_app_snapshot_map.end()) {
+        destroyAppSnapshot(it->second);
+        it->second = std::move(snapshot);
+    } else {
+        _id_app_snapshot_map[app->_id] = std::move(snapshot);
+    }
+    _app_snapshot_budget.update(app->_id, getAppSnapshotStoredSize(_id_app_snapshot_map[app->_id]));
     if (resize_app_screen) {
         app->_active_screen->coords = app_screen_area;
     }
 
+    _app_snapshot_last_capture_us = esp_timer_get_time() - start_us;
+    _app_snapshot_max_capture_us = max(_app_snapshot_max_capture_us, _app_snapshot_last_capture_us);
+    ESP_UTILS_LOGD(
+        "Saved app(%d) snapshot: %d -> %d bytes in %d us", app->_id, (int)_id_app_snapshot_map[app->_id].full_size,
+        (int)getAppSnapshotStoredSize(_id_app_snapshot_map[app->_id]), (int)_app_snapshot_last_capture_us
+    );
+    trimAppSnapshots(app->_id);
+
     return true;
 
 err:
-    if (snapshot_buffer != nullptr) {
-        lv_draw_buf_destroy(snapshot_buffer);
+    if ((capture_buffer != nullptr) && (capture_buffer != _app_snapshot_capture_buffer)) {
+        lv_draw_buf_destroy(capture_buffer);
+    }
+    if (it != _id_app_snapshot_map.end()) {
+        destroyAppSnapshot(it->second);
+        _id_app_snapshot_map.erase(it);
+        _app_snapshot_budget.remove(app->_id);
     }
     if (resize_app_screen) {
         app->_active_screen->coords = app_screen_area;
@@ -452,19 +837,260 @@ bool Manager::releaseAppSnapshot(App *app)
         return true;
     }
 
-    auto snapshot_buffer = it->second;
-    if (snapshot_buffer != nullptr) {
-        lv_draw_buf_destroy(snapshot_buffer);
+    destroyAppSnapshot(it->second);
+    _id_app_snapshot_map.erase(it);
+    _app_snapshot_budget.remove(app->_id);
+
+    return true;
+}
+
+void Manager::releaseAppSnapshotViews(void)
+{
+    ESP_UTILS_LOGD("Release app snapshot views");
+
+    for (auto &[id, snapshot] : _id_app_snapshot_map) {
+        if (!snapshot.compressed_data.empty() && (snapshot.buffer != nullptr)) {
+            lv_image_cache_drop(snapshot.buffer);
+            lv_draw_buf_destroy(snapshot.buffer);
+            snapshot.buffer = nullptr;
+        }
+    }
+}
+
+bool Manager::setAppSnapshotConfig(const AppSnapshotConfig &config)
+{
+    ESP_UTILS_LOGD(
+        "Set app snapshot config: size(%dx%d), budget(%d), compression(%d)", config.width, config.height,
+        (int)config.budget_bytes, config.enable_compression
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((config.width >= 0) && (config.height >= 0), false, "Invalid size");
+
+    // The stored snapshots are kept as they are, the new config applies from the next capture
+    _app_snapshot_config = config;
+    trimAppSnapshots(-1);
+    // The captures are kept as the snapshots from now on
+    if ((config.width == 0) && (config.height == 0) && !config.enable_compression &&
+            (_app_snapshot_capture_buffer != nullptr)) {
+        lv_draw_buf_destroy(_app_snapshot_capture_buffer);
+        _app_snapshot_capture_buffer = nullptr;
+    }
+
+    return true;
+}
+
+Manager::AppSnapshotStats Manager::getAppSnapshotStats(void) const
+{
+    AppSnapshotStats stats = {
+        .count = _id_app_snapshot_map.size(),
+        .stored_bytes = 0,
+        .full_bytes = 0,
+        .evicted_count = _app_snapshot_budget.getEvictedCount(),
+        .last_capture_us = _app_snapshot_last_capture_us,
+        .max_capture_us = _app_snapshot_max_capture_us,
+    };
+    for (auto &[id, snapshot] : _id_app_snapshot_map) {
+        stats.stored_bytes += getAppSnapshotStoredSize(snapshot);
+        stats.full_bytes += snapshot.full_size;
+    }
+
+    return stats;
+}
+
+void Manager::destroyAppSnapshot(AppSnapshot &snapshot)
+{
+    if (snapshot.buffer != nullptr) {
+        lv_image_cache_drop(snapshot.buffer);
+        lv_draw_buf_destroy(snapshot.buffer);
+        snapshot.buffer = nullptr;
+    }
+    vector<uint8_t>().swap(snapshot.compressed_data);
+}
+
+lv_draw_buf_t *Manager::getAppSnapshotCaptureBuffer(lv_obj_t *screen, lv_color_format_t color_format)
+{
+#if !LV_USE_SNAPSHOT
+    return nullptr;
+#else
+    lv_draw_buf_t *buffer = _app_snapshot_capture_buffer;
+    // Reshaped in place if it is still large enough for the screen
+    if ((buffer != nullptr) && (lv_snapshot_reshape_draw_buf(screen, buffer) != LV_RESULT_OK)) {
+        lv_draw_buf_destroy(buffer);
+        buffer = nullptr;
+    }
+    if (buffer == nullptr) {
+        buffer = lv_snapshot_create_draw_buf(screen, color_format);
+    }
+    _app_snapshot_capture_buffer = buffer;
+
+    return buffer;
+#endif
+}
+
+void Manager::trimAppSnapshots(int keep_id)
+{
+    for (int id : _app_snapshot_budget.trim(_app_snapshot_config.budget_bytes, keep_id)) {
+        auto it = _id_app_snapshot_map.find(id);
+        if (it != _id_app_snapshot_map.end()) {
+            destroyAppSnapshot(it->second);
+            _id_app_snapshot_map.erase(it);
+        }
+    }
+}
+
+App *Manager::getLeastRecentlyUsedApp(const App *exclude, bool resident_only)
+{
+    int exclude_id = (exclude != nullptr) ? exclude->_id : -1;
+    if (!resident_only) {
+        return getRunningAppById(_running_app_lru.getLeastRecentlyUsed(exclude_id));
+    }
+
+    return getRunningAppById(_running_app_lru.getLeastRecentlyUsed(exclude_id, [this](int id) {
+        return !checkRunningAppHibernated(id);
+    }));
+}
+
+bool Manager::setMemoryWatermark(const MemoryWatermark &watermark)
+{
+    ESP_UTILS_LOGD(
+        "Set memory watermark: sram(%d), psram(%d), largest block(%d)", (int)watermark.sram_free_bytes,
+        (int)watermark.psram_free_bytes, (int)watermark.largest_free_block_bytes
+    );
+
+    _memory_watermark = watermark;
+    if (_memory_check_timer != nullptr) {
+        processMemoryPressure();
+    }
+
+    return true;
+}
+
+bool Manager::checkMemoryBelowWatermark(void) const
+{
+    if ((_memory_watermark.sram_free_bytes > 0) &&
+            (heap_caps_get_free_size(MALLOC_CAP_INTERNAL) < _memory_watermark.sram_free_bytes)) {
+        return true;
+    }
+    // Boards without PSRAM report 0 free bytes, so only check it when it exists
+    if ((_memory_watermark.psram_free_bytes > 0) && (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) &&
+            (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < _memory_watermark.psram_free_bytes)) {
+        return true;
+    }
+    if ((_memory_watermark.largest_free_block_bytes > 0) &&
+            (heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT) < _memory_watermark.largest_free_block_bytes)) {
+        return true;
+    }
+
+    return false;
+}
+
+bool Manager::getAppMemoryUsage(int id, AppMemoryTracker::Usage &usage) const
+{
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    return AppMemoryTracker::getInstance().getUsage(id, usage);
+#else
+    return false;
+#endif
+}
+
+void Manager::touchRunningApp(App *app)
+{
+    _running_app_lru.touch(app->_id);
+}
+
+void Manager::setAppMemoryOwner(App *app)
+{
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    // Only the allocations of the GUI thread are charged, which is the thread calling this
+    AppMemoryTracker::getInstance().setOwner((app != nullptr) ? app->_id : -1);
+#endif
+}
+
+void Manager::processMemoryPressure(void)
+{
+    // The order is kept by `AppLru::getEvictionCandidate()`: never the active app, the resident apps first
+    auto is_hibernated = [this](int id) {
+        return checkRunningAppHibernated(id);
+    };
+    int active_id = (_active_app != nullptr) ? _active_app->_id : -1;
+    App *app = nullptr;
+    while (checkMemoryBelowWatermark() &&
+            ((app = getRunningAppById(_running_app_lru.getEvictionCandidate(active_id, is_hibernated))) != nullptr)) {
+        ESP_UTILS_LOGW(
+            "Memory below watermark (sram: %d, psram: %d, largest block: %d), evict the least recently used app(%d)",
+            (int)heap_caps_get_free_size(MALLOC_CAP_INTERNAL), (int)heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+            (int)heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT), app->_id
+        );
+        ESP_UTILS_CHECK_FALSE_EXIT(processAppEvict(app), "Evict app(%d) failed", app->_id);
     }
-    ESP_UTILS_CHECK_FALSE_RETURN(_id_app_snapshot_map.erase(app->_id) > 0, false, "Free snapshot failed");
+}
+
+bool Manager::processAppEvict(App *app)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(app, false, "Invalid app");
+
+    // Hibernate the app if it supports it, so that it can be resumed without losing its state
+    const App::Config &config = app->getCoreActiveData();
+    if ((app->_status == App::Status::PAUSED) && (app != _active_app) && config.flags.enable_hibernate &&
+            config.flags.enable_recycle_resource) {
+        if (processAppHibernate(app)) {
+            return true;
+        }
+        ESP_UTILS_LOGW("Hibernate app(%d) failed, close it instead", app->_id);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(processAppClose(app), false, "Close app(%d) failed", app->_id);
 
     return true;
 }
 
+bool Manager::checkRunningAppHibernated(int id) const
+{
+    auto it = _id_running_app_map.find(id);
+
+    return (it != _id_running_app_map.end()) && (it->second->_status == App::Status::HIBERNATED);
+}
+
+uint8_t Manager::getResidentAppCount(void) const
+{
+    uint8_t count = 0;
+    for (auto &[id, app] : _id_running_app_map) {
+        if (app->_status != App::Status::HIBERNATED) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void Manager::updateAppLaunchLatency(AppLaunchLatency &latency, int64_t elapsed_us)
+{
+    latency.count++;
+    latency.total_us += elapsed_us;
+    latency.max_us = max(latency.max_us, elapsed_us);
+}
+
+void Manager::printAppLaunchStats(void) const
+{
+    auto print_latency = [](const char *name, const AppLaunchLatency &latency) {
+        if (latency.count == 0) {
+            ESP_UTILS_LOGI("\t%s: none", name);
+            return;
+        }
+        ESP_UTILS_LOGI("\t%s: %d times, avg %d us, max %d us", name, (int)latency.count,
+                       (int)(latency.total_us / (int64_t)latency.count), (int)latency.max_us);
+    };
+
+    ESP_UTILS_LOGI("App launch latency:");
+    print_latency("Cold start", _app_launch_stats.cold_start);
+    print_latency("Warm resume", _app_launch_stats.warm_resume);
+    print_latency("Hibernate resume", _app_launch_stats.hibernate_resume);
+    ESP_UTILS_LOGI("\tHibernated: %d times", (int)_app_launch_stats.hibernated_count);
+}
+
 void Manager::resetActiveApp(void)
 {
     ESP_UTILS_LOGD("Reset active app");
     _active_app = nullptr;
+    setAppMemoryOwner(nullptr);
 }
 
 int Manager::getRunningAppIndexByApp(App *app)
@@ -525,9 +1151,32 @@ App *Manager::getRunningAppById(int id)
 const lv_draw_buf_t *Manager::getAppSnapshot(int id)
 {
     auto it = _id_app_snapshot_map.find(id);
-    ESP_UTILS_CHECK_FALSE_RETURN(it != _id_app_snapshot_map.end(), nullptr, "App snapshot not found");
+    if (it == _id_app_snapshot_map.end()) {
+        // Not captured yet or evicted, the caller falls back to the app icon
+        ESP_UTILS_LOGD("App(%d) snapshot not found", id);
+        return nullptr;
+    }
 
-    return it->second;
+    auto &snapshot = it->second;
+    if (snapshot.buffer == nullptr) {
+        snapshot.buffer = lv_draw_buf_create(
+                              snapshot.header.w, snapshot.header.h, static_cast<lv_color_format_t>(snapshot.header.cf),
+                              snapshot.header.stride
+                          );
+        ESP_UTILS_CHECK_NULL_RETURN(snapshot.buffer, nullptr, "Create snapshot buffer failed");
+        if (!AppSnapshotCodec::decode(
+                    snapshot.compressed_data, snapshot_get_unit_size(snapshot.header, snapshot.data_size),
+                    snapshot.buffer->data, snapshot.buffer->data_size
+                )) {
+            ESP_UTILS_LOGE("Decode app(%d) snapshot failed", id);
+            lv_draw_buf_destroy(snapshot.buffer);
+            snapshot.buffer = nullptr;
+            return nullptr;
+        }
+    }
+    _app_snapshot_budget.touch(id);
+
+    return snapshot.buffer;
 }
 
 bool Manager::begin(void)
@@ -538,6 +1187,25 @@ bool Manager::begin(void)
                                  "Register app event failed");
     ESP_UTILS_CHECK_FALSE_GOTO(_system_context.registerNavigateEventCallback(onNavigationEventCallback, this), err,
                                "Register navigation event failed");
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        _system_context.getEvent().registerEvent(this, onAppPreparedEventHandler, Event::ID::APP, this), err,
+        "Register app prepared event failed"
+    );
+
+    _memory_check_timer = std::make_unique<LvTimer>([this](void *) {
+        processMemoryPressure();
+    }, ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS, this);
+    ESP_UTILS_CHECK_NULL_GOTO(_memory_check_timer, err, "Create memory check timer failed");
+
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    // Shared by all the systems, only the first one creates the table
+    if (!AppMemoryTracker::getInstance().checkInitialized()) {
+        ESP_UTILS_CHECK_FALSE_GOTO(
+            AppMemoryTracker::getInstance().begin(ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY), err,
+            "Begin app memory tracker failed"
+        );
+    }
+#endif
 
     return true;
 
@@ -561,8 +1229,25 @@ bool Manager::del(void)
         }
     }
 
+    // Wait for the worker since it still uses the app, its result is dropped with the handler
+    _app_prepare_abort = true;
+    if (_app_prepare_thread.joinable()) {
+        _app_prepare_thread.join();
+    }
+    _app_prepare_abort = false;
+    _system_context.getEvent().unregisterEvent(this, onAppPreparedEventHandler, Event::ID::APP);
+    if (_app_prepare_screen != nullptr) {
+        lv_obj_delete(_app_prepare_screen);
+        _app_prepare_screen = nullptr;
+    }
+    _app_preparing = nullptr;
+    _memory_check_timer.reset();
+    _app_preinstall_timer.reset();
+    _app_preinstall_failed_ids.clear();
+    _app_install_timeline.clear();
     _app_free_id = 0;
     _active_app = nullptr;
+    setAppMemoryOwner(nullptr);
     for (auto app : id_installed_app_map) {
         if (!uninstallApp(app.second)) {
             ESP_UTILS_LOGE("Uninstall app(%d) failed", app.second->_id);
@@ -571,7 +1256,17 @@ bool Manager::del(void)
     }
     _id_installed_app_map.clear();
     _id_running_app_map.clear();
+    _running_app_lru.clear();
+    _app_launch_stats = {};
+    for (auto &[id, snapshot] : _id_app_snapshot_map) {
+        destroyAppSnapshot(snapshot);
+    }
     _id_app_snapshot_map.clear();
+    _app_snapshot_budget.clear();
+    if (_app_snapshot_capture_buffer != nullptr) {
+        lv_draw_buf_destroy(_app_snapshot_capture_buffer);
+        _app_snapshot_capture_buffer = nullptr;
+    }
 
     return ret;
 }
@@ -609,6 +1304,17 @@ void Manager::onAppEventCallback(lv_event_t *event)
     }
 }
 
+bool Manager::onAppPreparedEventHandler(const Event::HandlerData &data)
+{
+    Manager *manager = static_cast<Manager *>(data.user_data);
+
+    ESP_UTILS_CHECK_NULL_RETURN(manager, false, "Invalid manager object");
+
+    manager->finishAppPrepare(reinterpret_cast<uintptr_t>(data.param) != 0);
+
+    return true;
+}
+
 void Manager::onNavigationEventCallback(lv_event_t *event)
 {
     void *param = nullptr;
@@ -5,11 +5,21 @@
  */
 #pragma once
 
+#include <atomic>
 #include <tuple>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include "boost/thread.hpp"
+#include "esp_brookesia_systems_internal.h"
 #include "lvgl/esp_brookesia_lv_helper.hpp"
 #include "esp_brookesia_base_app.hpp"
+#include "esp_brookesia_base_app_lru.hpp"
+#include "esp_brookesia_base_app_memory.hpp"
+#include "esp_brookesia_base_app_snapshot.hpp"
+#include "esp_brookesia_base_event.hpp"
 #include "esp_brookesia_base_display.hpp"
 
 namespace esp_brookesia::systems::base {
@@ -38,6 +48,56 @@ public:
 
     using RegistryAppInfo = std::tuple<std::string, std::shared_ptr<App>>;
 
+    /**
+     * @brief Storage policy of the app snapshots, which are only used as the thumbnails of the recents screen. With a
+     *        thumbnail size or the compression, one full size capture buffer is kept and shared by all the captures.
+     */
+    struct AppSnapshotConfig {
+        int width;                  // Snapshots are downscaled to fit this size, `0` keeps the screen size
+        int height;
+        size_t budget_bytes;        // The least recently viewed snapshots are evicted above it, `0` means no limit
+        bool enable_compression;    // Keep the snapshots RLE compressed and decode them only while they are viewed
+    };
+
+    /**
+     * @brief Background apps are closed from the least recently used one while the memory is below any of these, a
+     *        value of `0` disables the corresponding check
+     */
+    struct MemoryWatermark {
+        size_t sram_free_bytes;
+        size_t psram_free_bytes;
+        size_t largest_free_block_bytes;
+    };
+
+    struct AppInstallRecord {
+        std::string name;
+        int id;
+        int64_t boot_us;            // Time spent in `installAppFromRegistry()`
+        int64_t deferred_us;        // Time moved out of the boot by the lazy install, `-1` while still pending
+    };
+
+    struct AppLaunchLatency {
+        size_t count;
+        int64_t total_us;
+        int64_t max_us;
+    };
+
+    struct AppLaunchStats {
+        AppLaunchLatency cold_start;        // Run of a closed app
+        AppLaunchLatency warm_resume;       // Resume of a paused app whose resources are still resident
+        AppLaunchLatency hibernate_resume;  // Resume of a hibernated app, which rebuilds its UI and restores its state
+        size_t hibernated_count;
+    };
+
+    struct AppSnapshotStats {
+        size_t count;
+        size_t stored_bytes;        // Memory used by the stored snapshots, including the decoded ones
+        size_t full_bytes;          // Memory the same snapshots would take at screen size without compression
+        size_t evicted_count;
+        int64_t last_capture_us;
+        int64_t max_capture_us;
+    };
+
     Manager(Context &core, const Data &data);
     ~Manager();
 
@@ -49,6 +109,28 @@ public:
 
     bool initAppFromRegistry(std::vector<RegistryAppInfo> &app_infos);
     bool installAppFromRegistry(std::vector<RegistryAppInfo> &app_infos, std::vector<std::string> *ordered_app_names = nullptr);
+    /**
+     * @brief Let `installAppFromRegistry()` only add the launcher icons. `App::init()` and the visual area calibration
+     *        run on the first start of each app, or once the user is idle for `preinstall_idle_ms` (`0` disables it).
+     */
+    void setAppLazyInstallEnabled(bool enabled, uint32_t preinstall_idle_ms = 0)
+    {
+        _app_lazy_install_enabled = enabled;
+        _app_lazy_preinstall_idle_ms = preinstall_idle_ms;
+    }
+    bool isAppLazyInstallEnabled(void) const
+    {
+        return _app_lazy_install_enabled;
+    }
+    const std::vector<AppInstallRecord> &getAppInstallTimeline(void) const
+    {
+        return _app_install_timeline;
+    }
+    /**
+     * @brief Print the install time of each app. It is printed automatically at boot and once every app is preinstalled
+     *        only when the debug log level is enabled.
+     */
+    void printAppInstallTimeline(void) const;
 
     bool checkAppID_Valid(int id)
     {
@@ -62,6 +144,10 @@ public:
     {
         return _id_running_app_map.size();
     }
+    /**
+     * @brief Get the number of running apps which are not hibernated, this is the number limited by `max_running_num`
+     */
+    uint8_t getResidentAppCount(void) const;
     int getRunningAppIndexByApp(App *app);
     int getRunningAppIndexById(int id);
     App *getInstalledApp(int id);
@@ -71,7 +157,52 @@ public:
     {
         return _active_app;
     }
+    /**
+     * @brief Get the app whose `prepare()` is running on the worker thread, `nullptr` if there is none
+     */
+    App *getPreparingApp(void) const
+    {
+        return _app_preparing;
+    }
+    /**
+     * @brief Get the running app which has not been run or resumed for the longest time
+     *
+     * @param exclude App to skip, such as the one about to be started
+     * @param resident_only Skip the hibernated apps
+     */
+    App *getLeastRecentlyUsedApp(const App *exclude = nullptr, bool resident_only = false);
+    bool setMemoryWatermark(const MemoryWatermark &watermark);
+    const MemoryWatermark &getMemoryWatermark(void) const
+    {
+        return _memory_watermark;
+    }
+    bool checkMemoryBelowWatermark(void) const;
+    /**
+     * @brief Get the heap usage attributed to an app, see `ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION`
+     *
+     * @return `false` if the attribution is disabled or the app has never been attributed any allocation
+     */
+    bool getAppMemoryUsage(int id, AppMemoryTracker::Usage &usage) const;
+    /**
+     * @brief Get the snapshot of an app, decoding it if it is compressed. The buffer stays valid until the snapshot is
+     *        saved again, released or evicted, or until `releaseAppSnapshotViews()` is called.
+     */
     const lv_draw_buf_t *getAppSnapshot(int id);
+    bool setAppSnapshotConfig(const AppSnapshotConfig &config);
+    const AppSnapshotConfig &getAppSnapshotConfig(void) const
+    {
+        return _app_snapshot_config;
+    }
+    AppSnapshotStats getAppSnapshotStats(void) const;
+    const AppLaunchStats &getAppLaunchStats(void) const
+    {
+        return _app_launch_stats;
+    }
+    void printAppLaunchStats(void) const;
+    /**
+     * @brief Drop the decoded buffers of the compressed snapshots, should be called once they are not shown anymore
+     */
+    void releaseAppSnapshotViews(void);
 
 protected:
     virtual bool processAppRunExtra(App *app)
@@ -99,6 +230,7 @@ protected:
     bool processAppResume(App *app);
     bool processAppPause(App *app);
     bool processAppClose(App *app);
+    bool processAppHibernate(App *app);
     bool saveAppSnapshot(App *app);
     bool releaseAppSnapshot(App *app);
     void resetActiveApp(void);
@@ -111,14 +243,66 @@ private:
     bool del(void);
     bool startApp(int id);
 
+    struct AppSnapshot {
+        lv_draw_buf_t *buffer = nullptr;        // `nullptr` while only the compressed data is kept
+        std::vector<uint8_t> compressed_data;
+        lv_image_header_t header = {};
+        size_t data_size = 0;
+        size_t full_size = 0;
+    };
+
+    static size_t getAppSnapshotStoredSize(const AppSnapshot &snapshot)
+    {
+        return snapshot.compressed_data.size() + ((snapshot.buffer != nullptr) ? snapshot.buffer->data_size : 0);
+    }
+    int processAppInstall(App *app, bool is_lazy);
+    bool processAppDeferredInstall(App *app);
+    bool processAppPrepare(App *app);
+    void finishAppPrepare(bool result);
+    void processAppIdlePreinstall(void);
+    void touchRunningApp(App *app);
+    void setAppMemoryOwner(App *app);
+    void processMemoryPressure(void);
+    bool processAppEvict(App *app);
+    bool checkRunningAppHibernated(int id) const;
+    static void updateAppLaunchLatency(AppLaunchLatency &latency, int64_t elapsed_us);
+    lv_draw_buf_t *getAppSnapshotCaptureBuffer(lv_obj_t *screen, lv_color_format_t color_format);
+    void destroyAppSnapshot(AppSnapshot &snapshot);
+    void trimAppSnapshots(int keep_id);
+
     static void onAppEventCallback(lv_event_t *event);
     static void onNavigationEventCallback(lv_event_t *event);
+    static bool onAppPreparedEventHandler(const Event::HandlerData &data);
 
     uint32_t _app_free_id{App::APP_ID_MIN};
     App *_active_app{nullptr};
     std::unordered_map <int, App *> _id_installed_app_map;
     std::unordered_map <int, App *> _id_running_app_map;
-    std::unordered_map <int, lv_draw_buf_t *> _id_app_snapshot_map;
+    AppLru _running_app_lru;
+    // Lazy install
+    bool _app_lazy_install_enabled{ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL};
+    uint32_t _app_lazy_preinstall_idle_ms{ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS};
+    gui::LvTimerUniquePtr _app_preinstall_timer;
+    std::unordered_set<int> _app_preinstall_failed_ids;    // Skipped by the idle preinstall, retried on start
+    std::vector<AppInstallRecord> _app_install_timeline;
+    // Prepare
+    boost::thread _app_prepare_thread;
+    std::atomic<bool> _app_prepare_abort{false};
+    App *_app_preparing{nullptr};
+    App *_app_prepared{nullptr};            // Set while `startApp()` runs the app whose preparation is done
+    lv_obj_t *_app_prepare_screen{nullptr};
+    // Hibernation
+    AppLaunchStats _app_launch_stats{};
+    // Memory
+    MemoryWatermark _memory_watermark;
+    gui::LvTimerUniquePtr _memory_check_timer;
+    // Snapshot
+    std::unordered_map <int, AppSnapshot> _id_app_snapshot_map;
+    AppSnapshotConfig _app_snapshot_config;
+    AppSnapshotBudget _app_snapshot_budget;
+    lv_draw_buf_t *_app_snapshot_capture_buffer{nullptr};  // Reused by the captures which are not kept as they are
+    int64_t _app_snapshot_last_capture_us{0};
+    int64_t _app_snapshot_max_capture_us{0};
     // Navigation
     NavigateType _navigate_type{NavigateType::MAX};
 };
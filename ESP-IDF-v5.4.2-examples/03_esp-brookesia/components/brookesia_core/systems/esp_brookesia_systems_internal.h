@@ -22,6 +22,142 @@
 #   endif
 #endif
 
+#if !defined(ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE)
+#       define ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE  CONFIG_ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE
+#   else
+#       define ESP_BROOKESIA_BASE_EVENT_POST_QUEUE_SIZE  (64)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING)
+#       define ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING  CONFIG_ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+#   else
+#       define ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE)
+#       define ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE  CONFIG_ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE
+#   else
+#       define ESP_BROOKESIA_BASE_CONTEXT_ENABLE_DATA_UPDATE_COALESCE  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB)
+#       define ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB  CONFIG_ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_BUDGET_KB  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION)
+#       define ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION  CONFIG_ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_SNAPSHOT_ENABLE_COMPRESSION  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL)
+#       define ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL  CONFIG_ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_ENABLE_LAZY_APP_INSTALL  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS)
+#       define ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS  CONFIG_ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_LAZY_APP_PREINSTALL_IDLE_MS  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB)
+#       define ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB  CONFIG_ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_SRAM_WATERMARK_KB  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB)
+#       define ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB  CONFIG_ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_PSRAM_WATERMARK_KB  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB)
+#       define ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB  CONFIG_ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_LARGEST_BLOCK_WATERMARK_KB  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS)
+#       define ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS  CONFIG_ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS
+#   else
+#       define ESP_BROOKESIA_BASE_MANAGER_MEMORY_CHECK_PERIOD_MS  (1000)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION)
+#       define ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION  CONFIG_ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+#   else
+#       define ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY)
+#       define ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY  CONFIG_ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY
+#   else
+#       define ESP_BROOKESIA_BASE_APP_MEMORY_ATTRIBUTION_CAPACITY  (4096)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR)
+#       define ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR  CONFIG_ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+#   else
+#       define ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR  (0)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS)
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS  CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS
+#   else
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_TARGET_FPS  (30)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM)
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM  CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM
+#   else
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_SAMPLE_NUM  (128)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS)
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS  CONFIG_ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS
+#   else
+#       define ESP_BROOKESIA_BASE_DISPLAY_PERF_LOG_INTERVAL_MS  (10000)
+#   endif
+#endif
+
 #if ESP_BROOKESIA_BASE_ENABLE_DEBUG_LOG
 #   if !defined(ESP_BROOKESIA_BASE_APP_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_BASE_APP_ENABLE_DEBUG_LOG)
@@ -147,6 +283,23 @@
 #   endif
 #endif
 
+#if ESP_BROOKESIA_SYSTEMS_ENABLE_PHONE
+#   if !defined(ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH)
+#       if defined(CONFIG_ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH)
+#           define ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH  CONFIG_ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH
+#       else
+#           define ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH  (0)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT)
+#       if defined(CONFIG_ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT)
+#           define ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT  CONFIG_ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT
+#       else
+#           define ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT  (0)
+#       endif
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////// Speaker //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
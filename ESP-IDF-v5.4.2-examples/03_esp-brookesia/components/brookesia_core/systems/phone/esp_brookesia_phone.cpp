@@ -4,11 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <algorithm>
+#include "esp_timer.h"
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_PHONE_PHONE_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_phone_utils.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "stylesheets/esp_brookesia_phone_stylesheets.hpp"
 #include "esp_brookesia_phone.hpp"
 
@@ -42,8 +44,18 @@ bool Phone::begin(void)
     StyleSize display_size = {};
 
     ESP_UTILS_LOGD("Begin phone(@0x%p)", this);
+    ESP_BROOKESIA_TRACE_SCOPE("Phone::begin");
     ESP_UTILS_CHECK_FALSE_RETURN(!checkCoreInitialized(), false, "Already initialized");
 
+    if constexpr (checkFixedScreenEnabled()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(getDisplaySize(display_size), false, "Get display size failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (display_size.width == FIXED_SCREEN_WIDTH) && (display_size.height == FIXED_SCREEN_HEIGHT), false,
+            "Display size(%dx%d) doesn't match the fixed screen size(%dx%d)", display_size.width, display_size.height,
+            FIXED_SCREEN_WIDTH, FIXED_SCREEN_HEIGHT
+        );
+    }
+
     // Check if any phone stylesheet is added, if not, add default stylesheet
     if (getStylesheetCount() == 0) {
         ESP_UTILS_LOGW("No phone stylesheet is added, adding default dark stylesheet(%s)",
@@ -127,6 +139,13 @@ bool Phone::addStylesheet(const Stylesheet &stylesheet)
 {
     ESP_UTILS_LOGD("Add phone(0x%p) stylesheet", this);
 
+    // Don't copy and calibrate a stylesheet which can never be activated
+    if (!checkFixedScreenStylesheet(stylesheet)) {
+        ESP_UTILS_LOGW("Stylesheet(%s) is not for the fixed screen size(%dx%d), skip it", stylesheet.core.name,
+                       FIXED_SCREEN_WIDTH, FIXED_SCREEN_HEIGHT);
+        return true;
+    }
+
     ESP_UTILS_CHECK_FALSE_RETURN(
         StylesheetManager::addStylesheet(stylesheet.core.name, stylesheet.core.screen_size, stylesheet),
         false, "Failed to add phone stylesheet"
@@ -148,12 +167,17 @@ bool Phone::activateStylesheet(const Stylesheet &stylesheet)
 {
     ESP_UTILS_LOGD("Activate phone(0x%p) stylesheet", this);
 
+    int64_t start_us = esp_timer_get_time();
+    _stylesheet_changed_ranges.clear();
     ESP_UTILS_CHECK_FALSE_RETURN(
         StylesheetManager::activateStylesheet(stylesheet.core.name, stylesheet.core.screen_size),
         false, "Failed to activate phone stylesheet"
     );
+    ESP_UTILS_LOGD("Activate stylesheet(%s) in %d us", stylesheet.core.name,
+                   static_cast<int>(esp_timer_get_time() - start_us));
 
-    if (checkCoreInitialized() && !sendDataUpdateEvent()) {
+    // Only the widgets whose data changed are updated
+    if (checkCoreInitialized() && !sendDataUpdateEvent(_stylesheet_changed_ranges)) {
         ESP_UTILS_LOGE("Send update data event failed");
     }
 
@@ -188,12 +212,55 @@ bool Phone::calibrateStylesheet(const gui::StyleSize &screen_size, Stylesheet &s
     return true;
 }
 
+bool Phone::updateActiveStylesheet(const Stylesheet &stylesheet)
+{
+    ESP_UTILS_LOGD("Update phone(0x%p) active stylesheet", this);
+
+    // The widgets keep references to these sections, so they are updated in place
+    updateActiveStylesheetSection(_active_stylesheet.core, stylesheet.core);
+    updateActiveStylesheetSection(_active_stylesheet.display.status_bar, stylesheet.display.status_bar);
+    updateActiveStylesheetSection(_active_stylesheet.display.navigation_bar, stylesheet.display.navigation_bar);
+    updateActiveStylesheetSection(_active_stylesheet.display.app_launcher, stylesheet.display.app_launcher);
+    updateActiveStylesheetSection(_active_stylesheet.display.recents_screen, stylesheet.display.recents_screen);
+    updateActiveStylesheetSection(_active_stylesheet.display.flags, stylesheet.display.flags);
+    updateActiveStylesheetSection(_active_stylesheet.manager, stylesheet.manager);
+    ESP_UTILS_LOGD("Changed ranges: %d", static_cast<int>(_stylesheet_changed_ranges.size()));
+
+    return true;
+}
+
+void Phone::recordStylesheetChangedRanges(const void *active, const void *source, size_t size)
+{
+    const uint8_t *active_bytes = static_cast<const uint8_t *>(active);
+    const uint8_t *source_bytes = static_cast<const uint8_t *>(source);
+
+    // Record each run of changed bytes rather than the whole section, so the widgets can tell which parts of their data
+    // changed
+    size_t i = 0;
+    while (i < size) {
+        if (active_bytes[i] == source_bytes[i]) {
+            i++;
+            continue;
+        }
+        size_t begin = i;
+        while ((i < size) && (active_bytes[i] != source_bytes[i])) {
+            i++;
+        }
+        _stylesheet_changed_ranges.push_back({active_bytes + begin, i - begin});
+    }
+}
+
 bool Phone::calibrateScreenSize(gui::StyleSize &size)
 {
     ESP_UTILS_LOGD("Calibrate phone(0x%p) screen size", this);
 
     gui::StyleSize display_size = {};
-    ESP_UTILS_CHECK_FALSE_RETURN(getDisplaySize(display_size), false, "Get display size failed");
+    if constexpr (checkFixedScreenEnabled()) {
+        display_size.width = FIXED_SCREEN_WIDTH;
+        display_size.height = FIXED_SCREEN_HEIGHT;
+    } else {
+        ESP_UTILS_CHECK_FALSE_RETURN(getDisplaySize(display_size), false, "Get display size failed");
+    }
     ESP_UTILS_CHECK_FALSE_RETURN(base::Context::getDisplay().calibrateCoreObjectSize(display_size, size), false, "Invalid screen size");
 
     return true;
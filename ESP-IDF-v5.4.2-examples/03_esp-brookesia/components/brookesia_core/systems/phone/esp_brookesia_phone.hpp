@@ -5,8 +5,11 @@
  */
 #pragma once
 
+#include <cstring>
 #include <list>
 #include <memory>
+#include <type_traits>
+#include <vector>
 #include "esp_brookesia_systems_internal.h"
 #include "gui/style/esp_brookesia_gui_stylesheet_manager.hpp"
 #include "esp_brookesia_phone_display.hpp"
@@ -25,6 +28,9 @@ using StylesheetManager = gui::StylesheetManager<Stylesheet>;
 
 class Phone: public base::Context, public StylesheetManager {
 public:
+    static constexpr int FIXED_SCREEN_WIDTH = ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH;
+    static constexpr int FIXED_SCREEN_HEIGHT = ESP_BROOKESIA_PHONE_FIXED_SCREEN_HEIGHT;
+
     Phone(lv_display_t *display = nullptr);
     ~Phone();
 
@@ -49,6 +55,27 @@ public:
 
     bool calibrateScreenSize(gui::StyleSize &size) override;
 
+    static constexpr bool checkFixedScreenEnabled(void)
+    {
+        return (FIXED_SCREEN_WIDTH > 0) && (FIXED_SCREEN_HEIGHT > 0);
+    }
+    /**
+     * @brief Check if a stylesheet is meant for the fixed screen, always `true` if there is none. It can be evaluated
+     *        at build time, e.g. `static_assert(Phone::checkFixedScreenStylesheet(STYLESHEET_410_502_DARK))`
+     */
+    static constexpr bool checkFixedScreenStylesheet(const Stylesheet &stylesheet)
+    {
+        if (!checkFixedScreenEnabled()) {
+            return true;
+        }
+
+        const gui::StyleSize &size = stylesheet.core.screen_size;
+        int width = size.flags.enable_width_percent ? (FIXED_SCREEN_WIDTH * size.width_percent / 100) : size.width;
+        int height = size.flags.enable_height_percent ? (FIXED_SCREEN_HEIGHT * size.height_percent / 100) : size.height;
+
+        return (width == FIXED_SCREEN_WIDTH) && (height == FIXED_SCREEN_HEIGHT);
+    }
+
     Display &getDisplay(void)
     {
         return _display;
@@ -60,9 +87,23 @@ public:
 
 private:
     bool calibrateStylesheet(const gui::StyleSize &screen_size, Stylesheet &sheetstyle) override;
+    bool updateActiveStylesheet(const Stylesheet &stylesheet) override;
+
+    template <typename D>
+    void updateActiveStylesheetSection(D &active, const D &source)
+    {
+        static_assert(std::is_trivially_copyable_v<D>, "Stylesheet sections are compared and copied bytewise");
+        if (std::memcmp(&active, &source, sizeof(D)) == 0) {
+            return;
+        }
+        recordStylesheetChangedRanges(&active, &source, sizeof(D));
+        std::memcpy(&active, &source, sizeof(D));
+    }
+    void recordStylesheetChangedRanges(const void *active, const void *source, size_t size);
 
     Display _display;
     Manager _manager;
+    std::vector<base::Context::DataUpdateRange> _stylesheet_changed_ranges;
 
     static const Stylesheet _default_stylesheet_dark;
 };
@@ -321,6 +321,20 @@ bool Display::getAppVisualArea(base::App *app, lv_area_t &app_visual_area) const
     return true;
 }
 
+base::DisplayPerfMonitor::Scene Display::getPerfScene(void) const
+{
+    if ((_recents_screen != nullptr) && _recents_screen->checkInitialized() && _recents_screen->checkVisible()) {
+        return {base::DisplayPerfMonitor::SceneType::RECENTS, -1};
+    }
+
+    base::DisplayPerfMonitor::Scene scene = base::Display::getPerfScene();
+    if (scene.type == base::DisplayPerfMonitor::SceneType::MAIN) {
+        scene.index = _app_launcher.getActiveScreenIndex();
+    }
+
+    return scene;
+}
+
 bool Display::processRecentsScreenShow(void)
 {
     ESP_UTILS_LOGD("Process when show recents_screen");
@@ -87,6 +87,7 @@ private:
     bool processAppClose(base::App *app) override;
     bool processMainScreenLoad(void) override;
     bool getAppVisualArea(base::App *app, lv_area_t &app_visual_area) const override;
+    base::DisplayPerfMonitor::Scene getPerfScene(void) const override;
 
     bool processRecentsScreenShow(void);
 
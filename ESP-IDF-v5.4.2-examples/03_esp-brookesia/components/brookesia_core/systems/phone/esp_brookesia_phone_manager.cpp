@@ -124,6 +124,12 @@ bool Manager::begin(void)
         _recents_screen_drag_tan_threshold = tan(data.recents_screen.drag_snapshot_angle_threshold * M_PI / 180);
         lv_obj_add_event_cb(recents_screen->getEventObject(), onRecentsScreenSnapshotDeletedEventCallback,
                             recents_screen->getSnapshotDeletedEventCode(), this);
+        // The snapshots are only shown as thumbnails, so there is no need to keep them at the screen size
+        auto snapshot_config = getAppSnapshotConfig();
+        const auto &snapshot_image_size = display.getData().recents_screen.data.snapshot_table.snapshot.image.main_size;
+        snapshot_config.width = snapshot_image_size.width;
+        snapshot_config.height = snapshot_image_size.height;
+        ESP_UTILS_CHECK_FALSE_RETURN(setAppSnapshotConfig(snapshot_config), false, "Set app snapshot config failed");
         // Register gesture event
         if (gesture != nullptr) {
             ESP_UTILS_LOGD("Enable recents_screen gesture");
@@ -631,6 +637,14 @@ bool Manager::processNavigationEvent(base::Manager::NavigateType type)
                                        end, "base::App update snapshot(%d) conf failed", phone_app->getId());
             ESP_UTILS_CHECK_FALSE_GOTO(ret = recents_screen->updateSnapshotImage(phone_app->getId()), end,
                                        "Recents screen update snapshot(%d) image failed", phone_app->getId());
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+            // Not an error if the app has never been attributed any allocation
+            base::AppMemoryTracker::Usage memory_usage;
+            if (getAppMemoryUsage(phone_app->getId(), memory_usage) &&
+                    !recents_screen->setSnapshotMemoryUsage(phone_app->getId(), memory_usage)) {
+                ESP_UTILS_LOGE("Recents screen set snapshot(%d) memory usage failed", phone_app->getId());
+            }
+#endif
         }
         break;
     default:
@@ -856,6 +870,7 @@ bool Manager::processRecentsScreenHide(void)
     ESP_UTILS_LOGD("Process recents_screen hide");
     ESP_UTILS_CHECK_NULL_RETURN(recents_screen, false, "Invalid recents_screen");
     ESP_UTILS_CHECK_FALSE_RETURN(recents_screen->setVisible(false), false, "Hide recents_screen failed");
+    releaseAppSnapshotViews();
 
     // Load the main screen if there is no active app
     if (active_app == nullptr) {
@@ -510,7 +510,7 @@ bool AppLauncher::updateActiveSpot(void)
     return true;
 }
 
-bool AppLauncher::updateByNewData(void)
+bool AppLauncher::updateTableLayoutByNewData(void)
 {
     uint8_t app_num_hor = 0;
     uint8_t app_num_ver = 0;
@@ -519,7 +519,7 @@ bool AppLauncher::updateByNewData(void)
     uint8_t new_table_icon_count_max = 0;
     uint8_t old_table_icon_count_max = 0;
 
-    ESP_UTILS_LOGD("Update(0x%p)", this);
+    ESP_UTILS_LOGD("Update table layout(0x%p)", this);
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
 
     // Calculate the max amount of app's icons in column and row.
@@ -588,26 +588,50 @@ bool AppLauncher::updateByNewData(void)
         }
     }
 
+    return true;
+}
+
+bool AppLauncher::updateByNewData(uint32_t dirty_mask)
+{
+    ESP_UTILS_LOGD("Update(0x%p), dirty(0x%x)", this, static_cast<unsigned>(dirty_mask));
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+
+    if (dirty_mask & DATA_DIRTY_TABLE) {
+        ESP_UTILS_CHECK_FALSE_RETURN(updateTableLayoutByNewData(), false, "Update table layout failed");
+    }
+
     /* Update object style */
     // Main
-    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
-    lv_obj_align(_main_obj.get(), LV_ALIGN_TOP_MID, 0, _data.main.y_start);
+    if (dirty_mask & DATA_DIRTY_MAIN) {
+        lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
+        lv_obj_align(_main_obj.get(), LV_ALIGN_TOP_MID, 0, _data.main.y_start);
+    }
     // Table
-    lv_obj_set_size(_table_obj.get(), _data.table.size.width, _data.table.size.height);
+    if (dirty_mask & DATA_DIRTY_TABLE) {
+        lv_obj_set_size(_table_obj.get(), _data.table.size.width, _data.table.size.height);
+    }
     // Indicator
-    lv_obj_set_size(_indicator_obj.get(), _data.indicator.main_size.width, _data.indicator.main_size.height);
-    lv_obj_set_style_pad_column(_indicator_obj.get(), _data.indicator.main_layout_column_pad, 0);
-    lv_obj_align(_indicator_obj.get(), LV_ALIGN_BOTTOM_MID, 0, -_data.indicator.main_layout_bottom_offset);
+    if (dirty_mask & DATA_DIRTY_INDICATOR) {
+        lv_obj_set_size(_indicator_obj.get(), _data.indicator.main_size.width, _data.indicator.main_size.height);
+        lv_obj_set_style_pad_column(_indicator_obj.get(), _data.indicator.main_layout_column_pad, 0);
+        lv_obj_align(_indicator_obj.get(), LV_ALIGN_BOTTOM_MID, 0, -_data.indicator.main_layout_bottom_offset);
+    }
     // Mix
-    for (size_t i = 0; i < _mix_objs.size(); i++) {
-        ESP_UTILS_CHECK_FALSE_RETURN(updateMixByNewData(i, _mix_objs), false, "Update mix object(%d) style failed",
-                                     (int)i);
+    if (dirty_mask & (DATA_DIRTY_TABLE | DATA_DIRTY_INDICATOR)) {
+        for (size_t i = 0; i < _mix_objs.size(); i++) {
+            ESP_UTILS_CHECK_FALSE_RETURN(updateMixByNewData(i, _mix_objs), false, "Update mix object(%d) style failed",
+                                         (int)i);
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(updateActiveSpot(), false, "Update active spot failed");
+    }
+    if (!(dirty_mask & (DATA_DIRTY_TABLE | DATA_DIRTY_ICON))) {
+        return true;
     }
-    ESP_UTILS_CHECK_FALSE_RETURN(updateActiveSpot(), false, "Update active spot failed");
     // Icon
     for (auto &id_icon : _id_mix_icon_map) {
         // Process the icons which current table index is not equal to target table index
-        if (id_icon.second.target_page_index != id_icon.second.current_page_index) {
+        if ((dirty_mask & DATA_DIRTY_TABLE) &&
+                (id_icon.second.target_page_index != id_icon.second.current_page_index)) {
             ESP_UTILS_LOGD("Try to change icon(%d) table: %d->%d", id_icon.first, id_icon.second.current_page_index,
                            id_icon.second.target_page_index);
             if (!checkTableFull(id_icon.second.target_page_index)) {
@@ -621,7 +645,9 @@ bool AppLauncher::updateByNewData(void)
             }
         }
 next:
-        ESP_UTILS_CHECK_FALSE_RETURN(id_icon.second.icon->updateByNewData(), false, "Update icon style failed");
+        if (dirty_mask & DATA_DIRTY_ICON) {
+            ESP_UTILS_CHECK_FALSE_RETURN(id_icon.second.icon->updateByNewData(), false, "Update icon style failed");
+        }
     }
 
     return true;
@@ -636,8 +662,35 @@ void AppLauncher::onDataUpdateEventCallback(lv_event_t *event)
 
     app_launcher = (AppLauncher *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(app_launcher, "Invalid app launcher object");
+    uint32_t dirty_mask = app_launcher->getDataDirtyMask();
+    if (dirty_mask == DATA_DIRTY_NONE) {
+        return;
+    }
+
+    ESP_UTILS_CHECK_FALSE_EXIT(app_launcher->updateByNewData(dirty_mask), "Update object style failed");
+}
+
+uint32_t AppLauncher::getDataDirtyMask(void) const
+{
+    if (_system_context.checkDataUpdated(_data.flags)) {
+        return DATA_DIRTY_ALL;
+    }
+
+    uint32_t dirty_mask = DATA_DIRTY_NONE;
+    if (_system_context.checkDataUpdated(_data.main)) {
+        dirty_mask |= DATA_DIRTY_MAIN;
+    }
+    if (_system_context.checkDataUpdated(_data.table) || _system_context.checkDataUpdated(_data.icon.main.size)) {
+        dirty_mask |= DATA_DIRTY_TABLE;
+    }
+    if (_system_context.checkDataUpdated(_data.indicator)) {
+        dirty_mask |= DATA_DIRTY_INDICATOR;
+    }
+    if (_system_context.checkDataUpdated(_data.icon)) {
+        dirty_mask |= DATA_DIRTY_ICON;
+    }
 
-    ESP_UTILS_CHECK_FALSE_EXIT(app_launcher->updateByNewData(), "Update object style failed");
+    return dirty_mask;
 }
 
 void AppLauncher::onPageTouchEventCallback(lv_event_t *event)
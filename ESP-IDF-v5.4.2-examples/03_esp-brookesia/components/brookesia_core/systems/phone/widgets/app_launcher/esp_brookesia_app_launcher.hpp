@@ -65,6 +65,16 @@ public:
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display, AppLauncherData &data);
 
 private:
+    // Parts to update after a data update, the table is only relaid out when its size or the icon size changes
+    enum DataDirty {
+        DATA_DIRTY_NONE      = 0,
+        DATA_DIRTY_MAIN      = (1 << 0),
+        DATA_DIRTY_TABLE     = (1 << 1),
+        DATA_DIRTY_INDICATOR = (1 << 2),
+        DATA_DIRTY_ICON      = (1 << 3),
+        DATA_DIRTY_ALL       = (DATA_DIRTY_MAIN | DATA_DIRTY_TABLE | DATA_DIRTY_INDICATOR | DATA_DIRTY_ICON),
+    };
+
     struct MixObject {
         uint8_t page_icon_count;
         gui::LvObjSharedPtr page_main_obj;
@@ -84,7 +94,9 @@ private:
     bool togglePageIconClickable(uint8_t page_index, bool clickable);
     bool toggleCurrentPageIconClickable(bool clickable);
     bool updateActiveSpot(void);
-    bool updateByNewData(void);
+    bool updateTableLayoutByNewData(void);
+    uint32_t getDataDirtyMask(void) const;
+    bool updateByNewData(uint32_t dirty_mask = DATA_DIRTY_ALL);
 
     static void onDataUpdateEventCallback(lv_event_t *event);
     static void onPageTouchEventCallback(lv_event_t *event);
@@ -393,9 +393,9 @@ void Gesture::resetGestureInfo(void)
     _info = reset_info;
 }
 
-bool Gesture::updateByNewData(void)
+bool Gesture::updateByNewData(uint32_t dirty_mask)
 {
-    ESP_UTILS_LOGD("Update(0x%p)", this);
+    ESP_UTILS_LOGD("Update(0x%p), dirty(0x%x)", this, static_cast<unsigned>(dirty_mask));
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
 
     int bar_range = 0;
@@ -403,11 +403,16 @@ bool Gesture::updateByNewData(void)
     int align_y_offset = 0;
     lv_align_t align = LV_ALIGN_DEFAULT;
     // Timer
-    lv_timer_set_period(_detect_timer.get(), data.detect_period_ms);
+    if (dirty_mask & DATA_DIRTY_TIMER) {
+        lv_timer_set_period(_detect_timer.get(), data.detect_period_ms);
+    }
     // Mask
-    lv_obj_set_size(_event_mask_obj.get(), core.getData().screen_size.width, core.getData().screen_size.height);
+    if (dirty_mask & DATA_DIRTY_MASK) {
+        lv_obj_set_size(_event_mask_obj.get(), core.getData().screen_size.width, core.getData().screen_size.height);
+    }
     // Indicator bar
-    for (int i = 0; i < static_cast<int>(Gesture::IndicatorBarType::MAX); i++) {
+    for (int i = 0; (dirty_mask & DATA_DIRTY_INDICATOR_BAR) && (i < static_cast<int>(Gesture::IndicatorBarType::MAX));
+            i++) {
         const Gesture::IndicatorBarData &bar_data = data.indicator_bars[i];
         // Main
         lv_obj_set_size(_indicator_bars[i].get(), bar_data.main.size_max.width, bar_data.main.size_max.height);
@@ -467,8 +472,31 @@ void Gesture::onDataUpdateEventCallback(lv_event_t *event)
 
     gesture = (Gesture *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(gesture, "Invalid gesture object");
+    uint32_t dirty_mask = gesture->getDataDirtyMask();
+    if (dirty_mask == DATA_DIRTY_NONE) {
+        return;
+    }
+
+    ESP_UTILS_CHECK_FALSE_EXIT(gesture->updateByNewData(dirty_mask), "Update gesture object style failed");
+}
+
+uint32_t Gesture::getDataDirtyMask(void) const
+{
+    uint32_t dirty_mask = DATA_DIRTY_NONE;
+
+    if (core.checkDataUpdated(data.detect_period_ms)) {
+        dirty_mask |= DATA_DIRTY_TIMER;
+    }
+    // The mask covers the screen, which is part of the core data
+    if (core.checkDataUpdated(core.getData().screen_size)) {
+        dirty_mask |= DATA_DIRTY_MASK;
+    }
+    if (core.checkDataUpdated(data.threshold) || core.checkDataUpdated(data.indicator_bars) ||
+            core.checkDataUpdated(data.flags)) {
+        dirty_mask |= DATA_DIRTY_INDICATOR_BAR;
+    }
 
-    ESP_UTILS_CHECK_FALSE_EXIT(gesture->updateByNewData(), "Update gesture object style failed");
+    return dirty_mask;
 }
 
 void Gesture::onTouchDetectTimerCallback(struct _lv_timer_t *t)
@@ -145,8 +145,18 @@ private:
         Gesture *gesture;
         Gesture::IndicatorBarType type;
     };
+    // Parts to update after a data update
+    enum DataDirty {
+        DATA_DIRTY_NONE          = 0,
+        DATA_DIRTY_TIMER         = (1 << 0),
+        DATA_DIRTY_MASK          = (1 << 1),
+        DATA_DIRTY_INDICATOR_BAR = (1 << 2),
+        DATA_DIRTY_ALL           = (DATA_DIRTY_TIMER | DATA_DIRTY_MASK | DATA_DIRTY_INDICATOR_BAR),
+    };
+
     void resetGestureInfo(void);
-    bool updateByNewData(void);
+    uint32_t getDataDirtyMask(void) const;
+    bool updateByNewData(uint32_t dirty_mask = DATA_DIRTY_ALL);
 
     static void onDataUpdateEventCallback(lv_event_t *event);
     static void onTouchDetectTimerCallback(struct _lv_timer_t *t);
@@ -339,21 +339,23 @@ bool NavigationBar::calibrateData(const gui::StyleSize &screen_size, const base:
     return true;
 }
 
-bool NavigationBar::updateByNewData(void)
+bool NavigationBar::updateByNewData(uint32_t dirty_mask)
 {
     float h_factor = 0;
     float w_factor = 0;
     lv_img_dsc_t *icon_image_resource = nullptr;
 
-    ESP_UTILS_LOGD("Update(0x%p)", this);
+    ESP_UTILS_LOGD("Update(0x%p), dirty(0x%x)", this, static_cast<unsigned>(dirty_mask));
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
 
     // Main
-    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
-    lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
-    lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+    if (dirty_mask & DATA_DIRTY_MAIN) {
+        lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
+        lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
+        lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+    }
 
-    for (int i = 0; i < BUTTON_NUM; i++) {
+    for (int i = 0; (dirty_mask & DATA_DIRTY_BUTTON) && (i < BUTTON_NUM); i++) {
         // Button
         lv_obj_set_size(_button_objs[i].get(), _data.main.size.width / BUTTON_NUM,
                         _data.main.size.height);
@@ -383,6 +385,10 @@ bool NavigationBar::updateByNewData(void)
         lv_obj_refr_size(_icon_image_objs[i].get());
     }
 
+    if (!(dirty_mask & DATA_DIRTY_VISUAL_FLEX)) {
+        return true;
+    }
+
     /* Visual flex */
     // Show animation
     lv_anim_set_values(_visual_flex_show_anim.get(), _data.main.size.height, 0);
@@ -527,8 +533,34 @@ void NavigationBar::onDataUpdateEventCallback(lv_event_t *event)
 
     navigation_bar = (NavigationBar *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(navigation_bar, "Invalid navigation bar object");
+    uint32_t dirty_mask = navigation_bar->getDataDirtyMask();
+    if (dirty_mask == DATA_DIRTY_NONE) {
+        return;
+    }
+
+    ESP_UTILS_CHECK_FALSE_EXIT(navigation_bar->updateByNewData(dirty_mask), "Update failed");
+}
+
+uint32_t NavigationBar::getDataDirtyMask(void) const
+{
+    // The buttons and the animations are sized by the main object
+    if (_system_context.checkDataUpdated(_data.main.size) || _system_context.checkDataUpdated(_data.main.size_min) ||
+            _system_context.checkDataUpdated(_data.main.size_max) || _system_context.checkDataUpdated(_data.flags)) {
+        return DATA_DIRTY_ALL;
+    }
+
+    uint32_t dirty_mask = DATA_DIRTY_NONE;
+    if (_system_context.checkDataUpdated(_data.main.background_color)) {
+        dirty_mask |= DATA_DIRTY_MAIN;
+    }
+    if (_system_context.checkDataUpdated(_data.button)) {
+        dirty_mask |= DATA_DIRTY_BUTTON;
+    }
+    if (_system_context.checkDataUpdated(_data.visual_flex)) {
+        dirty_mask |= DATA_DIRTY_VISUAL_FLEX;
+    }
 
-    ESP_UTILS_CHECK_FALSE_EXIT(navigation_bar->updateByNewData(), "Update failed");
+    return dirty_mask;
 }
 
 void NavigationBar::onIconTouchEventCallback(lv_event_t *event)
@@ -85,7 +85,17 @@ public:
                               Data &data);
 
 private:
-    bool updateByNewData(void);
+    // Parts to update after a data update
+    enum DataDirty {
+        DATA_DIRTY_NONE        = 0,
+        DATA_DIRTY_MAIN        = (1 << 0),
+        DATA_DIRTY_BUTTON      = (1 << 1),
+        DATA_DIRTY_VISUAL_FLEX = (1 << 2),
+        DATA_DIRTY_ALL         = (DATA_DIRTY_MAIN | DATA_DIRTY_BUTTON | DATA_DIRTY_VISUAL_FLEX),
+    };
+
+    uint32_t getDataDirtyMask(void) const;
+    bool updateByNewData(uint32_t dirty_mask = DATA_DIRTY_ALL);
     bool startFlexShowAnimation(bool enable_auto_hide);
     bool stopFlexShowAnimation(void);
     bool startFlexHideAnimation(void);
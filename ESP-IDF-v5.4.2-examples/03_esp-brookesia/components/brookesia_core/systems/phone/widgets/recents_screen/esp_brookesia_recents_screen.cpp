@@ -81,6 +81,11 @@ bool RecentsScreen::begin(lv_obj_t *parent)
         // Label
         lv_obj_add_style(memory_label.get(), _system_context.getDisplay().getCoreContainerStyle(), 0);
         lv_obj_clear_flag(memory_label.get(), LV_OBJ_FLAG_SCROLLABLE);
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+        // A long press toggles the display performance monitor
+        lv_obj_add_flag(memory_obj.get(), LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(memory_obj.get(), onMemoryLongPressedEventCallback, LV_EVENT_LONG_PRESSED, this);
+#endif
     }
     // Snapshot snapshot_table
     lv_obj_add_style(snapshot_table.get(), _system_context.getDisplay().getCoreContainerStyle(), 0);
@@ -283,6 +288,19 @@ bool RecentsScreen::setMemoryLabel(int internal_free, int internal_total, int ex
     return true;
 }
 
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+bool RecentsScreen::setSnapshotMemoryUsage(int id, const base::AppMemoryTracker::Usage &usage)
+{
+    ESP_UTILS_LOGD("Set snapshot(%d) memory usage", id);
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(checkSnapshotExist(id), false, "Snapshot is not exist");
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_id_snapshot_map.at(id)->setMemoryUsage(usage), false, "Set memory usage failed");
+
+    return true;
+}
+#endif
+
 bool RecentsScreen::checkSnapshotExist(int id) const
 {
     auto it = _id_snapshot_map.find(id);
@@ -506,25 +524,24 @@ bool RecentsScreen::calibrateData(const gui::StyleSize &screen_size, const base:
     return true;
 }
 
-bool RecentsScreen::updateByNewData(void)
+bool RecentsScreen::updateByNewData(uint32_t dirty_mask)
 {
-    float h_factor = 0;
-    float w_factor = 0;
-
-    ESP_UTILS_LOGD("Update(0x%p)", this);
+    ESP_UTILS_LOGD("Update(0x%p), dirty(0x%x)", this, static_cast<unsigned>(dirty_mask));
     ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
 
     // Main
-    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
-    lv_obj_set_style_pad_row(_main_obj.get(), _data.main.layout_row_pad, 0);
-    lv_obj_set_style_pad_top(_main_obj.get(), _data.main.layout_top_pad, 0);
-    lv_obj_set_style_pad_bottom(_main_obj.get(), _data.main.layout_bottom_pad, 0);
-    lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
-    lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
-    lv_obj_align(_main_obj.get(), LV_ALIGN_TOP_MID, 0, _data.main.y_start);
+    if (dirty_mask & DATA_DIRTY_MAIN) {
+        lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
+        lv_obj_set_style_pad_row(_main_obj.get(), _data.main.layout_row_pad, 0);
+        lv_obj_set_style_pad_top(_main_obj.get(), _data.main.layout_top_pad, 0);
+        lv_obj_set_style_pad_bottom(_main_obj.get(), _data.main.layout_bottom_pad, 0);
+        lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
+        lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+        lv_obj_align(_main_obj.get(), LV_ALIGN_TOP_MID, 0, _data.main.y_start);
+    }
 
     // Label
-    if (_data.flags.enable_memory) {
+    if ((dirty_mask & DATA_DIRTY_MEMORY) && _data.flags.enable_memory) {
         lv_obj_set_size(_memory_obj.get(), _data.memory.main_size.width, _data.memory.main_size.height);
         lv_obj_align(_memory_label.get(), LV_ALIGN_RIGHT_MID, -_data.memory.main_layout_x_right_offset, 0);
         lv_obj_set_style_text_color(_memory_label.get(), lv_color_hex(_data.memory.label_text_color.color), 0);
@@ -533,10 +550,36 @@ bool RecentsScreen::updateByNewData(void)
     }
 
     // Table
-    lv_obj_set_size(_snapshot_table.get(), _data.snapshot_table.main_size.width, _data.snapshot_table.main_size.height);
-    lv_obj_set_style_pad_column(_snapshot_table.get(), _data.snapshot_table.main_layout_column_pad, 0);
+    if (dirty_mask & DATA_DIRTY_TABLE) {
+        lv_obj_set_size(_snapshot_table.get(), _data.snapshot_table.main_size.width,
+                        _data.snapshot_table.main_size.height);
+        lv_obj_set_style_pad_column(_snapshot_table.get(), _data.snapshot_table.main_layout_column_pad, 0);
+    }
 
     // Trash
+    if (dirty_mask & DATA_DIRTY_TRASH) {
+        ESP_UTILS_CHECK_FALSE_RETURN(updateTrashByNewData(), false, "Update trash failed");
+    }
+
+    // Snapshot
+    if (!(dirty_mask & DATA_DIRTY_SNAPSHOT)) {
+        return true;
+    }
+    for (auto &it : _id_snapshot_map) {
+        ESP_UTILS_CHECK_NULL_RETURN(it.second, false, "Invalid snapshot(%d)", it.first);
+        ESP_UTILS_CHECK_FALSE_RETURN(it.second->updateByNewData(), false, "Update snapshot object style failed");
+    }
+
+    return true;
+}
+
+bool RecentsScreen::updateTrashByNewData(void)
+{
+    float h_factor = 0;
+    float w_factor = 0;
+
+    ESP_UTILS_LOGD("Update trash(0x%p)", this);
+
     lv_obj_set_size(_trash_obj.get(), _data.trash_icon.default_size.width, _data.trash_icon.default_size.height);
     lv_img_set_src(_trash_icon.get(), _data.trash_icon.image.resource);
     lv_obj_set_style_img_recolor(_trash_icon.get(), lv_color_hex(_data.trash_icon.image.recolor.color), 0);
@@ -564,12 +607,6 @@ bool RecentsScreen::updateByNewData(void)
     lv_obj_set_size(_trash_icon.get(), _data.trash_icon.default_size.width, _data.trash_icon.default_size.height);
     lv_obj_refr_size(_trash_icon.get());
 
-    // Snapshot
-    for (auto &it : _id_snapshot_map) {
-        ESP_UTILS_CHECK_NULL_RETURN(it.second, false, "Invalid snapshot(%d)", it.first);
-        ESP_UTILS_CHECK_FALSE_RETURN(it.second->updateByNewData(), false, "Update snapshot object style failed");
-    }
-
     return true;
 }
 
@@ -582,8 +619,39 @@ void RecentsScreen::onDataUpdateEventCallback(lv_event_t *event)
 
     recents_screen = (RecentsScreen *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(recents_screen, "Invalid app snapshot_table object");
+    uint32_t dirty_mask = recents_screen->getDataDirtyMask();
+    if (dirty_mask == DATA_DIRTY_NONE) {
+        return;
+    }
+
+    ESP_UTILS_CHECK_FALSE_EXIT(recents_screen->updateByNewData(dirty_mask), "Update object style failed");
+}
+
+uint32_t RecentsScreen::getDataDirtyMask(void) const
+{
+    if (_system_context.checkDataUpdated(_data.flags)) {
+        return DATA_DIRTY_ALL;
+    }
+
+    uint32_t dirty_mask = DATA_DIRTY_NONE;
+    if (_system_context.checkDataUpdated(_data.main)) {
+        dirty_mask |= DATA_DIRTY_MAIN;
+    }
+    if (_system_context.checkDataUpdated(_data.memory)) {
+        dirty_mask |= DATA_DIRTY_MEMORY;
+    }
+    if (_system_context.checkDataUpdated(_data.snapshot_table.main_size) ||
+            _system_context.checkDataUpdated(_data.snapshot_table.main_layout_column_pad)) {
+        dirty_mask |= DATA_DIRTY_TABLE;
+    }
+    if (_system_context.checkDataUpdated(_data.trash_icon)) {
+        dirty_mask |= DATA_DIRTY_TRASH;
+    }
+    if (_system_context.checkDataUpdated(_data.snapshot_table.snapshot)) {
+        dirty_mask |= DATA_DIRTY_SNAPSHOT;
+    }
 
-    ESP_UTILS_CHECK_FALSE_EXIT(recents_screen->updateByNewData(), "Update object style failed");
+    return dirty_mask;
 }
 
 void RecentsScreen::onTrashTouchEventCallback(lv_event_t *event)
@@ -633,4 +701,18 @@ void RecentsScreen::onTrashTouchEventCallback(lv_event_t *event)
     }
 }
 
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+void RecentsScreen::onMemoryLongPressedEventCallback(lv_event_t *event)
+{
+    RecentsScreen *recents_screen = (RecentsScreen *)lv_event_get_user_data(event);
+
+    ESP_UTILS_LOGD("Memory long pressed event callback");
+    ESP_UTILS_CHECK_NULL_EXIT(recents_screen, "Invalid recents_screen object");
+
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        recents_screen->_system_context.getDisplay().togglePerfMonitor(), "Toggle performance monitor failed"
+    );
+}
+#endif
+
 } // namespace esp_brookesia::systems::phone
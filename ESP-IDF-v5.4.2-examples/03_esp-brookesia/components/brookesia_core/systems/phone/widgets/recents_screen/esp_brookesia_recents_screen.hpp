@@ -68,6 +68,9 @@ public:
     bool moveSnapshotY(int id, int y);
     bool updateSnapshotImage(int id);
     bool setMemoryLabel(int internal_free, int internal_total, int external_free, int external_total) const;
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    bool setSnapshotMemoryUsage(int id, const base::AppMemoryTracker::Usage &usage);
+#endif
 
     bool checkInitialized(void) const
     {
@@ -97,10 +100,27 @@ public:
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display, Data &data);
 
 private:
-    bool updateByNewData(void);
+    // Parts to update after a data update
+    enum DataDirty {
+        DATA_DIRTY_NONE     = 0,
+        DATA_DIRTY_MAIN     = (1 << 0),
+        DATA_DIRTY_MEMORY   = (1 << 1),
+        DATA_DIRTY_TABLE    = (1 << 2),
+        DATA_DIRTY_TRASH    = (1 << 3),
+        DATA_DIRTY_SNAPSHOT = (1 << 4),
+        DATA_DIRTY_ALL      = (DATA_DIRTY_MAIN | DATA_DIRTY_MEMORY | DATA_DIRTY_TABLE | DATA_DIRTY_TRASH |
+                               DATA_DIRTY_SNAPSHOT),
+    };
+
+    uint32_t getDataDirtyMask(void) const;
+    bool updateByNewData(uint32_t dirty_mask = DATA_DIRTY_ALL);
+    bool updateTrashByNewData(void);
 
     static void onDataUpdateEventCallback(lv_event_t *event);
     static void onTrashTouchEventCallback(lv_event_t *event);
+#if ESP_BROOKESIA_BASE_DISPLAY_ENABLE_PERF_MONITOR
+    static void onMemoryLongPressedEventCallback(lv_event_t *event);
+#endif
 
     base::Context &_system_context;
     const Data &_data;
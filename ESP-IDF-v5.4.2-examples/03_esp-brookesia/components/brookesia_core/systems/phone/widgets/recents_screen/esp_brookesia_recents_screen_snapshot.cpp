@@ -10,6 +10,9 @@
 #include "phone/private/esp_brookesia_phone_utils.hpp"
 #include "esp_brookesia_recents_screen_snapshot.hpp"
 
+#define MEMORY_LABEL_TEXT_FORMAT    "SRAM %d KB, peak %d KB\nPSRAM %d KB, peak %d KB"
+#define MEMORY_LABEL_BG_OPA         (LV_OPA_50)
+
 using namespace std;
 using namespace esp_brookesia::gui;
 
@@ -43,6 +46,9 @@ bool RecentsScreenSnapshot::begin(lv_obj_t *parent)
     ESP_Brookesia_LvObj_t title_label = NULL;
     ESP_Brookesia_LvObj_t snapshot_obj = NULL;
     ESP_Brookesia_LvObj_t snapshot_image = NULL;
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    ESP_Brookesia_LvObj_t memory_label = NULL;
+#endif
 
     ESP_UTILS_LOGD("Begin@0x%p)", this);
     ESP_UTILS_CHECK_NULL_RETURN(parent, false, "Invalid parent object");
@@ -66,6 +72,10 @@ bool RecentsScreenSnapshot::begin(lv_obj_t *parent)
     ESP_UTILS_CHECK_NULL_RETURN(snapshot_obj, false, "Create snapshot obj failed");
     snapshot_image = ESP_BROOKESIA_LV_OBJ(img, snapshot_obj.get());
     ESP_UTILS_CHECK_NULL_RETURN(snapshot_image, false, "Create snapshot image failed");
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    memory_label = ESP_BROOKESIA_LV_OBJ(label, snapshot_obj.get());
+    ESP_UTILS_CHECK_NULL_RETURN(memory_label, false, "Create memory label failed");
+#endif
 
     /* Setup objects style */
     // Main
@@ -99,6 +109,16 @@ bool RecentsScreenSnapshot::begin(lv_obj_t *parent)
     lv_obj_center(snapshot_image.get());
     lv_image_set_inner_align(snapshot_image.get(), LV_IMAGE_ALIGN_CENTER);
     lv_obj_clear_flag(snapshot_image.get(), LV_OBJ_FLAG_SCROLLABLE);
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    // Memory label, hidden until the usage is set
+    lv_obj_add_style(memory_label.get(), _system_context.getDisplay().getCoreContainerStyle(), 0);
+    lv_obj_align(memory_label.get(), LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_set_width(memory_label.get(), LV_PCT(100));
+    lv_obj_set_style_bg_color(memory_label.get(), lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(memory_label.get(), MEMORY_LABEL_BG_OPA, 0);
+    lv_obj_set_style_text_align(memory_label.get(), LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_add_flag(memory_label.get(), LV_OBJ_FLAG_HIDDEN);
+#endif
 
     /* Save objects */
     _main_obj = main_obj;
@@ -108,6 +128,9 @@ bool RecentsScreenSnapshot::begin(lv_obj_t *parent)
     _title_label = title_label;
     _snapshot_obj = snapshot_obj;
     _snapshot_image = snapshot_image;
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    _memory_label = memory_label;
+#endif
 
     // Update style
     ESP_UTILS_CHECK_FALSE_GOTO(updateByNewData(), err, "Update failed");
@@ -138,6 +161,9 @@ bool RecentsScreenSnapshot::del(void)
     _title_label.reset();
     _snapshot_obj.reset();
     _snapshot_image.reset();
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    _memory_label.reset();
+#endif
 
     return true;
 }
@@ -202,8 +228,29 @@ bool RecentsScreenSnapshot::updateByNewData(void)
     }
     lv_obj_set_size(_snapshot_image.get(), _data.image.main_size.width, _data.image.main_size.height);
     lv_img_set_src(_snapshot_image.get(), _conf.snapshot_image_resource);
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    // Memory label, over the image
+    lv_obj_set_style_text_font(_memory_label.get(), (lv_font_t *)_data.title.text_font.font_resource, 0);
+    lv_obj_set_style_text_color(_memory_label.get(), lv_color_hex(_data.title.text_color.color), 0);
+    lv_obj_move_foreground(_memory_label.get());
+#endif
 
     return true;
 }
 
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+bool RecentsScreenSnapshot::setMemoryUsage(const base::AppMemoryTracker::Usage &usage)
+{
+    ESP_UTILS_LOGD("Set memory usage(@0x%p)", this);
+    ESP_UTILS_CHECK_FALSE_RETURN(checkInitialized(), false, "Not initialized");
+
+    lv_label_set_text_fmt(_memory_label.get(), MEMORY_LABEL_TEXT_FORMAT,
+                          static_cast<int>(usage.sram_bytes / 1024), static_cast<int>(usage.sram_peak_bytes / 1024),
+                          static_cast<int>(usage.psram_bytes / 1024), static_cast<int>(usage.psram_peak_bytes / 1024));
+    lv_obj_remove_flag(_memory_label.get(), LV_OBJ_FLAG_HIDDEN);
+
+    return true;
+}
+#endif
+
 } // namespace esp_brookesia::systems::phone
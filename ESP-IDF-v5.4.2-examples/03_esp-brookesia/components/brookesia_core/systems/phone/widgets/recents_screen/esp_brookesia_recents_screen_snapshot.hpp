@@ -67,6 +67,12 @@ public:
     int getCurrentY(void) const;
 
     bool updateByNewData(void);
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    /**
+     * @brief Show the current and peak heap usage of the app over the snapshot image
+     */
+    bool setMemoryUsage(const base::AppMemoryTracker::Usage &usage);
+#endif
 
 private:
     base::Context &_system_context;
@@ -81,6 +87,9 @@ private:
     ESP_Brookesia_LvObj_t _title_label;
     ESP_Brookesia_LvObj_t _snapshot_obj;
     ESP_Brookesia_LvObj_t _snapshot_image;
+#if ESP_BROOKESIA_BASE_APP_ENABLE_MEMORY_ATTRIBUTION
+    ESP_Brookesia_LvObj_t _memory_label;
+#endif
 };
 
 } // namespace esp_brookesia::systems::phone
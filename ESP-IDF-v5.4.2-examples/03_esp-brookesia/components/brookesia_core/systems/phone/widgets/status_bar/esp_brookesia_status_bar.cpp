@@ -324,18 +324,23 @@ err:
     return false;
 }
 
-bool StatusBar::updateMainByNewData(void)
+bool StatusBar::updateMainByNewData(uint32_t dirty_mask)
 {
-    ESP_UTILS_LOGD("Update main(0x%p)", this);
+    ESP_UTILS_LOGD("Update main(0x%p), dirty(0x%x)", this, static_cast<unsigned>(dirty_mask));
     ESP_UTILS_CHECK_FALSE_RETURN(checkMainInitialized(), false, "Not initialized");
 
-    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
-    lv_obj_set_style_text_font(_main_obj.get(), (lv_font_t *)_data.main.text_font.font_resource, 0);
-    lv_obj_set_style_text_color(_main_obj.get(), lv_color_hex(_data.main.text_color.color), 0);
-    lv_obj_set_style_text_opa(_main_obj.get(), _data.main.text_color.opacity, 0);
-    lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
-    lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+    if (dirty_mask & DATA_DIRTY_MAIN_STYLE) {
+        lv_obj_set_style_text_font(_main_obj.get(), (lv_font_t *)_data.main.text_font.font_resource, 0);
+        lv_obj_set_style_text_color(_main_obj.get(), lv_color_hex(_data.main.text_color.color), 0);
+        lv_obj_set_style_text_opa(_main_obj.get(), _data.main.text_color.opacity, 0);
+        lv_obj_set_style_bg_color(_main_obj.get(), lv_color_hex(_data.main.background_color.color), 0);
+        lv_obj_set_style_bg_opa(_main_obj.get(), _data.main.background_color.opacity, 0);
+    }
+    if (!(dirty_mask & DATA_DIRTY_MAIN_LAYOUT)) {
+        return true;
+    }
 
+    lv_obj_set_size(_main_obj.get(), _data.main.size.width, _data.main.size.height);
     lv_flex_align_t main_align = LV_FLEX_ALIGN_START;
     for (size_t i = 0; i < _area_objs.size(); i++) {
         lv_obj_set_size(_area_objs[i].get(), _data.area.data[i].size.width, _data.area.data[i].size.height);
@@ -715,14 +720,25 @@ void StatusBar::onDataUpdateEventCallback(lv_event_t *event)
     ESP_UTILS_LOGD("Data update event callback");
     status_bar = (StatusBar *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(status_bar, "Invalid status bar object");
+    // Skip the activations which didn't change this widget
+    uint32_t dirty_mask = status_bar->getDataDirtyMask();
+    if (dirty_mask == DATA_DIRTY_NONE) {
+        return;
+    }
 
     // Main
-    ESP_UTILS_CHECK_FALSE_EXIT(status_bar->updateMainByNewData(), "Update main object style failed");
-    for (auto &icon : status_bar->_id_icon_map) {
-        if (!icon.second->updateByNewData()) {
-            ESP_UTILS_LOGE("Update icon(%d) style failed", icon.first);
+    ESP_UTILS_CHECK_FALSE_EXIT(status_bar->updateMainByNewData(dirty_mask), "Update main object style failed");
+    if (dirty_mask & DATA_DIRTY_ICON) {
+        for (auto &icon : status_bar->_id_icon_map) {
+            if (!icon.second->updateByNewData()) {
+                ESP_UTILS_LOGE("Update icon(%d) style failed", icon.first);
+            }
         }
     }
+    // The battery and the clock follow the text color, and are hidden when out of their area
+    if (!(dirty_mask & (DATA_DIRTY_MAIN_LAYOUT | DATA_DIRTY_MAIN_STYLE))) {
+        return;
+    }
     // Battery
     if (status_bar->checkBatteryInitialized() && !status_bar->updateBatteryByNewData()) {
         ESP_UTILS_LOGE("Update battery object style failed");
@@ -733,4 +749,28 @@ void StatusBar::onDataUpdateEventCallback(lv_event_t *event)
     }
 }
 
+uint32_t StatusBar::getDataDirtyMask(void) const
+{
+    if (_system_context.checkDataUpdated(_data.flags)) {
+        return DATA_DIRTY_ALL;
+    }
+
+    uint32_t dirty_mask = DATA_DIRTY_NONE;
+    if (_system_context.checkDataUpdated(_data.main.size) || _system_context.checkDataUpdated(_data.main.size_min) ||
+            _system_context.checkDataUpdated(_data.main.size_max) || _system_context.checkDataUpdated(_data.area)) {
+        dirty_mask |= DATA_DIRTY_MAIN_LAYOUT;
+    }
+    if (_system_context.checkDataUpdated(_data.main.background_color) ||
+            _system_context.checkDataUpdated(_data.main.text_font) ||
+            _system_context.checkDataUpdated(_data.main.text_color)) {
+        dirty_mask |= DATA_DIRTY_MAIN_STYLE;
+    }
+    if (_system_context.checkDataUpdated(_data.icon_common_size) || _system_context.checkDataUpdated(_data.battery) ||
+            _system_context.checkDataUpdated(_data.wifi) || _system_context.checkDataUpdated(_data.clock)) {
+        dirty_mask |= DATA_DIRTY_ICON;
+    }
+
+    return dirty_mask;
+}
+
 } // namespace esp_brookesia::systems::phone
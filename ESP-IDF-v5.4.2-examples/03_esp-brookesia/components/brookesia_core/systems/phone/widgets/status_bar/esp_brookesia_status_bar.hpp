@@ -121,8 +121,19 @@ public:
                               Data &data);
 
 private:
+    // Parts to update after a data update, so a change of colors doesn't relayout the areas
+    enum DataDirty {
+        DATA_DIRTY_NONE        = 0,
+        DATA_DIRTY_MAIN_LAYOUT = (1 << 0),
+        DATA_DIRTY_MAIN_STYLE  = (1 << 1),
+        DATA_DIRTY_ICON        = (1 << 2),
+        DATA_DIRTY_ALL         = (DATA_DIRTY_MAIN_LAYOUT | DATA_DIRTY_MAIN_STYLE | DATA_DIRTY_ICON),
+    };
+
+    uint32_t getDataDirtyMask(void) const;
+
     bool beginMain(lv_obj_t *parent);
-    bool updateMainByNewData(void);
+    bool updateMainByNewData(uint32_t dirty_mask = DATA_DIRTY_ALL);
     bool delMain(void);
     bool checkMainInitialized(void) const
     {
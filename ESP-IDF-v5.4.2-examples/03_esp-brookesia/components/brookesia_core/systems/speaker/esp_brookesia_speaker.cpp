@@ -9,6 +9,7 @@
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_speaker_utils.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "stylesheets/esp_brookesia_speaker_stylesheets.hpp"
 #include "esp_brookesia_speaker.hpp"
 
@@ -67,6 +68,7 @@ bool Speaker::begin(void)
     gui::StyleSize display_size = {};
 
     ESP_UTILS_LOGD("Begin speaker(@0x%p)", this);
+    ESP_BROOKESIA_TRACE_SCOPE("Speaker::begin");
     ESP_UTILS_CHECK_FALSE_RETURN(!checkCoreInitialized(), false, "Already initialized");
 
     // // Check if any speaker stylesheet is added, if not, add default stylesheet
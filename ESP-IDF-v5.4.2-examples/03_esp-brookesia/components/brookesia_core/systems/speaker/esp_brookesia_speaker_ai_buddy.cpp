@@ -10,6 +10,7 @@
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_speaker_utils.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "esp_brookesia_speaker_ai_buddy.hpp"
 
 #define AUDIO_EVENT_THREAD_NAME                 "audio_event"
@@ -41,6 +42,7 @@ AI_Buddy::~AI_Buddy()
 bool AI_Buddy::begin(const Data &data)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("AI_Buddy::begin");
 
     std::lock_guard lock(_mutex);
 
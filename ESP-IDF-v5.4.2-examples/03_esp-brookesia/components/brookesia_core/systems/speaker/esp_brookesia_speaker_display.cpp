@@ -9,6 +9,7 @@
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_speaker_utils.hpp"
+#include "trace/esp_brookesia_trace.hpp"
 #include "esp_brookesia_speaker_app.hpp"
 #include "esp_brookesia_speaker_display.hpp"
 
@@ -216,6 +217,15 @@ bool Display::getAppVisualArea(base::App *app, lv_area_t &app_visual_area) const
     return true;
 }
 
+base::DisplayPerfMonitor::Scene Display::getPerfScene(void) const
+{
+    if (_quick_settings.isVisible()) {
+        return {base::DisplayPerfMonitor::SceneType::QUICK_SETTINGS, -1};
+    }
+
+    return base::Display::getPerfScene();
+}
+
 bool Display::processDummyDraw(bool enable)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -233,6 +243,7 @@ bool Display::processDummyDraw(bool enable)
 bool Display::startBootAnimation(void)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("Display::startBootAnimation");
 
     _boot_animation = std::make_unique<gui::AnimPlayer>();
     ESP_UTILS_CHECK_FALSE_RETURN(_boot_animation->begin(_data.boot_animation.data), false, "Begin boot animation failed");
@@ -247,6 +258,7 @@ bool Display::startBootAnimation(void)
 bool Display::waitBootAnimationStop(void)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+    ESP_BROOKESIA_TRACE_SCOPE("Display::waitBootAnimationStop");
 
     _boot_animation_future.wait();
     _boot_animation.reset();
@@ -776,7 +776,7 @@ bool Manager::processQuickSettingsEventSignal(QuickSettings::EventData event_dat
     return true;
 }
 
-bool Manager::processQuickSettingsStorageServiceEventSignal(std::string key)
+bool Manager::processQuickSettingsStorageServiceEventSignal(const StorageKey &key)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
@@ -11,6 +11,7 @@
 #include "lvgl.h"
 #include "esp_brookesia_systems_internal.h"
 #include "systems/base/esp_brookesia_base_context.hpp"
+#include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
 #include "widgets/gesture/esp_brookesia_gesture.hpp"
 #include "esp_brookesia_speaker_ai_buddy.hpp"
 #include "esp_brookesia_speaker_display.hpp"
@@ -74,11 +75,11 @@ public:
         const gui::StyleSize screen_size, Display &display, Data &data
     );
 
-    static constexpr const char *SETTINGS_VOLUME = "volume";
-    static constexpr const char *SETTINGS_BRIGHTNESS = "brightness";
-    static constexpr const char *SETTINGS_WLAN_SWITCH = "wlan_switch";
-    static constexpr const char *SETTINGS_WLAN_SSID = "wlan_ssid";
-    static constexpr const char *SETTINGS_WLAN_PASSWORD = "wlan_password";
+    static constexpr services::StorageKey SETTINGS_VOLUME = "volume";
+    static constexpr services::StorageKey SETTINGS_BRIGHTNESS = "brightness";
+    static constexpr services::StorageKey SETTINGS_WLAN_SWITCH = "wlan_switch";
+    static constexpr services::StorageKey SETTINGS_WLAN_SSID = "wlan_ssid";
+    static constexpr services::StorageKey SETTINGS_WLAN_PASSWORD = "wlan_password";
 
     Display &display;
     const Data &data;
@@ -97,7 +98,7 @@ private:
     bool processAI_BuddyResumeTimer(void);
     bool processAppLauncherGestureEvent(lv_event_t *event);
     bool processQuickSettingsEventSignal(QuickSettings::EventData event_data);
-    bool processQuickSettingsStorageServiceEventSignal(std::string key);
+    bool processQuickSettingsStorageServiceEventSignal(const services::StorageKey &key);
     bool processQuickSettingsGesturePressEvent(lv_event_t *event);
     bool processQuickSettingsGesturePressingEvent(lv_event_t *event);
     bool processQuickSettingsGestureReleaseEvent(lv_event_t *event);
@@ -8,10 +8,18 @@
 #include "unity_test_runner.h"
 #include "unity_test_utils_memory.h"
 #include "esp_heap_caps.h"
+#include "esp_brookesia_internal.h"
+#if ESP_BROOKESIA_ENABLE_SERVICES
+#   include "services/esp_brookesia_services_internal.h"
+#endif
 
 // Some resources are lazy allocated in the LCD driver, the threadhold is left for that case
 #define TEST_MEMORY_LEAK_THRESHOLD  (300)
 
+#if ESP_BROOKESIA_ENABLE_SERVICES && ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
+extern void test_storage_nvs_setup(void);
+#endif
+
 static size_t before_free_8bit;
 static size_t before_free_32bit;
 
@@ -53,5 +61,9 @@ extern "C" void app_main(void)
     printf("| $$_____ |  \\__| $$| $$              | $$__/ $$| $$      | $$__/ $$| $$__/ $$| $$$$$$\\ | $$$$$$$$ _\\$$$$$$\\| $$|  $$$$$$$\r\n");
     printf("| $$     \\ \\$$    $$| $$              | $$    $$| $$       \\$$    $$ \\$$    $$| $$  \\$$\\ \\$$     \\|       $$| $$ \\$$    $$\r\n");
     printf(" \\$$$$$$$$  \\$$$$$$  \\$$               \\$$$$$$$  \\$$        \\$$$$$$   \\$$$$$$  \\$$   \\$$  \\$$$$$$$ \\$$$$$$$  \\$$  \\$$$$$$$\r\n");
+#if ESP_BROOKESIA_ENABLE_SERVICES && ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
+    // The service can't be stopped, it is started once outside of the leak check of the cases
+    test_storage_nvs_setup();
+#endif
     unity_run_menu();
 }
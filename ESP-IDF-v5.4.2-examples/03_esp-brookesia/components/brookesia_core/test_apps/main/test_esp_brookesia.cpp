@@ -3,6 +3,10 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_heap_caps.h"
@@ -95,6 +99,164 @@ TEST_CASE("test esp-brookesia to add stylesheet", "[esp-brookesia][phone][add_st
 }
 #endif
 
+TEST_CASE("test esp-brookesia to update only the dirty parts of widgets", "[esp-brookesia][phone][data_update]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, true);
+    const StatusBar::Data &status_bar_data = phone->getDisplay().getData().status_bar.data;
+    // Delivered at once, so that the cost of each update is measured on its own
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(false));
+    lv_refr_now(disp);
+
+    // Before: an update without ranges makes all the widgets update everything
+    phone->resetDataUpdateStats();
+    TEST_ASSERT_TRUE_MESSAGE(phone->sendDataUpdateEvent(), "Failed to send data update event");
+    systems::base::Context::DataUpdateStats full_stats = phone->getDataUpdateStats();
+    lv_refr_now(disp);
+
+    // After: a change of the status bar text color only restyles its labels
+    phone->resetDataUpdateStats();
+    TEST_ASSERT_TRUE_MESSAGE(
+        phone->sendDataUpdateEvent({{&status_bar_data.main.text_color, sizeof(status_bar_data.main.text_color)}}),
+        "Failed to send data update event"
+    );
+    systems::base::Context::DataUpdateStats dirty_stats = phone->getDataUpdateStats();
+    lv_refr_now(disp);
+
+    ESP_LOGI(TAG, "Full update: %d us, invalidated %d px; dirty update: %d us, invalidated %d px",
+             static_cast<int>(full_stats.total_time_us), static_cast<int>(full_stats.total_invalidated_px),
+             static_cast<int>(dirty_stats.total_time_us), static_cast<int>(dirty_stats.total_invalidated_px));
+    TEST_ASSERT_EQUAL(1, full_stats.dispatch_count);
+    TEST_ASSERT_EQUAL(1, dirty_stats.dispatch_count);
+    TEST_ASSERT_TRUE(dirty_stats.total_invalidated_px <= full_stats.total_invalidated_px);
+
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+
+struct TestDataUpdateRecord {
+    systems::phone::Phone *phone;
+    const StatusBar::Data *status_bar_data;
+    size_t count;
+    size_t merged_count;
+    bool is_text_color_updated;
+    bool is_background_color_updated;
+    bool is_text_font_updated;
+};
+
+static void test_data_update_record_callback(lv_event_t *event)
+{
+    TestDataUpdateRecord *record = static_cast<TestDataUpdateRecord *>(lv_event_get_user_data(event));
+    record->count++;
+    record->merged_count = record->phone->getDataUpdateMergedCount();
+    record->is_text_color_updated = record->phone->checkDataUpdated(record->status_bar_data->main.text_color);
+    record->is_background_color_updated =
+        record->phone->checkDataUpdated(record->status_bar_data->main.background_color);
+    record->is_text_font_updated = record->phone->checkDataUpdated(record->status_bar_data->main.text_font);
+}
+
+TEST_CASE("test esp-brookesia to coalesce the data updates per frame", "[esp-brookesia][phone][data_update]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+    TestDataUpdateRecord record = {};
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, true);
+    const StatusBar::Data &status_bar_data = phone->getDisplay().getData().status_bar.data;
+    const std::vector<systems::base::Context::DataUpdateRange> text_color_ranges = {
+        {&status_bar_data.main.text_color, sizeof(status_bar_data.main.text_color)}
+    };
+    const std::vector<systems::base::Context::DataUpdateRange> background_color_ranges = {
+        {&status_bar_data.main.background_color, sizeof(status_bar_data.main.background_color)}
+    };
+    record.phone = phone;
+    record.status_bar_data = &status_bar_data;
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(false));
+    TEST_ASSERT_TRUE(phone->registerDateUpdateEventCallback(test_data_update_record_callback, &record));
+
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(true));
+    phone->resetDataUpdateStats();
+    size_t coalesced_count = phone->getDataUpdateCoalescedCount();
+
+    // Sent within one frame, nothing is delivered before the next refresh
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent(text_color_ranges));
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent(text_color_ranges));
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent(background_color_ranges));
+    TEST_ASSERT_EQUAL(0, record.count);
+    TEST_ASSERT_EQUAL(0, phone->getDataUpdateStats().dispatch_count);
+
+    // Disabling the coalescing delivers the pending update like the refresh does, with the ranges merged
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(false));
+    TEST_ASSERT_EQUAL(1, record.count);
+    TEST_ASSERT_EQUAL(3, record.merged_count);
+    TEST_ASSERT_TRUE(record.is_text_color_updated);
+    TEST_ASSERT_TRUE(record.is_background_color_updated);
+    TEST_ASSERT_FALSE(record.is_text_font_updated);
+    TEST_ASSERT_EQUAL(1, phone->getDataUpdateStats().dispatch_count);
+    TEST_ASSERT_EQUAL(coalesced_count + 2, phone->getDataUpdateCoalescedCount());
+    TEST_ASSERT_EQUAL(1, phone->getDataUpdateMergedCount());
+
+    // An update without ranges makes the merged one update everything
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(true));
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent(text_color_ranges));
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent());
+    TEST_ASSERT_TRUE(phone->setDataUpdateCoalesceEnabled(false));
+    TEST_ASSERT_EQUAL(2, record.count);
+    TEST_ASSERT_EQUAL(2, record.merged_count);
+    TEST_ASSERT_TRUE(record.is_text_font_updated);
+
+    // Without coalescing, every update is delivered at once
+    TEST_ASSERT_TRUE(phone->sendDataUpdateEvent());
+    TEST_ASSERT_EQUAL(3, record.count);
+    TEST_ASSERT_EQUAL(1, record.merged_count);
+
+    TEST_ASSERT_TRUE(phone->unregisterDateUpdateEventCallback(test_data_update_record_callback, &record));
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+
+#if ESP_BROOKESIA_ENABLE_TRACE
+TEST_CASE("test esp-brookesia to trace the phone boot", "[esp-brookesia][phone][trace]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+    auto &tracer = trace::Tracer::getInstance();
+
+    test_lvgl_init(&disp, &tp);
+    tracer.reset();
+    phone = test_esp_brookesia_phone_init(disp, tp, true);
+
+    // The default stylesheet is added and activated inside `Phone::begin()`
+    std::vector<trace::Tracer::Span> spans = tracer.getSpans();
+    auto begin_it = std::find_if(spans.begin(), spans.end(), [](const trace::Tracer::Span & span) {
+        return strcmp(span.name, "Phone::begin") == 0;
+    });
+    TEST_ASSERT_TRUE(begin_it != spans.end());
+    TEST_ASSERT_TRUE(begin_it->end_us >= begin_it->begin_us);
+    auto activate_it = std::find_if(begin_it, spans.end(), [](const trace::Tracer::Span & span) {
+        return strcmp(span.name, "Stylesheet::activate") == 0;
+    });
+    TEST_ASSERT_TRUE(activate_it != spans.end());
+    TEST_ASSERT_GREATER_THAN(begin_it->depth, activate_it->depth);
+    TEST_ASSERT_TRUE((activate_it->begin_us >= begin_it->begin_us) && (activate_it->end_us <= begin_it->end_us));
+
+    std::string json;
+    TEST_ASSERT_TRUE(tracer.dumpChromeTrace(json));
+    TEST_ASSERT_TRUE(json.find("\"name\":\"Phone::begin\"") != std::string::npos);
+    tracer.dump();
+
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+#endif
+
 // TEST_CASE("test esp-brookesia to install and uninstall APPs", "[esp-brookesia][phone][install_uninstall_app]")
 // {
 //     lv_display_t *disp = nullptr;
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <map>
+#include <vector>
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_app_lru.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+struct TestAppLruApp {
+    bool is_hibernated;
+    size_t resident_bytes;      // Freed when the app is hibernated
+    size_t hibernated_bytes;    // Freed when the app is closed
+};
+
+TEST_CASE("test esp-brookesia app lru to keep the usage order", "[esp-brookesia][app][lru]")
+{
+    AppLru lru;
+
+    TEST_ASSERT_EQUAL(-1, lru.getLeastRecentlyUsed(-1));
+
+    lru.touch(1);
+    lru.touch(2);
+    lru.touch(3);
+    // A resume moves the app to the most recently used end
+    lru.touch(1);
+    TEST_ASSERT_EQUAL(3, lru.getIds().size());
+    TEST_ASSERT_EQUAL(2, lru.getIds()[0]);
+    TEST_ASSERT_EQUAL(3, lru.getIds()[1]);
+    TEST_ASSERT_EQUAL(1, lru.getIds()[2]);
+
+    TEST_ASSERT_EQUAL(2, lru.getLeastRecentlyUsed(-1));
+    TEST_ASSERT_EQUAL(3, lru.getLeastRecentlyUsed(2));
+    TEST_ASSERT_EQUAL(1, lru.getLeastRecentlyUsed(-1, [](int id) {
+        return id == 1;
+    }));
+    TEST_ASSERT_EQUAL(-1, lru.getLeastRecentlyUsed(-1, [](int id) {
+        return false;
+    }));
+
+    lru.remove(3);
+    lru.remove(4);
+    TEST_ASSERT_EQUAL(2, lru.getIds().size());
+    TEST_ASSERT_EQUAL(2, lru.getLeastRecentlyUsed(1));
+    TEST_ASSERT_EQUAL(-1, lru.getLeastRecentlyUsed(-1, [](int id) {
+        return id == 3;
+    }));
+
+    lru.clear();
+    TEST_ASSERT_EQUAL(0, lru.getIds().size());
+}
+
+TEST_CASE("test esp-brookesia app lru to pick the apps to evict", "[esp-brookesia][app][lru]")
+{
+    AppLru lru;
+    std::map<int, bool> hibernated_apps = {{1, true}, {2, false}, {3, true}, {4, false}, {5, false}};
+    auto is_hibernated = [&hibernated_apps](int id) {
+        return hibernated_apps.at(id);
+    };
+
+    for (int id : {1, 2, 3, 4, 5}) {
+        lru.touch(id);
+    }
+
+    // The resident apps go first, even though older hibernated apps exist
+    TEST_ASSERT_EQUAL(2, lru.getEvictionCandidate(5, is_hibernated));
+    // The active app is never picked, even if it is the least recently used one
+    TEST_ASSERT_EQUAL(4, lru.getEvictionCandidate(2, is_hibernated));
+    // Only the active app is resident, the hibernated apps follow in LRU order
+    hibernated_apps[2] = true;
+    hibernated_apps[4] = true;
+    TEST_ASSERT_EQUAL(1, lru.getEvictionCandidate(5, is_hibernated));
+    lru.touch(1);
+    TEST_ASSERT_EQUAL(2, lru.getEvictionCandidate(5, is_hibernated));
+    // Nothing but the active app
+    lru.clear();
+    lru.touch(5);
+    TEST_ASSERT_EQUAL(-1, lru.getEvictionCandidate(5, is_hibernated));
+    TEST_ASSERT_EQUAL(5, lru.getEvictionCandidate(-1, is_hibernated));
+}
+
+TEST_CASE("test esp-brookesia app lru to evict the apps until the watermark is met", "[esp-brookesia][app][lru]")
+{
+    // Same loop as `Manager::processMemoryPressure()`: the resident apps are hibernated, the hibernated ones closed
+    AppLru lru;
+    std::map<int, TestAppLruApp> apps = {
+        {1, {true, 0, 10}},
+        {2, {false, 100, 10}},
+        {3, {false, 100, 10}},
+        {4, {true, 0, 10}},
+        {5, {false, 100, 10}},
+    };
+    auto is_hibernated = [&apps](int id) {
+        return apps.at(id).is_hibernated;
+    };
+    const int active_id = 3;
+    std::vector<int> evicted_ids;
+    auto evict_until = [&](size_t free_bytes, size_t watermark_bytes) {
+        int id = -1;
+        while ((free_bytes < watermark_bytes) && ((id = lru.getEvictionCandidate(active_id, is_hibernated)) != -1)) {
+            TestAppLruApp &app = apps.at(id);
+            evicted_ids.push_back(id);
+            if (!app.is_hibernated) {
+                app.is_hibernated = true;
+                free_bytes += app.resident_bytes;
+            } else {
+                free_bytes += app.hibernated_bytes;
+                lru.remove(id);
+            }
+        }
+        return free_bytes;
+    };
+
+    // The active app is the least recently used one, it must be skipped anyway
+    for (int id : {3, 1, 2, 4, 5}) {
+        lru.touch(id);
+    }
+
+    // One resident app is enough
+    TEST_ASSERT_EQUAL(100, evict_until(0, 100));
+    TEST_ASSERT_EQUAL(1, evicted_ids.size());
+    TEST_ASSERT_EQUAL(2, evicted_ids[0]);
+
+    // Then the last resident app, before any hibernated one
+    evicted_ids.clear();
+    TEST_ASSERT_EQUAL(110, evict_until(0, 110));
+    TEST_ASSERT_EQUAL(2, evicted_ids.size());
+    TEST_ASSERT_EQUAL(5, evicted_ids[0]);
+    TEST_ASSERT_EQUAL(1, evicted_ids[1]);
+
+    // Nothing can meet the watermark, everything but the active app is closed, in LRU order
+    evicted_ids.clear();
+    TEST_ASSERT_EQUAL(30, evict_until(0, 1000));
+    TEST_ASSERT_EQUAL(3, evicted_ids.size());
+    TEST_ASSERT_EQUAL(2, evicted_ids[0]);
+    TEST_ASSERT_EQUAL(4, evicted_ids[1]);
+    TEST_ASSERT_EQUAL(5, evicted_ids[2]);
+    TEST_ASSERT_EQUAL(1, lru.getIds().size());
+    TEST_ASSERT_EQUAL(active_id, lru.getIds()[0]);
+    TEST_ASSERT_FALSE(apps.at(active_id).is_hibernated);
+}
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_app_memory.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_APP_MEMORY_CAPACITY    (64)
+#define TEST_APP_MEMORY_LOAD_NUM    (TEST_APP_MEMORY_CAPACITY / 4 * 3)
+
+static void *get_test_ptr(uintptr_t index)
+{
+    // Fake heap blocks, close to each other so that they collide in the table
+    return reinterpret_cast<void *>(0x3FC80000 + index * 16);
+}
+
+TEST_CASE("test esp-brookesia app memory tracker to attribute the allocations", "[esp-brookesia][app][memory]")
+{
+    AppMemoryTracker tracker;
+    AppMemoryTracker::Usage usage;
+
+    TEST_ASSERT_FALSE(tracker.begin(0));
+    // Rounded up to a power of 2
+    TEST_ASSERT_TRUE(tracker.begin(TEST_APP_MEMORY_CAPACITY - 1));
+    TEST_ASSERT_EQUAL(TEST_APP_MEMORY_CAPACITY, tracker.getCapacity());
+    tracker.del();
+    TEST_ASSERT_TRUE(tracker.begin(TEST_APP_MEMORY_CAPACITY));
+    TEST_ASSERT_EQUAL(TEST_APP_MEMORY_CAPACITY, tracker.getCapacity());
+
+    // No owner, nothing is attributed
+    tracker.recordAlloc(get_test_ptr(0), 100, false);
+    TEST_ASSERT_FALSE(tracker.getUsage(1, usage));
+
+    tracker.setOwner(1);
+    tracker.recordAlloc(get_test_ptr(1), 100, false);
+    tracker.recordAlloc(get_test_ptr(2), 1000, true);
+    tracker.recordAlloc(get_test_ptr(3), 50, false);
+    // The allocations of another thread are not the app's own
+    std::thread([&tracker]() {
+        tracker.recordAlloc(get_test_ptr(4), 10, false);
+    }).join();
+    tracker.setOwner(2);
+    tracker.recordAlloc(get_test_ptr(5), 20, false);
+    tracker.setOwner(-1);
+
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(150, usage.sram_bytes);
+    TEST_ASSERT_EQUAL(1000, usage.psram_bytes);
+    TEST_ASSERT_EQUAL(3, usage.alloc_count);
+
+    // Freed after the app lost the ownership, and by anyone, it is still credited back to the app
+    std::thread([&tracker]() {
+        tracker.recordFree(get_test_ptr(1));
+    }).join();
+    tracker.recordFree(get_test_ptr(2));
+    tracker.recordFree(get_test_ptr(4));
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(50, usage.sram_bytes);
+    TEST_ASSERT_EQUAL(0, usage.psram_bytes);
+    TEST_ASSERT_EQUAL(150, usage.sram_peak_bytes);
+    TEST_ASSERT_EQUAL(1000, usage.psram_peak_bytes);
+    TEST_ASSERT_EQUAL(1, usage.alloc_count);
+    tracker.resetPeak(1);
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(50, usage.sram_peak_bytes);
+    TEST_ASSERT_EQUAL(0, usage.psram_peak_bytes);
+
+    // A block resized in place is charged with its new size only
+    tracker.setOwner(2);
+    tracker.recordAlloc(get_test_ptr(5), 200, false);
+    TEST_ASSERT_TRUE(tracker.getUsage(2, usage));
+    TEST_ASSERT_EQUAL(200, usage.sram_bytes);
+    TEST_ASSERT_EQUAL(1, usage.alloc_count);
+    tracker.recordFree(get_test_ptr(5));
+    tracker.setOwner(-1);
+
+    tracker.del();
+    TEST_ASSERT_FALSE(tracker.getUsage(1, usage));
+}
+
+TEST_CASE("test esp-brookesia app memory tracker to keep the table consistent", "[esp-brookesia][app][memory]")
+{
+    AppMemoryTracker tracker;
+    AppMemoryTracker::Usage usage;
+    std::vector<uintptr_t> alive;
+
+    TEST_ASSERT_TRUE(tracker.begin(TEST_APP_MEMORY_CAPACITY));
+    tracker.setOwner(1);
+
+    // Fill the table, the allocations beyond its load are not attributed
+    for (uintptr_t i = 0; i < TEST_APP_MEMORY_CAPACITY; i++) {
+        tracker.recordAlloc(get_test_ptr(i), 1, false);
+    }
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(TEST_APP_MEMORY_LOAD_NUM, usage.alloc_count);
+    TEST_ASSERT_EQUAL(TEST_APP_MEMORY_CAPACITY - TEST_APP_MEMORY_LOAD_NUM, tracker.getUntrackedCount());
+
+    // Free every other block, then every remaining one must still be found
+    for (uintptr_t i = 0; i < TEST_APP_MEMORY_LOAD_NUM; i++) {
+        if (i % 2) {
+            tracker.recordFree(get_test_ptr(i));
+        } else {
+            alive.push_back(i);
+        }
+    }
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(alive.size(), usage.alloc_count);
+    for (auto i : alive) {
+        tracker.recordFree(get_test_ptr(i));
+    }
+    TEST_ASSERT_TRUE(tracker.getUsage(1, usage));
+    TEST_ASSERT_EQUAL(0, usage.alloc_count);
+    TEST_ASSERT_EQUAL(0, usage.sram_bytes);
+
+    // The slot of an app without allocations is reused by a new app, and no app is attributed once they are all taken
+    size_t untracked_count = tracker.getUntrackedCount();
+    for (int id = 2; id < static_cast<int>(AppMemoryTracker::APP_NUM_MAX) + 3; id++) {
+        tracker.setOwner(id);
+        tracker.recordAlloc(get_test_ptr(id), 1, false);
+    }
+    tracker.setOwner(-1);
+    TEST_ASSERT_FALSE(tracker.getUsage(1, usage));
+    TEST_ASSERT_TRUE(tracker.getUsage(AppMemoryTracker::APP_NUM_MAX + 1, usage));
+    TEST_ASSERT_EQUAL(1, usage.sram_bytes);
+    TEST_ASSERT_FALSE(tracker.getUsage(AppMemoryTracker::APP_NUM_MAX + 2, usage));
+    TEST_ASSERT_EQUAL(untracked_count + 1, tracker.getUntrackedCount());
+}
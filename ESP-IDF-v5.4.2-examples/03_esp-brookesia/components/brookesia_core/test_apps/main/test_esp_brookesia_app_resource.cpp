@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
+#include <vector>
+#include "esp_log.h"
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_app_resource.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_APP_RESOURCE_BENCHMARK_ROUNDS          (10)
+#define TEST_APP_RESOURCE_BENCHMARK_BACKGROUND_NUM  (200)
+
+static const char *TAG = "test_esp_brookesia_app_resource";
+
+/**
+ * @brief Stand-in for an LVGL timer, linked at the head of a global list like `lv_timer_create()` does
+ */
+struct TestResource {
+    TestResource *prev;
+    TestResource *next;
+    void *cb;
+    void *user_data;
+};
+
+class TestResourceList {
+public:
+    ~TestResourceList()
+    {
+        while (_head != nullptr) {
+            remove(_head);
+        }
+    }
+
+    TestResource *create(void *cb, void *user_data)
+    {
+        TestResource *resource = new TestResource{nullptr, _head, cb, user_data};
+        if (_head != nullptr) {
+            _head->prev = resource;
+        }
+        _head = resource;
+        _count++;
+        return resource;
+    }
+
+    void remove(TestResource *resource)
+    {
+        if (resource->prev != nullptr) {
+            resource->prev->next = resource->next;
+        } else {
+            _head = resource->next;
+        }
+        if (resource->next != nullptr) {
+            resource->next->prev = resource->prev;
+        }
+        _count--;
+        delete resource;
+    }
+
+    TestResource *getNext(TestResource *resource) const
+    {
+        return (resource == nullptr) ? _head : resource->next;
+    }
+
+    size_t getCount(void) const
+    {
+        return _count;
+    }
+
+private:
+    TestResource *_head = nullptr;
+    size_t _count = 0;
+};
+
+/**
+ * @brief Reference copy of the previous recording design, which cross-references the global list with a `std::list`
+ *        and a `std::map`, and restarts from the head after each deletion
+ */
+class TestListWalkRecorder {
+public:
+    void start(TestResourceList &list)
+    {
+        _head = list.getNext(nullptr);
+    }
+
+    void end(TestResourceList &list)
+    {
+        for (TestResource *node = list.getNext(nullptr); (node != nullptr) && (node != _head); node = list.getNext(node)) {
+            _map[node] = {node->cb, node->user_data};
+            if (std::find(_resources.begin(), _resources.end(), node) == _resources.end()) {
+                _resources.push_back(node);
+            }
+        }
+    }
+
+    size_t clean(TestResourceList &list)
+    {
+        size_t count = 0;
+        TestResource *node = list.getNext(nullptr);
+        while ((node != nullptr) && (_resources.size() > 0)) {
+            bool do_clean = false;
+            auto it = std::find(_resources.begin(), _resources.end(), node);
+            if (it != _resources.end()) {
+                auto map_it = _map.find(node);
+                if ((map_it->second.first == node->cb) && (map_it->second.second == node->user_data)) {
+                    list.remove(node);
+                    do_clean = true;
+                    count++;
+                }
+                _resources.erase(it);
+                _map.erase(map_it);
+            }
+            node = do_clean ? list.getNext(nullptr) : list.getNext(node);
+        }
+        return count;
+    }
+
+private:
+    TestResource *_head = nullptr;
+    std::list<TestResource *> _resources;
+    std::map<TestResource *, std::pair<void *, void *>> _map;
+};
+
+/**
+ * @brief Same flow as `App` with the tracker, for timers which have no delete hook. Screens and animations don't even
+ *        need the pass over the global list
+ */
+class TestTrackerRecorder {
+public:
+    void start(TestResourceList &list)
+    {
+        _head = list.getNext(nullptr);
+    }
+
+    void end(TestResourceList &list)
+    {
+        bool is_new = false;
+        for (TestResource *node = list.getNext(nullptr); (node != nullptr) && (node != _head); node = list.getNext(node)) {
+            _tracker.attach(AppResourceTracker::Type::TIMER, node, node->cb, node->user_data, is_new);
+        }
+    }
+
+    size_t clean(TestResourceList &list)
+    {
+        size_t count = 0;
+        TestResource *next = nullptr;
+        for (TestResource *node = list.getNext(nullptr); node != nullptr; node = next) {
+            next = list.getNext(node);
+            AppResourceTracker::Node *tracker_node = AppResourceTracker::find(node);
+            if ((tracker_node != nullptr) && (tracker_node->owner == &_tracker) && (node->cb == tracker_node->tags[0]) &&
+                    (node->user_data == tracker_node->tags[1])) {
+                AppResourceTracker::detach(node);
+                list.remove(node);
+                count++;
+            }
+        }
+        _tracker.reset(AppResourceTracker::Type::TIMER);
+        return count;
+    }
+
+private:
+    TestResource *_head = nullptr;
+    AppResourceTracker _tracker;
+};
+
+template <typename T>
+static int64_t test_app_resource_benchmark(size_t resource_num)
+{
+    TestResourceList list;
+    T recorder;
+    int cb = 0;
+    int64_t elapsed_ns = 0;
+    std::vector<TestResource *> later_resources;
+
+    for (size_t i = 0; i < TEST_APP_RESOURCE_BENCHMARK_BACKGROUND_NUM / 2; i++) {
+        list.create(&cb, nullptr);
+    }
+    for (int round = 0; round < TEST_APP_RESOURCE_BENCHMARK_ROUNDS; round++) {
+        auto start = std::chrono::steady_clock::now();
+        recorder.start(list);
+        for (size_t i = 0; i < resource_num; i++) {
+            list.create(&cb, &recorder);
+        }
+        recorder.end(list);
+        elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        // The system keeps creating resources while the app runs, such as the ones of the launcher once it is left
+        for (size_t i = 0; i < TEST_APP_RESOURCE_BENCHMARK_BACKGROUND_NUM / 2; i++) {
+            later_resources.push_back(list.create(&cb, nullptr));
+        }
+
+        start = std::chrono::steady_clock::now();
+        TEST_ASSERT_EQUAL(resource_num, recorder.clean(list));
+        elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto resource : later_resources) {
+            list.remove(resource);
+        }
+        later_resources.clear();
+    }
+    TEST_ASSERT_EQUAL(TEST_APP_RESOURCE_BENCHMARK_BACKGROUND_NUM / 2, list.getCount());
+
+    return elapsed_ns;
+}
+
+static int test_app_resource_unhook_count = 0;
+
+static void test_app_resource_unhook(const AppResourceTracker::Node &node)
+{
+    test_app_resource_unhook_count++;
+}
+
+TEST_CASE("test esp-brookesia app resource tracker to attach, detach and release", "[esp-brookesia][app][resource]")
+{
+    AppResourceTracker tracker;
+    AppResourceTracker other_tracker;
+    int resources[4] = {};
+    int tag = 0;
+    bool is_new = false;
+
+    // Attach, then attach again only updates the tags
+    AppResourceTracker::Node *node = tracker.attach(AppResourceTracker::Type::SCREEN, &resources[0], nullptr, nullptr, is_new);
+    TEST_ASSERT_NOT_NULL(node);
+    TEST_ASSERT_TRUE(is_new);
+    node->unhook = test_app_resource_unhook;
+    TEST_ASSERT_TRUE(node == tracker.attach(AppResourceTracker::Type::SCREEN, &resources[0], &tag, nullptr, is_new));
+    TEST_ASSERT_FALSE(is_new);
+    TEST_ASSERT_TRUE(node->tags[0] == &tag);
+    TEST_ASSERT_EQUAL(1, tracker.getCount(AppResourceTracker::Type::SCREEN));
+
+    // A resource belongs to a single tracker
+    TEST_ASSERT_NULL(other_tracker.attach(AppResourceTracker::Type::SCREEN, &resources[0], nullptr, nullptr, is_new));
+    TEST_ASSERT_TRUE(AppResourceTracker::find(&resources[0])->owner == &tracker);
+
+    // The delete hook detaches without unhooking
+    for (int i = 1; i < 4; i++) {
+        node = tracker.attach(AppResourceTracker::Type::SCREEN, &resources[i], nullptr, nullptr, is_new);
+        node->unhook = test_app_resource_unhook;
+    }
+    TEST_ASSERT_TRUE(AppResourceTracker::detach(&resources[2]));
+    TEST_ASSERT_FALSE(AppResourceTracker::detach(&resources[2]));
+    TEST_ASSERT_EQUAL(3, tracker.getCount(AppResourceTracker::Type::SCREEN));
+    TEST_ASSERT_EQUAL(0, test_app_resource_unhook_count);
+
+    // Deleting a resource may fire the hook of another one, like a screen deleting its sibling
+    std::vector<void *> released;
+    size_t count = tracker.release(AppResourceTracker::Type::SCREEN, [&](const AppResourceTracker::Node & node) {
+        released.push_back(node.handle);
+        if (node.handle == &resources[0]) {
+            AppResourceTracker::detach(&resources[3]);
+        }
+        return true;
+    });
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(2, released.size());
+    TEST_ASSERT_TRUE((released[0] == &resources[0]) && (released[1] == &resources[1]));
+    TEST_ASSERT_EQUAL(2, test_app_resource_unhook_count);
+    TEST_ASSERT_EQUAL(0, tracker.getCount(AppResourceTracker::Type::SCREEN));
+    TEST_ASSERT_NULL(AppResourceTracker::find(&resources[3]));
+
+    // Once released, the resource can be attached by another tracker, and it is released with the tracker
+    TEST_ASSERT_NOT_NULL(other_tracker.attach(AppResourceTracker::Type::TIMER, &resources[0], nullptr, nullptr, is_new));
+    TEST_ASSERT_EQUAL(1, other_tracker.getCount(AppResourceTracker::Type::TIMER));
+    other_tracker.reset();
+    TEST_ASSERT_NULL(AppResourceTracker::find(&resources[0]));
+
+    // A node without delete hook is taken over once its memory is reused with other tags
+    TEST_ASSERT_NOT_NULL(tracker.attach(AppResourceTracker::Type::TIMER, &resources[1], &tag, nullptr, is_new));
+    TEST_ASSERT_NULL(other_tracker.attach(AppResourceTracker::Type::TIMER, &resources[1], &tag, nullptr, is_new));
+    TEST_ASSERT_NOT_NULL(other_tracker.attach(AppResourceTracker::Type::TIMER, &resources[1], nullptr, &tag, is_new));
+    TEST_ASSERT_TRUE(is_new);
+    TEST_ASSERT_EQUAL(0, tracker.getCount(AppResourceTracker::Type::TIMER));
+    TEST_ASSERT_EQUAL(1, other_tracker.getCount(AppResourceTracker::Type::TIMER));
+}
+
+TEST_CASE("test esp-brookesia app resource record and clean benchmark", "[esp-brookesia][app][resource][benchmark]")
+{
+    for (size_t resource_num : {
+                10, 100, 500
+            }) {
+        int64_t list_walk_ns = test_app_resource_benchmark<TestListWalkRecorder>(resource_num);
+        int64_t tracker_ns = test_app_resource_benchmark<TestTrackerRecorder>(resource_num);
+
+        ESP_LOGI(TAG, "Resources(%d) among %d others: list walk %d us/transition, tracker %d us/transition",
+                 static_cast<int>(resource_num), TEST_APP_RESOURCE_BENCHMARK_BACKGROUND_NUM,
+                 static_cast<int>(list_walk_ns / TEST_APP_RESOURCE_BENCHMARK_ROUNDS / 1000),
+                 static_cast<int>(tracker_ns / TEST_APP_RESOURCE_BENCHMARK_ROUNDS / 1000));
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_app_snapshot.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_APP_SNAPSHOT_UNIT_SIZE     (2)
+#define TEST_APP_SNAPSHOT_UNIT_NUM      (1000)
+#define TEST_APP_SNAPSHOT_DATA_SIZE     (TEST_APP_SNAPSHOT_UNIT_SIZE * TEST_APP_SNAPSHOT_UNIT_NUM)
+
+static void test_app_snapshot_round_trip(const std::vector<uint8_t> &data, size_t unit_size)
+{
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> decoded(data.size(), 0);
+
+    AppSnapshotCodec::encode(data.data(), data.size(), unit_size, encoded);
+    TEST_ASSERT_TRUE(AppSnapshotCodec::decode(encoded, unit_size, decoded.data(), decoded.size()));
+    TEST_ASSERT_EQUAL_MEMORY(data.data(), decoded.data(), data.size());
+}
+
+TEST_CASE("test esp-brookesia app snapshot codec to round-trip the data", "[esp-brookesia][app][snapshot]")
+{
+    std::vector<uint8_t> data(TEST_APP_SNAPSHOT_DATA_SIZE, 0x5A);
+    std::vector<uint8_t> encoded;
+
+    // Flat, split into blocks of the max run length
+    AppSnapshotCodec::encode(data.data(), data.size(), TEST_APP_SNAPSHOT_UNIT_SIZE, encoded);
+    TEST_ASSERT_EQUAL(
+        (TEST_APP_SNAPSHOT_UNIT_NUM + AppSnapshotCodec::BLOCK_UNIT_NUM_MAX - 1) / AppSnapshotCodec::BLOCK_UNIT_NUM_MAX *
+        (1 + TEST_APP_SNAPSHOT_UNIT_SIZE), encoded.size()
+    );
+    test_app_snapshot_round_trip(data, TEST_APP_SNAPSHOT_UNIT_SIZE);
+
+    // Runs and literals mixed, of every length around the block limit
+    size_t pos = 0;
+    for (size_t len = 1; pos < data.size(); len = (len % (AppSnapshotCodec::BLOCK_UNIT_NUM_MAX + 2)) + 1) {
+        bool is_run = (len % 2 == 0);
+        for (size_t i = 0; (i < len) && (pos < data.size()); i++, pos++) {
+            data[pos] = is_run ? static_cast<uint8_t>(len) : static_cast<uint8_t>(pos * 7 + i);
+        }
+    }
+    test_app_snapshot_round_trip(data, TEST_APP_SNAPSHOT_UNIT_SIZE);
+    test_app_snapshot_round_trip(data, 1);
+    test_app_snapshot_round_trip(data, 4);
+
+    // Random
+    srand(1);
+    for (auto &value : data) {
+        value = static_cast<uint8_t>(rand() % 4);
+    }
+    test_app_snapshot_round_trip(data, 1);
+    test_app_snapshot_round_trip(data, TEST_APP_SNAPSHOT_UNIT_SIZE);
+
+    // Nothing to encode
+    AppSnapshotCodec::encode(data.data(), 0, TEST_APP_SNAPSHOT_UNIT_SIZE, encoded);
+    TEST_ASSERT_EQUAL(0, encoded.size());
+}
+
+TEST_CASE("test esp-brookesia app snapshot codec in the worst case", "[esp-brookesia][app][snapshot]")
+{
+    std::vector<uint8_t> data(TEST_APP_SNAPSHOT_DATA_SIZE);
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> decoded(TEST_APP_SNAPSHOT_DATA_SIZE);
+
+    // No two neighbour units are equal, only literal blocks with one control byte each. It is larger than the data,
+    // so the manager keeps such a snapshot uncompressed
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i / TEST_APP_SNAPSHOT_UNIT_SIZE);
+    }
+    AppSnapshotCodec::encode(data.data(), data.size(), TEST_APP_SNAPSHOT_UNIT_SIZE, encoded);
+    TEST_ASSERT_EQUAL(
+        TEST_APP_SNAPSHOT_DATA_SIZE +
+        (TEST_APP_SNAPSHOT_UNIT_NUM + AppSnapshotCodec::BLOCK_UNIT_NUM_MAX - 1) / AppSnapshotCodec::BLOCK_UNIT_NUM_MAX,
+        encoded.size()
+    );
+    test_app_snapshot_round_trip(data, TEST_APP_SNAPSHOT_UNIT_SIZE);
+
+    // The corrupted data and the too small outputs are rejected
+    TEST_ASSERT_FALSE(AppSnapshotCodec::decode(encoded, TEST_APP_SNAPSHOT_UNIT_SIZE, decoded.data(), decoded.size() - 1));
+    encoded.pop_back();
+    TEST_ASSERT_FALSE(AppSnapshotCodec::decode(encoded, TEST_APP_SNAPSHOT_UNIT_SIZE, decoded.data(), decoded.size()));
+    encoded = {AppSnapshotCodec::RUN_FLAG | 0x7F, 0x00, 0x00};
+    TEST_ASSERT_TRUE(AppSnapshotCodec::decode(encoded, TEST_APP_SNAPSHOT_UNIT_SIZE, decoded.data(), decoded.size()));
+    encoded.pop_back();
+    TEST_ASSERT_FALSE(AppSnapshotCodec::decode(encoded, TEST_APP_SNAPSHOT_UNIT_SIZE, decoded.data(), decoded.size()));
+
+    // With 1-byte units, a literal unit followed by a pair is the most expensive: 2 control bytes for 3 units
+    data.resize(TEST_APP_SNAPSHOT_DATA_SIZE / 3 * 3);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>((i % 3 == 0) ? (i / 3 * 2) : (i / 3 * 2 + 1));
+    }
+    AppSnapshotCodec::encode(data.data(), data.size(), 1, encoded);
+    TEST_ASSERT_EQUAL(data.size() / 3 * 4, encoded.size());
+    test_app_snapshot_round_trip(data, 1);
+}
+
+TEST_CASE("test esp-brookesia app snapshot budget to evict the least recently viewed", "[esp-brookesia][app][snapshot]")
+{
+    AppSnapshotBudget budget;
+
+    budget.update(1, 100);
+    budget.update(2, 100);
+    budget.update(3, 100);
+    budget.update(4, 100);
+    TEST_ASSERT_EQUAL(400, budget.getStoredBytes());
+
+    // No limit
+    TEST_ASSERT_EQUAL(0, budget.trim(0, 4).size());
+
+    // Viewed, then saved again with a new size, they become the most recent ones
+    TEST_ASSERT_TRUE(budget.touch(1));
+    TEST_ASSERT_FALSE(budget.touch(5));
+    budget.update(2, 50);
+    TEST_ASSERT_EQUAL(350, budget.getStoredBytes());
+
+    std::vector<int> evicted_ids = budget.trim(200, 4);
+    TEST_ASSERT_EQUAL(2, evicted_ids.size());
+    TEST_ASSERT_EQUAL(3, evicted_ids[0]);
+    TEST_ASSERT_EQUAL(1, evicted_ids[1]);
+    TEST_ASSERT_EQUAL(150, budget.getStoredBytes());
+    TEST_ASSERT_EQUAL(2, budget.getCount());
+    TEST_ASSERT_EQUAL(2, budget.getEvictedCount());
+
+    // The kept snapshot stays even if it alone exceeds the budget
+    budget.update(4, 500);
+    evicted_ids = budget.trim(200, 4);
+    TEST_ASSERT_EQUAL(1, evicted_ids.size());
+    TEST_ASSERT_EQUAL(2, evicted_ids[0]);
+    TEST_ASSERT_EQUAL(500, budget.getStoredBytes());
+    TEST_ASSERT_EQUAL(1, budget.getCount());
+
+    // Without a snapshot to keep, the last one goes too
+    evicted_ids = budget.trim(200, -1);
+    TEST_ASSERT_EQUAL(1, evicted_ids.size());
+    TEST_ASSERT_EQUAL(0, budget.getStoredBytes());
+    TEST_ASSERT_EQUAL(4, budget.getEvictedCount());
+
+    // Released ones are not evicted
+    budget.update(6, 100);
+    budget.update(7, 100);
+    budget.remove(6);
+    TEST_ASSERT_EQUAL(100, budget.getStoredBytes());
+    TEST_ASSERT_EQUAL(0, budget.trim(100, -1).size());
+    budget.clear();
+    TEST_ASSERT_EQUAL(0, budget.getCount());
+    TEST_ASSERT_EQUAL(0, budget.getStoredBytes());
+}
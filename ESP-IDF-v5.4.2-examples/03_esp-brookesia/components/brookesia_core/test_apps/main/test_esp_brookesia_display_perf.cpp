@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_display_perf.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_DISPLAY_PERF_SAMPLE_NUM    (100)
+#define TEST_DISPLAY_PERF_TARGET_FPS    (50)
+#define TEST_DISPLAY_PERF_PERIOD_US     (20 * 1000)
+
+TEST_CASE("test esp-brookesia display perf monitor to split the frames by scene", "[esp-brookesia][display][perf]")
+{
+    DisplayPerfMonitor monitor(TEST_DISPLAY_PERF_SAMPLE_NUM, TEST_DISPLAY_PERF_TARGET_FPS);
+    const DisplayPerfMonitor::Scene page_0 = {DisplayPerfMonitor::SceneType::MAIN, 0};
+    const DisplayPerfMonitor::Scene app = {DisplayPerfMonitor::SceneType::APP, 3};
+    DisplayPerfMonitor::Report report;
+    int64_t time_us = 0;
+
+    TEST_ASSERT_EQUAL(TEST_DISPLAY_PERF_PERIOD_US, monitor.getFrameBudgetUs());
+
+    // Render time 1..100 ms, flush always 1 ms
+    for (int i = 1; i <= 100; i++) {
+        monitor.recordFrame(page_0, time_us, {i * 1000, 1000, 100});
+        time_us += TEST_DISPLAY_PERF_PERIOD_US;
+    }
+    TEST_ASSERT_TRUE(monitor.getReport(page_0, report));
+    TEST_ASSERT_EQUAL(100, report.frame_count);
+    TEST_ASSERT_EQUAL(50 * 1000, report.render_us.p50);
+    TEST_ASSERT_EQUAL(90 * 1000, report.render_us.p90);
+    TEST_ASSERT_EQUAL(99 * 1000, report.render_us.p99);
+    TEST_ASSERT_EQUAL(100 * 1000, report.render_us.max);
+    TEST_ASSERT_EQUAL(1000, report.flush_us.p99);
+    TEST_ASSERT_EQUAL(51 * 1000, report.frame_us.p50);
+    TEST_ASSERT_EQUAL(100, report.avg_invalidated_px);
+    TEST_ASSERT_EQUAL(50, static_cast<int>(report.fps + 0.5f));
+    // Frames of 2 to 101 ms, the ones of 21 to 40 ms drop 1 frame, 41 to 60 ms drop 2, and so on
+    TEST_ASSERT_EQUAL(20 * (1 + 2 + 3 + 4) + 5, report.dropped_count);
+
+    // An idle gap and a scene switch are not counted as animating time
+    time_us += DisplayPerfMonitor::IDLE_GAP_US * 2;
+    monitor.recordFrame(app, time_us, {1000, 1000, 10});
+    time_us += TEST_DISPLAY_PERF_PERIOD_US * 2;
+    monitor.recordFrame(app, time_us, {1000, 1000, 30});
+    TEST_ASSERT_TRUE(monitor.getReport(app, report));
+    TEST_ASSERT_EQUAL(2, report.frame_count);
+    TEST_ASSERT_EQUAL(0, report.dropped_count);
+    TEST_ASSERT_EQUAL(20, report.avg_invalidated_px);
+    TEST_ASSERT_EQUAL(25, static_cast<int>(report.fps + 0.5f));
+    TEST_ASSERT_TRUE(monitor.getLastScene() == app);
+    TEST_ASSERT_EQUAL(2, monitor.getReports().size());
+
+    // The percentiles only cover the last frames
+    for (int i = 0; i < TEST_DISPLAY_PERF_SAMPLE_NUM; i++) {
+        time_us += TEST_DISPLAY_PERF_PERIOD_US;
+        monitor.recordFrame(page_0, time_us, {1000, 0, 0});
+    }
+    TEST_ASSERT_TRUE(monitor.getReport(page_0, report));
+    TEST_ASSERT_EQUAL(200, report.frame_count);
+    TEST_ASSERT_EQUAL(1000, report.render_us.max);
+    monitor.dump();
+
+    monitor.reset();
+    TEST_ASSERT_FALSE(monitor.getReport(page_0, report));
+    TEST_ASSERT_EQUAL(0, monitor.getReports().size());
+}
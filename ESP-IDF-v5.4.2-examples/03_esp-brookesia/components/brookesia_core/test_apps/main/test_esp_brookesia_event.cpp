@@ -0,0 +1,377 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include "esp_log.h"
+#include "unity.h"
+#include "systems/base/esp_brookesia_base_event.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_EVENT_BENCHMARK_ROUNDS     (100)
+#define TEST_EVENT_BENCHMARK_ID_NUM     (4)
+#define TEST_EVENT_POST_PRODUCER_NUM    (4)
+#define TEST_EVENT_POST_EVENT_NUM       (500)
+#define TEST_EVENT_CHURN_OBJECT_NUM     (1000)
+#define TEST_EVENT_CHURN_LIVE_NUM       (8)
+#define TEST_EVENT_CHURN_CAPACITY_MAX   (64)    // Enough for the live objects and their tombstones
+
+static const char *TAG = "test_esp_brookesia_event";
+
+/**
+ * @brief Reference copy of the previous nested map design, only used to compare the dispatch cost. `sendEvent()` is
+ *        kept out of line like the original implementation
+ */
+class TestNestedMapEvent {
+public:
+    bool registerEvent(void *object, Event::Handler handler, Event::ID id, void *user_data = nullptr)
+    {
+        _event_handlers[object][id].emplace_back(handler, user_data);
+        return true;
+    }
+
+    __attribute__((noinline)) bool sendEvent(void *object, Event::ID id, void *param = nullptr) const
+    {
+        auto object_it = _event_handlers.find(object);
+        if (object_it == _event_handlers.end()) {
+            return true;
+        }
+        auto handler_it = object_it->second.find(id);
+        if (handler_it == object_it->second.end()) {
+            return true;
+        }
+
+        bool ret = true;
+        for (auto &handler_data_pair : handler_it->second) {
+            if (!handler_data_pair.first({id, object, param, handler_data_pair.second, 1})) {
+                ret = false;
+            }
+        }
+        return ret;
+    }
+
+private:
+    std::unordered_map<void *, std::unordered_map<Event::ID, std::vector<std::pair<Event::Handler, void *>>>> _event_handlers;
+};
+
+static bool test_event_count_handler(const Event::HandlerData &data)
+{
+    (*static_cast<int *>(data.user_data))++;
+    return true;
+}
+
+static bool test_event_unregister_self_handler(const Event::HandlerData &data)
+{
+    static_cast<Event *>(data.user_data)->unregisterEvent(data.object);
+    return true;
+}
+
+struct TestPostRecord {
+    std::chrono::steady_clock::time_point post_time;
+    std::chrono::steady_clock::time_point handle_time;
+    int handled_count;
+};
+
+static bool test_event_post_handler(const Event::HandlerData &data)
+{
+    auto record = static_cast<TestPostRecord *>(data.param);
+    record->handle_time = std::chrono::steady_clock::now();
+    record->handled_count++;
+    (*static_cast<int *>(data.user_data))++;
+    return true;
+}
+
+template <typename T>
+static int64_t test_event_benchmark(T &event, std::vector<int> &objects, size_t handlers_num)
+{
+    int count = 0;
+    for (size_t i = 0; i < handlers_num; i++) {
+        event.registerEvent(&objects[i % objects.size()], test_event_count_handler,
+                            static_cast<Event::ID>(i % TEST_EVENT_BENCHMARK_ID_NUM), &count);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < TEST_EVENT_BENCHMARK_ROUNDS; round++) {
+        for (auto &object : objects) {
+            for (int id = 0; id < TEST_EVENT_BENCHMARK_ID_NUM; id++) {
+                event.sendEvent(&object, static_cast<Event::ID>(id));
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL(handlers_num * TEST_EVENT_BENCHMARK_ROUNDS, count);
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+TEST_CASE("test esp-brookesia event to register, send and unregister", "[esp-brookesia][event][dispatch]")
+{
+    Event event;
+    int object_0 = 0;
+    int object_1 = 0;
+    int count = 0;
+
+    TEST_ASSERT_TRUE(event.registerEvent(&object_0, test_event_count_handler, Event::ID::APP, &count));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_0, test_event_count_handler, Event::ID::NAVIGATION, &count));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_1, test_event_count_handler, Event::ID::APP, &count));
+    TEST_ASSERT_FALSE(event.registerEvent(&object_1, nullptr, Event::ID::APP));
+
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::APP));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::STYLESHEET));
+    TEST_ASSERT_EQUAL(1, count);
+
+    event.unregisterEvent(&object_0);
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::APP));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_1, Event::ID::APP));
+    TEST_ASSERT_EQUAL(2, count);
+
+    ESP_LOGI(TAG, "Reuse a released slot and stop dispatching once the object is unregistered");
+    TEST_ASSERT_TRUE(event.registerEvent(&object_0, test_event_unregister_self_handler, Event::ID::CUSTOM, &event));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_0, test_event_count_handler, Event::ID::CUSTOM, &count));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::CUSTOM));
+    TEST_ASSERT_EQUAL(2, count);
+
+    event.unregisterEvent(&object_1, test_event_count_handler, Event::ID::APP);
+    TEST_ASSERT_TRUE(event.sendEvent(&object_1, Event::ID::APP));
+    TEST_ASSERT_EQUAL(2, count);
+}
+
+TEST_CASE("test esp-brookesia event to unregister by handler and ID and recycle IDs", "[esp-brookesia][event][unregister]")
+{
+    Event event;
+    std::vector<int> objects(TEST_EVENT_BENCHMARK_ROUNDS);
+    int count = 0;
+
+    Event::ID custom_id_0 = event.getFreeEventID();
+    Event::ID custom_id_1 = event.getFreeEventID();
+    TEST_ASSERT_TRUE(custom_id_0 != custom_id_1);
+    for (auto &object : objects) {
+        TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_count_handler, custom_id_0, &count));
+        TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_post_handler, custom_id_1, &count));
+        TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_count_handler, Event::ID::APP, &count));
+    }
+
+    ESP_LOGI(TAG, "Remove a handler from every object");
+    event.unregisterEvent(test_event_post_handler);
+    for (auto &object : objects) {
+        TEST_ASSERT_TRUE(event.sendEvent(&object, custom_id_1));
+    }
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_TRUE(event.getFreeEventID() == custom_id_1);
+
+    ESP_LOGI(TAG, "Remove an ID from every object, the other IDs are kept");
+    event.unregisterEvent(custom_id_0);
+    for (auto &object : objects) {
+        TEST_ASSERT_TRUE(event.sendEvent(&object, custom_id_0));
+        TEST_ASSERT_TRUE(event.sendEvent(&object, Event::ID::APP));
+    }
+    TEST_ASSERT_EQUAL(objects.size(), count);
+    TEST_ASSERT_TRUE(event.getFreeEventID() == custom_id_0);
+
+    ESP_LOGI(TAG, "Built-in IDs are never recycled");
+    event.unregisterEvent(Event::ID::APP);
+    TEST_ASSERT_TRUE(event.getFreeEventID() > custom_id_1);
+}
+
+TEST_CASE("test esp-brookesia event to keep the object table bounded under churn", "[esp-brookesia][event][unregister]")
+{
+    Event event;
+    std::vector<int> objects(TEST_EVENT_CHURN_OBJECT_NUM);
+    int count = 0;
+
+    // Like the apps opening and closing, only a few objects are registered at a time but each one is new
+    for (size_t i = 0; i < objects.size(); i++) {
+        TEST_ASSERT_TRUE(event.registerEvent(&objects[i], test_event_count_handler, Event::ID::APP, &count));
+        if (i >= TEST_EVENT_CHURN_LIVE_NUM) {
+            event.unregisterEvent(&objects[i - TEST_EVENT_CHURN_LIVE_NUM]);
+        }
+        TEST_ASSERT_LESS_OR_EQUAL(TEST_EVENT_CHURN_CAPACITY_MAX, event.getObjectSlotTableCapacity());
+    }
+    for (size_t i = objects.size() - TEST_EVENT_CHURN_LIVE_NUM; i < objects.size(); i++) {
+        TEST_ASSERT_TRUE(event.sendEvent(&objects[i], Event::ID::APP));
+    }
+    TEST_ASSERT_EQUAL(TEST_EVENT_CHURN_LIVE_NUM, count);
+    TEST_ASSERT_TRUE(event.sendEvent(&objects[0], Event::ID::APP));
+    TEST_ASSERT_EQUAL(TEST_EVENT_CHURN_LIVE_NUM, count);
+}
+
+TEST_CASE("test esp-brookesia event dispatch benchmark", "[esp-brookesia][event][benchmark]")
+{
+    for (size_t handlers_num : {
+                10, 100, 1000
+            }) {
+        std::vector<int> objects(handlers_num / TEST_EVENT_BENCHMARK_ID_NUM + 1);
+        size_t dispatch_num = objects.size() * TEST_EVENT_BENCHMARK_ID_NUM * TEST_EVENT_BENCHMARK_ROUNDS;
+
+        TestNestedMapEvent nested_map_event;
+        int64_t nested_map_ns = test_event_benchmark(nested_map_event, objects, handlers_num);
+
+        Event event;
+        int64_t event_ns = test_event_benchmark(event, objects, handlers_num);
+
+        ESP_LOGI(TAG, "Handlers(%d): nested map %d ns/dispatch, dense slots %d ns/dispatch", static_cast<int>(handlers_num),
+                 static_cast<int>(nested_map_ns / dispatch_num), static_cast<int>(event_ns / dispatch_num));
+    }
+}
+
+TEST_CASE("test esp-brookesia event to post from multiple threads", "[esp-brookesia][event][post]")
+{
+    Event event;
+    int object = 0;
+    int count = 0;
+    std::vector<TestPostRecord> records(TEST_EVENT_POST_PRODUCER_NUM * TEST_EVENT_POST_EVENT_NUM);
+    std::atomic<int> retry_count = 0;
+
+    TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_post_handler, Event::ID::CUSTOM, &count));
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < TEST_EVENT_POST_PRODUCER_NUM; i++) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < TEST_EVENT_POST_EVENT_NUM; j++) {
+                auto &record = records[i * TEST_EVENT_POST_EVENT_NUM + j];
+                record.post_time = std::chrono::steady_clock::now();
+                while (!event.postEvent(&object, Event::ID::CUSTOM, &record)) {
+                    retry_count++;
+                    std::this_thread::yield();
+                    record.post_time = std::chrono::steady_clock::now();
+                }
+            }
+        });
+    }
+
+    // Act as the GUI thread, drain one batch per "frame"
+    size_t batch_num = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (count < static_cast<int>(records.size())) {
+        event.processPostedEvents();
+        batch_num++;
+        TEST_ASSERT_TRUE_MESSAGE(std::chrono::steady_clock::now() - start < std::chrono::seconds(10), "Drain timeout");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    TEST_ASSERT_EQUAL(0, event.processPostedEvents());
+    TEST_ASSERT_EQUAL(retry_count.load(), event.getPostDroppedCount());
+
+    std::vector<int64_t> latencies_us;
+    for (auto &record : records) {
+        TEST_ASSERT_EQUAL_MESSAGE(1, record.handled_count, "Event lost or duplicated");
+        latencies_us.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(record.handle_time - record.post_time).count()
+        );
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    ESP_LOGI(TAG, "Posted(%d) batches(%d) full retries(%d): post->handle latency p50 %d us, p99 %d us, max %d us",
+             static_cast<int>(records.size()), static_cast<int>(batch_num), retry_count.load(),
+             static_cast<int>(latencies_us[latencies_us.size() / 2]),
+             static_cast<int>(latencies_us[latencies_us.size() * 99 / 100]), static_cast<int>(latencies_us.back()));
+}
+
+static bool test_event_coalesce_handler(const Event::HandlerData &data)
+{
+    auto record = static_cast<std::vector<std::pair<void *, size_t>> *>(data.user_data);
+    record->emplace_back(data.param, data.merged_count);
+    return true;
+}
+
+TEST_CASE("test esp-brookesia event to coalesce posted events", "[esp-brookesia][event][coalesce]")
+{
+    Event event;
+    int object_0 = 0;
+    int object_1 = 0;
+    int params[3] = {};
+    std::vector<std::pair<void *, size_t>> record_0;
+    std::vector<std::pair<void *, size_t>> record_1;
+
+    TEST_ASSERT_TRUE(event.registerEvent(&object_0, test_event_coalesce_handler, Event::ID::CUSTOM, &record_0));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_1, test_event_coalesce_handler, Event::ID::CUSTOM, &record_1));
+
+    ESP_LOGI(TAG, "Without coalescing, every posted event is delivered");
+    TEST_ASSERT_TRUE(event.postEvent(&object_0, Event::ID::CUSTOM, &params[0]));
+    TEST_ASSERT_TRUE(event.postEvent(&object_0, Event::ID::CUSTOM, &params[1]));
+    TEST_ASSERT_EQUAL(2, event.processPostedEvents());
+    TEST_ASSERT_EQUAL(2, record_0.size());
+    TEST_ASSERT_EQUAL(1, record_0[1].second);
+    record_0.clear();
+
+    ESP_LOGI(TAG, "With coalescing, events with the same object and ID are delivered once with the latest param");
+    event.setCoalesceEnabled(true);
+    for (auto &param : params) {
+        TEST_ASSERT_TRUE(event.postEvent(&object_0, Event::ID::CUSTOM, &param));
+    }
+    TEST_ASSERT_TRUE(event.postEvent(&object_1, Event::ID::CUSTOM, &params[0]));
+    TEST_ASSERT_EQUAL(4, event.processPostedEvents());
+    TEST_ASSERT_EQUAL(1, record_0.size());
+    TEST_ASSERT_TRUE(record_0[0].first == &params[2]);
+    TEST_ASSERT_EQUAL(3, record_0[0].second);
+    TEST_ASSERT_EQUAL(1, record_1.size());
+    TEST_ASSERT_EQUAL(1, record_1[0].second);
+    TEST_ASSERT_EQUAL(2, event.getCoalescedCount());
+
+    ESP_LOGI(TAG, "Sent events are never coalesced");
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::CUSTOM, &params[0]));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_0, Event::ID::CUSTOM, &params[1]));
+    TEST_ASSERT_EQUAL(3, record_0.size());
+
+    event.reset();
+    TEST_ASSERT_EQUAL(0, event.getCoalescedCount());
+}
+
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_PROFILING
+static bool test_event_slow_handler(const Event::HandlerData &data)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(*static_cast<int *>(data.param)));
+    return true;
+}
+
+TEST_CASE("test esp-brookesia event profiling", "[esp-brookesia][event][profile]")
+{
+    Event event;
+    int object = 0;
+    int count = 0;
+    int sleep_us = 2000;
+
+    TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_count_handler, Event::ID::APP, &count));
+    TEST_ASSERT_TRUE(event.registerEvent(&object, test_event_slow_handler, Event::ID::NAVIGATION));
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(event.sendEvent(&object, Event::ID::APP));
+    }
+    TEST_ASSERT_TRUE(event.sendEvent(&object, Event::ID::NAVIGATION, &sleep_us));
+    TEST_ASSERT_TRUE(event.sendEvent(&object, Event::ID::STYLESHEET));
+
+    TEST_ASSERT_EQUAL(10, event.getDispatchCount(Event::ID::APP));
+    TEST_ASSERT_EQUAL(1, event.getDispatchCount(Event::ID::NAVIGATION));
+    TEST_ASSERT_EQUAL(1, event.getDispatchCount(Event::ID::STYLESHEET));
+    TEST_ASSERT_EQUAL(0, event.getDispatchCount(Event::ID::CUSTOM));
+
+    auto count_profile = event.getHandlerProfile(test_event_count_handler);
+    TEST_ASSERT_NOT_NULL(count_profile);
+    TEST_ASSERT_EQUAL(10, count_profile->call_count);
+    size_t histogram_total = 0;
+    for (auto bucket : count_profile->histogram) {
+        histogram_total += bucket;
+    }
+    TEST_ASSERT_EQUAL(10, histogram_total);
+
+    ESP_LOGI(TAG, "The slow handler is reported as the worst offender");
+    auto slow_profile = event.getHandlerProfile(test_event_slow_handler);
+    TEST_ASSERT_NOT_NULL(slow_profile);
+    TEST_ASSERT_TRUE(slow_profile->max_us >= sleep_us);
+    TEST_ASSERT_TRUE(slow_profile->max_id == Event::ID::NAVIGATION);
+    TEST_ASSERT_TRUE(event.getWorstHandler() == test_event_slow_handler);
+    event.dump();
+
+    event.resetProfile();
+    TEST_ASSERT_EQUAL(0, event.getDispatchCount(Event::ID::APP));
+    TEST_ASSERT_NULL(event.getHandlerProfile(test_event_count_handler));
+    TEST_ASSERT_NULL(event.getWorstHandler());
+}
+#endif
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "unity.h"
+#include "gui/lvgl/esp_brookesia_lv_lock.hpp"
+
+using namespace esp_brookesia::gui;
+
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+#define TEST_LV_LOCK_LONG_HOLD_MS   (ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS + 20)
+
+static const LvLock::SiteStats *find_site_stats(const std::vector<LvLock::SiteStats> &stats, int line)
+{
+    for (auto &site_stats : stats) {
+        if (site_stats.site.line == line) {
+            return &site_stats;
+        }
+    }
+
+    return nullptr;
+}
+
+TEST_CASE("test esp-brookesia lvgl lock to profile the call sites", "[esp-brookesia][gui][lock]")
+{
+    static std::recursive_timed_mutex test_mutex;
+    LvLock &lv_lock = LvLock::getInstance();
+    int hold_line = 0;
+    int wait_line = 0;
+    int fail_line = 0;
+
+    LvLock::registerCallbacks([](int timeout_ms) {
+        if (timeout_ms < 0) {
+            test_mutex.lock();
+            return true;
+        }
+        return test_mutex.try_lock_for(std::chrono::milliseconds(timeout_ms));
+    }, []() {
+        test_mutex.unlock();
+        return true;
+    });
+    lv_lock.resetSiteStats();
+
+    std::thread waiter;
+    {
+        hold_line = __LINE__ + 1;
+        LvLockGuard guard;
+        // Nested locks are part of the outermost hold
+        {
+            LvLockGuard nested_guard;
+        }
+        std::thread([&]() {
+            fail_line = __LINE__ + 1;
+            TEST_ASSERT_FALSE(lv_lock.lock(1));
+        }).join();
+        waiter = std::thread([&]() {
+            wait_line = __LINE__ + 1;
+            LvLockGuard waiter_guard;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_LV_LOCK_LONG_HOLD_MS));
+    }
+    waiter.join();
+
+    std::vector<LvLock::SiteStats> stats = lv_lock.getSiteStats();
+    lv_lock.dump();
+    TEST_ASSERT_EQUAL(3, stats.size());
+
+    const LvLock::SiteStats *hold_stats = find_site_stats(stats, hold_line);
+    TEST_ASSERT_NOT_NULL(hold_stats);
+    // The longest hold comes first
+    TEST_ASSERT_TRUE(hold_stats == &stats[0]);
+    TEST_ASSERT_EQUAL(1, hold_stats->lock_count);
+    TEST_ASSERT_EQUAL(1, hold_stats->long_hold_count);
+    TEST_ASSERT_TRUE(hold_stats->hold_max_us >= TEST_LV_LOCK_LONG_HOLD_MS * 1000);
+
+    const LvLock::SiteStats *wait_stats = find_site_stats(stats, wait_line);
+    TEST_ASSERT_NOT_NULL(wait_stats);
+    TEST_ASSERT_EQUAL(1, wait_stats->lock_count);
+    TEST_ASSERT_TRUE(wait_stats->wait_max_us >= ESP_BROOKESIA_LVGL_LOCK_LONG_HOLD_MS * 1000);
+    TEST_ASSERT_EQUAL(0, wait_stats->long_hold_count);
+
+    const LvLock::SiteStats *fail_stats = find_site_stats(stats, fail_line);
+    TEST_ASSERT_NOT_NULL(fail_stats);
+    TEST_ASSERT_EQUAL(0, fail_stats->lock_count);
+    TEST_ASSERT_EQUAL(1, fail_stats->fail_count);
+
+    lv_lock.resetSiteStats();
+    TEST_ASSERT_EQUAL(0, lv_lock.getSiteStats().size());
+    LvLock::registerCallbacks(nullptr, nullptr);
+}
+#endif
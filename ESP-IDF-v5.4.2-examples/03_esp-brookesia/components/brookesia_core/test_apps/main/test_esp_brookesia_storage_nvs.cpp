@@ -0,0 +1,624 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <future>
+#include <thread>
+#include "esp_log.h"
+#include "unity.h"
+#include "esp_brookesia_internal.h"
+#if ESP_BROOKESIA_ENABLE_SERVICES
+#   include "services/esp_brookesia_services_internal.h"
+#endif
+
+#if ESP_BROOKESIA_ENABLE_SERVICES && ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
+#include "nvs.h"
+#include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+
+using namespace esp_brookesia::services;
+
+#define TEST_STORAGE_NVS_NAMESPACE          "test_storage"
+#define TEST_STORAGE_NVS_KEY_INT            "test_int"
+#define TEST_STORAGE_NVS_KEY_STR            "test_str"
+#define TEST_STORAGE_NVS_KEY_FLOAT          "test_float"
+#define TEST_STORAGE_NVS_KEY_INT64          "test_int64"
+#define TEST_STORAGE_NVS_KEY_BLOB           "test_blob"
+#define TEST_STORAGE_NVS_KEY_U32            "test_u32"
+#define TEST_STORAGE_NVS_KEY_U64            "test_u64"
+#define TEST_STORAGE_NVS_KEY_LONG_STR       "test_long_str"
+#define TEST_STORAGE_NVS_LONG_STR_LEN       (300)
+#define TEST_STORAGE_NVS_KEY_WRITE_BACK     "test_wb"
+#define TEST_STORAGE_NVS_KEY_TOO_LONG_STR   "test_too_long"
+#define TEST_STORAGE_NVS_TOO_LONG_STR_LEN   (5000)   // NVS strings are limited to 4000 bytes
+#define TEST_STORAGE_NVS_KEY_LAZY           "test_lazy"
+#define TEST_STORAGE_NVS_KEY_LAZY_MISSING   "test_lazy_miss"
+#define TEST_STORAGE_NVS_SERVICE_NAMESPACE  ESP_BROOKESIA_STORAGE_NVS_NAMESPACE
+#define TEST_STORAGE_NVS_BENCHMARK_READS    (10000)
+#define TEST_STORAGE_NVS_BENCHMARK_WRITES   (20)
+
+// The cases erase everything they write, the parameters of the device must not be in the same namespace
+static_assert(std::string_view(TEST_STORAGE_NVS_SERVICE_NAMESPACE) != "storage", "Use a dedicated test namespace");
+
+static const char *TAG = "test_esp_brookesia_storage_nvs";
+
+static bool is_storage_nvs_begun = false;
+
+static bool test_storage_nvs_begin()
+{
+    return is_storage_nvs_begun;
+}
+
+static bool test_storage_nvs_set(const StorageNVS::Key &key, const StorageNVS::Value &value)
+{
+    StorageNVS::EventFuture future;
+    if (!StorageNVS::requestInstance().setLocalParam(key, value, nullptr, &future)) {
+        return false;
+    }
+
+    return future.get();
+}
+
+/**
+ * @brief Erase everything the case has written, from NVS and from the local parameters of the service
+ */
+static bool test_storage_nvs_end()
+{
+    StorageNVS::EventFuture future;
+    if (!StorageNVS::requestInstance().eraseNVS(nullptr, &future) || !future.get()) {
+        return false;
+    }
+
+    nvs_handle_t nvs_handle;
+    if (nvs_open(TEST_STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle) != ESP_OK) {
+        return false;
+    }
+    bool ret = (nvs_erase_all(nvs_handle) == ESP_OK) && (nvs_commit(nvs_handle) == ESP_OK);
+    nvs_close(nvs_handle);
+
+    return ret;
+}
+
+/**
+ * @brief Called by `app_main()` before the test menu. The worker of the service, the NVS caches and the namespaces are
+ *        allocated once for all the cases, so that the leak check of a case only sees what the case left behind
+ */
+void test_storage_nvs_setup(void)
+{
+    if (!StorageNVS::requestInstance().begin()) {
+        ESP_LOGE(TAG, "Begin storage NVS failed");
+        return;
+    }
+    // Warm up the write path, and start from empty namespaces
+    is_storage_nvs_begun = test_storage_nvs_set(TEST_STORAGE_NVS_KEY_INT, 0) && test_storage_nvs_end();
+    if (!is_storage_nvs_begun) {
+        ESP_LOGE(TAG, "Warm up storage NVS failed");
+    }
+}
+
+/**
+ * @brief Read path of `StorageNVS` before the snapshot: a `std::string` key and a lock shared with the worker, which
+ *        holds it while writing NVS
+ */
+class TestLockedParams {
+public:
+    bool get(const std::string &key, StorageNVS::Value &value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _params.find(key);
+        if (it == _params.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    bool set(const std::string &key, const StorageNVS::Value &value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _params[key] = value;
+
+        nvs_handle_t nvs_handle;
+        if (nvs_open(TEST_STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle) != ESP_OK) {
+            return false;
+        }
+        bool ret = (nvs_set_i32(nvs_handle, key.c_str(), std::get<int>(value)) == ESP_OK) &&
+                   (nvs_commit(nvs_handle) == ESP_OK);
+        nvs_close(nvs_handle);
+        return ret;
+    }
+
+private:
+    std::mutex _mutex;
+    std::map<std::string, StorageNVS::Value> _params;
+};
+
+class TestSnapshotParams {
+public:
+    bool get(const StorageNVS::Key &key, StorageNVS::Value &value)
+    {
+        return StorageNVS::requestInstance().getLocalParam(key, value);
+    }
+
+    bool set(const StorageNVS::Key &key, const StorageNVS::Value &value)
+    {
+        return test_storage_nvs_set(key, value);
+    }
+};
+
+template <typename T>
+static void test_storage_nvs_benchmark(T &params, bool with_writer, int64_t &read_avg_ns, int64_t &read_max_ns)
+{
+    std::atomic<bool> is_writing = with_writer;
+    bool is_written = true;
+    std::thread writer;
+    int64_t read_total_ns = 0;
+    int read_count = 0;
+
+    TEST_ASSERT_TRUE(params.set(TEST_STORAGE_NVS_KEY_INT, 0));
+    if (with_writer) {
+        writer = std::thread([&]() {
+            for (int i = 1; i <= TEST_STORAGE_NVS_BENCHMARK_WRITES; i++) {
+                is_written = is_written && params.set(TEST_STORAGE_NVS_KEY_INT, i);
+            }
+            is_writing = false;
+        });
+    }
+
+    read_max_ns = 0;
+    // Read until the writer is done, so that every read may meet a write
+    do {
+        for (int i = 0; i < TEST_STORAGE_NVS_BENCHMARK_READS; i++) {
+            StorageNVS::Value value;
+            auto start = std::chrono::steady_clock::now();
+            bool ret = params.get(TEST_STORAGE_NVS_KEY_INT, value);
+            int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start
+                                 ).count();
+            TEST_ASSERT_TRUE(ret);
+            read_total_ns += elapsed_ns;
+            read_max_ns = std::max(read_max_ns, elapsed_ns);
+            read_count++;
+        }
+    } while (is_writing);
+
+    if (writer.joinable()) {
+        writer.join();
+    }
+    TEST_ASSERT_TRUE(is_written);
+    read_avg_ns = read_total_ns / read_count;
+}
+
+TEST_CASE("test esp-brookesia storage nvs to read the local params from a snapshot", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Value value;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_INT, 1));
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_STR, std::string("first")));
+
+    // The snapshot held by a reader is never changed by the writers
+    auto params = storage.getLocalParams();
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_INT, 2));
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_STR, std::string("second")));
+    TEST_ASSERT_EQUAL(1, std::get<int>(params->find(TEST_STORAGE_NVS_KEY_INT)->second));
+    TEST_ASSERT_EQUAL_STRING("first", std::get<std::string>(params->find(TEST_STORAGE_NVS_KEY_STR)->second).c_str());
+
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_INT, value));
+    TEST_ASSERT_EQUAL(2, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(StorageKey(std::string_view(TEST_STORAGE_NVS_KEY_STR)), value));
+    TEST_ASSERT_EQUAL_STRING("second", std::get<std::string>(value).c_str());
+    TEST_ASSERT_FALSE(storage.getLocalParam("test_none", value));
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs to store the float, int64 and blob values", "[esp-brookesia][services][storage]")
+{
+    const uint8_t blob_data[] = {0x01, 0x02, 0x03, 0xFF};
+    const int64_t value_int64 = (1LL << 40) + 1;
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Value value;
+    StorageNVS::Value other_value;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    TEST_ASSERT_FALSE(storage.setLocalParam(TEST_STORAGE_NVS_KEY_BLOB, StorageNVS::Blob()));
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_FLOAT, 1.5f));
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_INT64, value_int64));
+    TEST_ASSERT_TRUE(test_storage_nvs_set(
+                         TEST_STORAGE_NVS_KEY_BLOB, StorageNVS::makeBlob(blob_data, sizeof(blob_data))
+                     ));
+
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_FLOAT, value));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, std::get<float>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_INT64, value));
+    TEST_ASSERT_TRUE(std::get<int64_t>(value) == value_int64);
+    // The readers share the same buffer
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_BLOB, value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_BLOB, other_value));
+    TEST_ASSERT_TRUE(std::get<StorageNVS::Blob>(value) == std::get<StorageNVS::Blob>(other_value));
+    TEST_ASSERT_EQUAL(sizeof(blob_data), std::get<StorageNVS::Blob>(value)->size());
+    TEST_ASSERT_EQUAL_MEMORY(blob_data, std::get<StorageNVS::Blob>(value)->data(), sizeof(blob_data));
+
+    // Written by someone else, then loaded back from NVS with their types. The integers which are not tagged floats
+    // are not taken for floats
+    nvs_handle_t nvs_handle;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open(TEST_STORAGE_NVS_SERVICE_NAMESPACE, NVS_READWRITE, &nvs_handle));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_i64(nvs_handle, TEST_STORAGE_NVS_KEY_INT64, -value_int64));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_blob(nvs_handle, TEST_STORAGE_NVS_KEY_BLOB, blob_data, 2));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u32(nvs_handle, TEST_STORAGE_NVS_KEY_U32, 0x3FC00000));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u64(nvs_handle, TEST_STORAGE_NVS_KEY_U64, 0x3FC00000));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(nvs_handle));
+    nvs_close(nvs_handle);
+    StorageNVS::EventFuture future;
+    TEST_ASSERT_TRUE(storage.sendEvent({.operation = StorageNVS::Operation::UpdateParam}, &future));
+    TEST_ASSERT_TRUE(future.get());
+
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_FLOAT, value));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, std::get<float>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_INT64, value));
+    TEST_ASSERT_TRUE(std::get<int64_t>(value) == -value_int64);
+    TEST_ASSERT_FALSE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_U32, value));
+    TEST_ASSERT_FALSE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_U64, value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_BLOB, value));
+    TEST_ASSERT_EQUAL(2, std::get<StorageNVS::Blob>(value)->size());
+    TEST_ASSERT_EQUAL_MEMORY(blob_data, std::get<StorageNVS::Blob>(value)->data(), 2);
+    // The previous snapshot still holds the previous buffer
+    TEST_ASSERT_EQUAL(sizeof(blob_data), std::get<StorageNVS::Blob>(other_value)->size());
+
+    // The readers don't keep the replaced snapshots, a replaced buffer is freed once the values read are dropped
+    std::weak_ptr<const std::vector<uint8_t>> stored_blob = std::get<StorageNVS::Blob>(value);
+    value = 0;
+    other_value = 0;
+    TEST_ASSERT_TRUE(test_storage_nvs_set(
+                         TEST_STORAGE_NVS_KEY_BLOB, StorageNVS::makeBlob(blob_data, sizeof(blob_data))
+                     ));
+    TEST_ASSERT_TRUE(stored_blob.expired());
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs to load the strings with their stored length", "[esp-brookesia][services][storage]")
+{
+    const std::string long_str(TEST_STORAGE_NVS_LONG_STR_LEN, 'x');
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Value value;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+
+    // Longer than the buffer the strings used to be read with
+    nvs_handle_t nvs_handle;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open(TEST_STORAGE_NVS_SERVICE_NAMESPACE, NVS_READWRITE, &nvs_handle));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_str(nvs_handle, TEST_STORAGE_NVS_KEY_LONG_STR, long_str.c_str()));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(nvs_handle));
+    nvs_close(nvs_handle);
+    StorageNVS::EventFuture future;
+    TEST_ASSERT_TRUE(storage.sendEvent({.operation = StorageNVS::Operation::UpdateParam}, &future));
+    TEST_ASSERT_TRUE(future.get());
+
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_LONG_STR, value));
+    TEST_ASSERT_EQUAL(TEST_STORAGE_NVS_LONG_STR_LEN, std::get<std::string>(value).size());
+    TEST_ASSERT_EQUAL_STRING(long_str.c_str(), std::get<std::string>(value).c_str());
+
+    // Too long for NVS, the write fails and the string is not kept in memory
+    TEST_ASSERT_FALSE(test_storage_nvs_set(
+                          TEST_STORAGE_NVS_KEY_TOO_LONG_STR, std::string(TEST_STORAGE_NVS_TOO_LONG_STR_LEN, 'x')
+                      ));
+    TEST_ASSERT_FALSE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_TOO_LONG_STR, value));
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK || ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+static bool test_storage_nvs_get_stored_int(const char *key, int32_t &value)
+{
+    nvs_handle_t nvs_handle;
+    if (nvs_open(TEST_STORAGE_NVS_SERVICE_NAMESPACE, NVS_READONLY, &nvs_handle) != ESP_OK) {
+        return false;
+    }
+    bool ret = (nvs_get_i32(nvs_handle, key, &value) == ESP_OK);
+    nvs_close(nvs_handle);
+
+    return ret;
+}
+#endif
+
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_WRITE_BACK
+
+TEST_CASE("test esp-brookesia storage nvs to coalesce the writes of the write-back window", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture futures[3];
+    int32_t stored_value = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_WRITE_BACK, 0));
+    storage.resetWriteStats();
+
+    // Only the last value of the window is written, with a single commit
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(storage.setLocalParam(TEST_STORAGE_NVS_KEY_WRITE_BACK, i + 1, nullptr, &futures[i]));
+    }
+    // Not committed before the end of the window
+    TEST_ASSERT_TRUE(futures[0].wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+    for (auto &future : futures) {
+        TEST_ASSERT_TRUE(future.get());
+    }
+    // Resolved once the value is in NVS
+    TEST_ASSERT_TRUE(test_storage_nvs_get_stored_int(TEST_STORAGE_NVS_KEY_WRITE_BACK, stored_value));
+    TEST_ASSERT_EQUAL(3, stored_value);
+
+    auto stats = storage.getWriteStats();
+    TEST_ASSERT_EQUAL(3, stats.request_count);
+    TEST_ASSERT_EQUAL(1, stats.key_write_count);
+    TEST_ASSERT_EQUAL(1, stats.commit_count);
+    TEST_ASSERT_EQUAL(2, stats.coalesced_count);
+    TEST_ASSERT_EQUAL(2 * sizeof(int32_t), stats.saved_bytes);
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs to flush the pending writes", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture write_future;
+    StorageNVS::EventFuture flush_future;
+    int32_t stored_value = 0;
+    int updated_count = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    auto connection = storage.connectEventSignal([&](const StorageNVS::Event & event) {
+        if ((event.operation == StorageNVS::Operation::UpdateNVS) && (event.key == TEST_STORAGE_NVS_KEY_WRITE_BACK)) {
+            updated_count++;
+        }
+    });
+    storage.resetWriteStats();
+
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_STORAGE_NVS_KEY_WRITE_BACK, 10, nullptr, &write_future));
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &flush_future));
+    // The pending write is committed before the flush is done, whatever is left of the window
+    TEST_ASSERT_TRUE(flush_future.get());
+    TEST_ASSERT_TRUE(write_future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready);
+    TEST_ASSERT_TRUE(write_future.get());
+    TEST_ASSERT_TRUE(test_storage_nvs_get_stored_int(TEST_STORAGE_NVS_KEY_WRITE_BACK, stored_value));
+    TEST_ASSERT_EQUAL(10, stored_value);
+    TEST_ASSERT_EQUAL(1, updated_count);
+
+    // Nothing pending, nothing written
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &flush_future));
+    TEST_ASSERT_TRUE(flush_future.get());
+    connection.disconnect();
+
+    auto stats = storage.getWriteStats();
+    TEST_ASSERT_EQUAL(1, stats.request_count);
+    TEST_ASSERT_EQUAL(1, stats.key_write_count);
+    TEST_ASSERT_EQUAL(1, stats.commit_count);
+    TEST_ASSERT_EQUAL(0, stats.coalesced_count);
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs to skip a bad key of the write-back batch", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture bad_future;
+    StorageNVS::EventFuture good_future;
+    StorageNVS::EventFuture flush_future;
+    StorageNVS::Value value;
+    int32_t stored_value = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    storage.resetWriteStats();
+
+    // Too long for NVS, the other key of the batch is still committed
+    TEST_ASSERT_TRUE(storage.setLocalParam(
+                         TEST_STORAGE_NVS_KEY_TOO_LONG_STR, std::string(TEST_STORAGE_NVS_TOO_LONG_STR_LEN, 'x'), nullptr,
+                         &bad_future
+                     ));
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_STORAGE_NVS_KEY_WRITE_BACK, 20, nullptr, &good_future));
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &flush_future));
+    TEST_ASSERT_FALSE(flush_future.get());
+    TEST_ASSERT_FALSE(bad_future.get());
+    TEST_ASSERT_TRUE(good_future.get());
+    TEST_ASSERT_TRUE(test_storage_nvs_get_stored_int(TEST_STORAGE_NVS_KEY_WRITE_BACK, stored_value));
+    TEST_ASSERT_EQUAL(20, stored_value);
+    // Not kept in memory either
+    TEST_ASSERT_FALSE(storage.getLocalParam(TEST_STORAGE_NVS_KEY_TOO_LONG_STR, value));
+
+    // The bad key is dropped rather than retried
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &flush_future));
+    TEST_ASSERT_TRUE(flush_future.get());
+    auto stats = storage.getWriteStats();
+    TEST_ASSERT_EQUAL(1, stats.key_write_count);
+    TEST_ASSERT_EQUAL(1, stats.commit_count);
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+#endif
+
+#if ESP_BROOKESIA_STORAGE_NVS_ENABLE_LAZY_LOAD
+static bool test_storage_nvs_set_stored_int(const StorageNVS::Key &key, int32_t value)
+{
+    nvs_handle_t nvs_handle;
+    if (nvs_open(TEST_STORAGE_NVS_SERVICE_NAMESPACE, NVS_READWRITE, &nvs_handle) != ESP_OK) {
+        return false;
+    }
+    bool ret = (nvs_set_i32(nvs_handle, key.c_str(), value) == ESP_OK) && (nvs_commit(nvs_handle) == ESP_OK);
+    nvs_close(nvs_handle);
+
+    return ret;
+}
+
+/**
+ * @brief Hold the worker in the signal of a flush until `release_future` is ready, so that the events sent meanwhile
+ *        stay queued
+ */
+static boost::signals2::connection test_storage_nvs_hold_worker(
+    const std::shared_future<void> &release_future, StorageNVS::EventFuture &flush_future
+)
+{
+    static int holder = 0;
+    auto &storage = StorageNVS::requestInstance();
+    auto connection = storage.connectEventSignal([release_future](const StorageNVS::Event & event) {
+        if (event.sender == &holder) {
+            release_future.wait();
+        }
+    });
+    TEST_ASSERT_TRUE(storage.flush(&holder, &flush_future));
+
+    return connection;
+}
+
+TEST_CASE("test esp-brookesia storage nvs to load the params on first access while loading", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Key key = TEST_STORAGE_NVS_KEY_LAZY;
+    StorageNVS::Key missing_key = TEST_STORAGE_NVS_KEY_LAZY_MISSING;
+    std::promise<void> release_promise;
+    StorageNVS::EventFuture flush_future;
+    StorageNVS::EventFuture load_future;
+    StorageNVS::Value value;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    TEST_ASSERT_TRUE(test_storage_nvs_set_stored_int(key, 7));
+    auto params = storage.getLocalParams();
+    TEST_ASSERT_TRUE(params->find(key) == params->end());
+    auto connection = test_storage_nvs_hold_worker(release_promise.get_future().share(), flush_future);
+    TEST_ASSERT_TRUE(storage.sendEvent({.operation = StorageNVS::Operation::UpdateParam}, &load_future));
+
+    // The load is still queued, the key is read from NVS on its own and added to the parameters
+    TEST_ASSERT_TRUE(storage.getLocalParam(key, value));
+    TEST_ASSERT_EQUAL(7, std::get<int>(value));
+    params = storage.getLocalParams();
+    TEST_ASSERT_TRUE(params->find(key) != params->end());
+
+    release_promise.set_value();
+    TEST_ASSERT_TRUE(flush_future.get());
+    TEST_ASSERT_TRUE(load_future.get());
+    connection.disconnect();
+    TEST_ASSERT_TRUE(storage.getLocalParam(key, value));
+    TEST_ASSERT_EQUAL(7, std::get<int>(value));
+
+    // Once loaded, NVS is not read for the missing keys
+    TEST_ASSERT_TRUE(test_storage_nvs_set_stored_int(missing_key, 8));
+    TEST_ASSERT_FALSE(storage.getLocalParam(missing_key, value));
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs to keep the values set while loading", "[esp-brookesia][services][storage]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Key key = TEST_STORAGE_NVS_KEY_LAZY;
+    std::promise<void> release_promise;
+    StorageNVS::EventFuture flush_future;
+    StorageNVS::EventFuture load_future;
+    StorageNVS::EventFuture set_future;
+    StorageNVS::Value value;
+    int32_t stored_value = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    TEST_ASSERT_TRUE(test_storage_nvs_set_stored_int(key, 2));
+    auto connection = test_storage_nvs_hold_worker(release_promise.get_future().share(), flush_future);
+    TEST_ASSERT_TRUE(storage.sendEvent({.operation = StorageNVS::Operation::UpdateParam}, &load_future));
+
+    // Set after the load is sent, but written to NVS after it is done
+    TEST_ASSERT_TRUE(storage.setLocalParam(key, 1, nullptr, &set_future));
+    TEST_ASSERT_TRUE(storage.getLocalParam(key, value));
+    TEST_ASSERT_EQUAL(1, std::get<int>(value));
+
+    release_promise.set_value();
+    TEST_ASSERT_TRUE(flush_future.get());
+    TEST_ASSERT_TRUE(load_future.get());
+    TEST_ASSERT_TRUE(set_future.get());
+    connection.disconnect();
+    // The older value loaded from NVS doesn't replace it
+    TEST_ASSERT_TRUE(storage.getLocalParam(key, value));
+    TEST_ASSERT_EQUAL(1, std::get<int>(value));
+    TEST_ASSERT_TRUE(test_storage_nvs_get_stored_int(key.c_str(), stored_value));
+    TEST_ASSERT_EQUAL(1, stored_value);
+
+    // Written, a reload takes the value changed in NVS
+    TEST_ASSERT_TRUE(test_storage_nvs_set_stored_int(key, 5));
+    TEST_ASSERT_TRUE(storage.sendEvent({.operation = StorageNVS::Operation::UpdateParam}, &load_future));
+    TEST_ASSERT_TRUE(load_future.get());
+    TEST_ASSERT_TRUE(storage.getLocalParam(key, value));
+    TEST_ASSERT_EQUAL(5, std::get<int>(value));
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+#endif
+
+// The keys are checked and hashed at compile time
+static_assert(StorageKey("volume").getHash() == StorageKey::getHash("volume"));
+static_assert(StorageKey("wlan_password").getName() == "wlan_password");
+static_assert(StorageKey("123456789012345").isValid());
+static_assert(!StorageKey(std::string_view("1234567890123456")).isValid());
+static_assert(StorageKey("volume") != StorageKey("brightness"));
+
+TEST_CASE("test esp-brookesia storage nvs to deliver the events with the key handles", "[esp-brookesia][services][storage]")
+{
+    static constexpr StorageKey key_int = TEST_STORAGE_NVS_KEY_INT;
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::Key updated_key;
+    int updated_count = 0;
+    int sender = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    // A key created at runtime is the same as the one created from the literal
+    TEST_ASSERT_TRUE(StorageKey(std::string_view(TEST_STORAGE_NVS_KEY_INT)) == key_int);
+    TEST_ASSERT_FALSE(storage.setLocalParam(StorageKey(std::string_view("test_too_long_key")), 1));
+
+    auto connection = storage.connectEventSignal([&](const StorageNVS::Event & event) {
+        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.sender != &sender) ||
+                (event.key != key_int)) {
+            return;
+        }
+        updated_key = event.key;
+        updated_count++;
+    });
+    TEST_ASSERT_TRUE(test_storage_nvs_set(TEST_STORAGE_NVS_KEY_STR, std::string("other")));
+    StorageNVS::EventFuture future;
+    TEST_ASSERT_TRUE(storage.setLocalParam(key_int, 3, &sender, &future));
+    // The signal is delivered before the future is resolved
+    TEST_ASSERT_TRUE(future.get());
+    connection.disconnect();
+
+    TEST_ASSERT_EQUAL(1, updated_count);
+    TEST_ASSERT_EQUAL(key_int.getHash(), updated_key.getHash());
+    TEST_ASSERT_EQUAL_STRING(TEST_STORAGE_NVS_KEY_INT, updated_key.c_str());
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+
+TEST_CASE("test esp-brookesia storage nvs local param read benchmark", "[esp-brookesia][services][storage][benchmark]")
+{
+    TestLockedParams locked_params;
+    TestSnapshotParams snapshot_params;
+    int64_t locked_avg_ns = 0;
+    int64_t locked_max_ns = 0;
+    int64_t snapshot_avg_ns = 0;
+    int64_t snapshot_max_ns = 0;
+
+    TEST_ASSERT_TRUE(test_storage_nvs_begin());
+    for (bool with_writer : {
+                false, true
+            }) {
+        test_storage_nvs_benchmark(locked_params, with_writer, locked_avg_ns, locked_max_ns);
+        test_storage_nvs_benchmark(snapshot_params, with_writer, snapshot_avg_ns, snapshot_max_ns);
+
+        ESP_LOGI(TAG, "Reads %s: locked avg/max %d/%d ns, snapshot avg/max %d/%d ns",
+                 with_writer ? "while writing NVS" : "alone", static_cast<int>(locked_avg_ns),
+                 static_cast<int>(locked_max_ns), static_cast<int>(snapshot_avg_ns), static_cast<int>(snapshot_max_ns));
+    }
+
+    TEST_ASSERT_TRUE(test_storage_nvs_end());
+}
+#endif
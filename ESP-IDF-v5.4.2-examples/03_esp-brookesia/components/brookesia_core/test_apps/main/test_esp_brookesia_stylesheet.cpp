@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include "unity.h"
+#include "gui/style/esp_brookesia_gui_stylesheet_manager.hpp"
+
+using namespace esp_brookesia::gui;
+
+#define TEST_STYLESHEET_SCREEN_WIDTH    (480)
+#define TEST_STYLESHEET_SCREEN_HEIGHT   (480)
+
+struct TestStylesheet {
+    const char *name;
+    StyleSize screen_size;
+    struct {
+        int color;
+        int width_percent;
+        int width;
+    } widget_0;
+    struct {
+        int color;
+    } widget_1;
+};
+
+class TestStylesheetManager: public StylesheetManager<TestStylesheet> {
+public:
+    bool calibrateScreenSize(StyleSize &size) override
+    {
+        return size.calibrate(StyleSize::RECT(TEST_STYLESHEET_SCREEN_WIDTH, TEST_STYLESHEET_SCREEN_HEIGHT));
+    }
+
+    int calibrate_count = 0;
+    int update_count = 0;
+    int widget_0_changed_count = 0;
+    int widget_1_changed_count = 0;
+
+private:
+    bool calibrateStylesheet(const StyleSize &screen_size, TestStylesheet &stylesheet) override
+    {
+        calibrate_count++;
+        stylesheet.widget_0.width = screen_size.width * stylesheet.widget_0.width_percent / 100;
+        return true;
+    }
+
+    bool updateActiveStylesheet(const TestStylesheet &stylesheet) override
+    {
+        update_count++;
+        if (std::memcmp(&_active_stylesheet.widget_0, &stylesheet.widget_0, sizeof(stylesheet.widget_0)) != 0) {
+            widget_0_changed_count++;
+        }
+        if (std::memcmp(&_active_stylesheet.widget_1, &stylesheet.widget_1, sizeof(stylesheet.widget_1)) != 0) {
+            widget_1_changed_count++;
+        }
+        _active_stylesheet = stylesheet;
+        return true;
+    }
+};
+
+static constexpr TestStylesheet TEST_STYLESHEET_DARK = {
+    .name = "dark",
+    .screen_size = StyleSize::RECT(TEST_STYLESHEET_SCREEN_WIDTH, TEST_STYLESHEET_SCREEN_HEIGHT),
+    .widget_0 = {
+        .color = 0x000000,
+        .width_percent = 50,
+    },
+    .widget_1 = {
+        .color = 0x000000,
+    },
+};
+
+TEST_CASE("test esp-brookesia stylesheet manager to activate without copy", "[esp-brookesia][gui][stylesheet]")
+{
+    TestStylesheetManager manager;
+    TestStylesheet light = TEST_STYLESHEET_DARK;
+    light.name = "light";
+    light.widget_1.color = 0xFFFFFF;
+
+    // Calibrated once when added
+    TEST_ASSERT_TRUE(manager.addStylesheet(TEST_STYLESHEET_DARK.name, TEST_STYLESHEET_DARK.screen_size,
+                                           TEST_STYLESHEET_DARK));
+    TEST_ASSERT_TRUE(manager.addStylesheet(light.name, light.screen_size, light));
+    TEST_ASSERT_EQUAL(2, manager.calibrate_count);
+    TEST_ASSERT_NULL(manager.getActiveStylesheetPtr());
+
+    // The active stylesheet shares the calibrated one
+    TEST_ASSERT_TRUE(manager.activateStylesheet(TEST_STYLESHEET_DARK.name, TEST_STYLESHEET_DARK.screen_size));
+    TEST_ASSERT_EQUAL(2, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(1, manager.update_count);
+    TEST_ASSERT_TRUE(manager.getActiveStylesheetPtr().get() ==
+                     manager.getStylesheet(TEST_STYLESHEET_DARK.name, TEST_STYLESHEET_DARK.screen_size));
+    TEST_ASSERT_EQUAL(TEST_STYLESHEET_SCREEN_WIDTH / 2, manager.getStylesheet()->widget_0.width);
+
+    // Activating it again copies nothing
+    TEST_ASSERT_TRUE(manager.activateStylesheet(TEST_STYLESHEET_DARK.name, TEST_STYLESHEET_DARK.screen_size));
+    TEST_ASSERT_EQUAL(1, manager.update_count);
+
+    // Switching only changes the sections which differ
+    int widget_0_changed_count = manager.widget_0_changed_count;
+    int widget_1_changed_count = manager.widget_1_changed_count;
+    TEST_ASSERT_TRUE(manager.activateStylesheet(light.name, light.screen_size));
+    TEST_ASSERT_EQUAL(2, manager.update_count);
+    TEST_ASSERT_EQUAL(widget_0_changed_count, manager.widget_0_changed_count);
+    TEST_ASSERT_EQUAL(widget_1_changed_count + 1, manager.widget_1_changed_count);
+    TEST_ASSERT_EQUAL(0xFFFFFF, manager.getStylesheet()->widget_1.color);
+
+    // Unknown names are rejected and keep the active stylesheet
+    TEST_ASSERT_FALSE(manager.activateStylesheet("unknown", light.screen_size));
+    TEST_ASSERT_TRUE(manager.getActiveStylesheetPtr().get() == manager.getStylesheet(light.name, light.screen_size));
+}
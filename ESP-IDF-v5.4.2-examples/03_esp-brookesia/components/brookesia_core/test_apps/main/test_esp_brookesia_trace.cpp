@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string>
+#include <thread>
+#include <vector>
+#include "unity.h"
+#include "esp_brookesia_internal.h"
+#include "trace/esp_brookesia_trace.hpp"
+
+using namespace esp_brookesia::trace;
+
+#define TEST_TRACE_RING_SIZE    (8)
+
+TEST_CASE("test esp-brookesia tracer to record nested spans", "[esp-brookesia][trace]")
+{
+    Tracer tracer(TEST_TRACE_RING_SIZE);
+
+    {
+        TraceScope outer("outer", tracer);
+        {
+            TraceScope inner("inner", tracer);
+        }
+        auto id = tracer.begin("open");
+        std::vector<Tracer::Span> spans = tracer.getSpans();
+        TEST_ASSERT_EQUAL(3, spans.size());
+        TEST_ASSERT_EQUAL(1, spans[2].depth);
+        TEST_ASSERT_TRUE(spans[2].end_us < 0);
+        tracer.end(id);
+    }
+
+    std::vector<Tracer::Span> spans = tracer.getSpans();
+    TEST_ASSERT_EQUAL(3, spans.size());
+    TEST_ASSERT_EQUAL_STRING("outer", spans[0].name);
+    TEST_ASSERT_EQUAL(0, spans[0].depth);
+    TEST_ASSERT_EQUAL_STRING("inner", spans[1].name);
+    TEST_ASSERT_EQUAL(1, spans[1].depth);
+    TEST_ASSERT_EQUAL(1, spans[2].depth);
+    for (auto &span : spans) {
+        TEST_ASSERT_TRUE(span.end_us >= span.begin_us);
+        TEST_ASSERT_TRUE((span.begin_us >= spans[0].begin_us) && (span.end_us <= spans[0].end_us));
+    }
+
+    // Spans of another thread have their own ID and depth
+    std::thread([&tracer]() {
+        TraceScope scope("thread", tracer);
+    }).join();
+    spans = tracer.getSpans();
+    TEST_ASSERT_EQUAL(4, spans.size());
+    TEST_ASSERT_EQUAL(0, spans[3].depth);
+    TEST_ASSERT_NOT_EQUAL(spans[0].thread_id, spans[3].thread_id);
+}
+
+TEST_CASE("test esp-brookesia tracer to overwrite the oldest spans", "[esp-brookesia][trace]")
+{
+    Tracer tracer(TEST_TRACE_RING_SIZE);
+
+    // The oldest span is open when it is overwritten, ending it must not touch the newer one
+    auto oldest_id = tracer.begin("oldest");
+    for (int i = 0; i < TEST_TRACE_RING_SIZE; i++) {
+        TraceScope scope("newer", tracer);
+    }
+    tracer.end(oldest_id);
+
+    std::vector<Tracer::Span> spans = tracer.getSpans();
+    TEST_ASSERT_EQUAL(TEST_TRACE_RING_SIZE, spans.size());
+    TEST_ASSERT_EQUAL(1, tracer.getDroppedCount());
+    for (auto &span : spans) {
+        TEST_ASSERT_EQUAL_STRING("newer", span.name);
+        TEST_ASSERT_EQUAL(1, span.depth);
+    }
+
+    tracer.reset();
+    TEST_ASSERT_EQUAL(0, tracer.getSpans().size());
+    TEST_ASSERT_EQUAL(0, tracer.getDroppedCount());
+    {
+        TraceScope scope("after reset", tracer);
+    }
+    spans = tracer.getSpans();
+    TEST_ASSERT_EQUAL(1, spans.size());
+    TEST_ASSERT_EQUAL(0, spans[0].depth);
+}
+
+TEST_CASE("test esp-brookesia tracer to dump the chrome trace json", "[esp-brookesia][trace]")
+{
+    Tracer tracer(TEST_TRACE_RING_SIZE);
+    std::string json;
+
+    {
+        TraceScope scope("closed \"span\"", tracer);
+    }
+    auto id = tracer.begin("open");
+    TEST_ASSERT_TRUE(tracer.dumpChromeTrace(json));
+    tracer.end(id);
+
+    TEST_ASSERT_EQUAL(0, json.find("{\"traceEvents\":["));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"name\":\"closed \\\"span\\\"\",\"cat\":\"brookesia\",\"ph\":\"X\""));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"name\":\"open\",\"cat\":\"brookesia\",\"ph\":\"B\""));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"dur\":"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.rfind("],\"displayTimeUnit\":\"ms\"}"));
+}
+
+TEST_CASE("test esp-brookesia tracer instance to keep its ring in static storage", "[esp-brookesia][trace]")
+{
+    // The first use of the instance may happen in this case, the leak check of `tearDown()` fails if it allocates
+    Tracer &tracer = Tracer::getInstance();
+
+    TEST_ASSERT_EQUAL(ESP_BROOKESIA_TRACE_RING_SIZE, tracer.getCapacity());
+    tracer.reset();
+    {
+        TraceScope scope("instance", tracer);
+    }
+    auto spans = tracer.getSpans();
+    TEST_ASSERT_EQUAL(1, spans.size());
+    TEST_ASSERT_EQUAL_STRING("instance", spans[0].name);
+    tracer.reset();
+}
@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#if defined(ESP_PLATFORM)
+#   include "esp_timer.h"
+#else
+#   include <chrono>
+#endif
+#include "private/esp_brookesia_trace_utils.hpp"
+#include "esp_brookesia_trace.hpp"
+
+namespace esp_brookesia::trace {
+
+// Number of spans open on the current thread
+static thread_local uint16_t thread_depth = 0;
+
+Tracer::Tracer(size_t capacity):
+    Tracer(nullptr, std::max<size_t>(capacity, 1))
+{
+}
+
+Tracer::Tracer(Slot *slots, size_t capacity):
+    _capacity(capacity),
+    _owned_slots((slots == nullptr) ? new Slot[capacity] : nullptr),
+    _slots((slots == nullptr) ? _owned_slots.get() : slots),
+    _next_id(0),
+    _reset_id(0)
+{
+    for (size_t i = 0; i < _capacity; i++) {
+        _slots[i].sequence.store(0, std::memory_order_relaxed);
+        _slots[i].end_us.store(-1, std::memory_order_relaxed);
+    }
+}
+
+Tracer &Tracer::getInstance(void)
+{
+    static_assert(ESP_BROOKESIA_TRACE_RING_SIZE > 0, "Invalid trace ring size");
+    static Slot slots[ESP_BROOKESIA_TRACE_RING_SIZE];
+    static Tracer tracer(slots, ESP_BROOKESIA_TRACE_RING_SIZE);
+
+    return tracer;
+}
+
+Tracer::SpanID Tracer::begin(const char *name)
+{
+    SpanID id = _next_id.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = _slots[id % _capacity];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    slot.span = {
+        .name = (name != nullptr) ? name : "",
+        .begin_us = getTimeUs(),
+        .end_us = -1,
+        .thread_id = getThreadID(),
+        .depth = thread_depth++,
+    };
+    slot.end_us.store(-1, std::memory_order_relaxed);
+    slot.sequence.store(id + 1, std::memory_order_release);
+
+    return id;
+}
+
+void Tracer::end(SpanID id)
+{
+    if (id == SPAN_ID_INVALID) {
+        return;
+    }
+    if (thread_depth > 0) {
+        thread_depth--;
+    }
+
+    // The span may have been overwritten by a newer one, or dropped by `reset()`
+    Slot &slot = _slots[id % _capacity];
+    if (slot.sequence.load(std::memory_order_acquire) == id + 1) {
+        slot.end_us.store(getTimeUs(), std::memory_order_release);
+    }
+}
+
+void Tracer::reset(void)
+{
+    for (size_t i = 0; i < _capacity; i++) {
+        _slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    _reset_id = _next_id.load(std::memory_order_acquire);
+}
+
+std::vector<Tracer::Span> Tracer::getSpans(void) const
+{
+    std::vector<Span> spans;
+    uint32_t next_id = _next_id.load(std::memory_order_acquire);
+    uint32_t first_id = next_id - std::min<uint32_t>(next_id - _reset_id, _capacity);
+
+    spans.reserve(next_id - first_id);
+    for (uint32_t id = first_id; id != next_id; id++) {
+        const Slot &slot = _slots[id % _capacity];
+        if (slot.sequence.load(std::memory_order_acquire) != id + 1) {
+            continue;
+        }
+        Span span = slot.span;
+        span.end_us = slot.end_us.load(std::memory_order_acquire);
+        // Skip the span if it has been overwritten while being copied
+        if (slot.sequence.load(std::memory_order_acquire) == id + 1) {
+            spans.push_back(span);
+        }
+    }
+
+    return spans;
+}
+
+size_t Tracer::getDroppedCount(void) const
+{
+    uint32_t count = _next_id.load(std::memory_order_relaxed) - _reset_id;
+
+    return (count > _capacity) ? (count - _capacity) : 0;
+}
+
+bool Tracer::dumpChromeTrace(std::string &json) const
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::vector<Span> spans = getSpans();
+    char event_str[160] = {};
+
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(json.reserve(json.size() + 32 + spans.size() * 128), false, "Reserve json failed");
+    json += "{\"traceEvents\":[";
+    for (size_t i = 0; i < spans.size(); i++) {
+        const Span &span = spans[i];
+        json += (i > 0) ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        for (const char *c = span.name; *c != '\0'; c++) {
+            if ((*c == '"') || (*c == '\\')) {
+                json += '\\';
+            }
+            json += ((static_cast<unsigned char>(*c) < 0x20) ? ' ' : *c);
+        }
+        if (span.end_us >= 0) {
+            snprintf(event_str, sizeof(event_str),
+                     "\",\"cat\":\"brookesia\",\"ph\":\"X\",\"ts\":%" PRId64 ",\"dur\":%" PRId64
+                     ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{\"depth\":%d}}",
+                     span.begin_us, span.end_us - span.begin_us, span.thread_id, static_cast<int>(span.depth));
+        } else {
+            snprintf(event_str, sizeof(event_str),
+                     "\",\"cat\":\"brookesia\",\"ph\":\"B\",\"ts\":%" PRId64 ",\"pid\":0,\"tid\":%" PRIu32
+                     ",\"args\":{\"depth\":%d}}",
+                     span.begin_us, span.thread_id, static_cast<int>(span.depth));
+        }
+        json += event_str;
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return true;
+}
+
+void Tracer::dump(void) const
+{
+    std::vector<Span> spans = getSpans();
+
+    ESP_UTILS_LOGI("Trace: %d spans, %d dropped", static_cast<int>(spans.size()), static_cast<int>(getDroppedCount()));
+    for (auto &span : spans) {
+        if (span.end_us >= 0) {
+            ESP_UTILS_LOGI("\t[%d] %*s%s: %d us (at %d us)", static_cast<int>(span.thread_id), span.depth * 2, "",
+                           span.name, static_cast<int>(span.end_us - span.begin_us), static_cast<int>(span.begin_us));
+        } else {
+            ESP_UTILS_LOGI("\t[%d] %*s%s: open (at %d us)", static_cast<int>(span.thread_id), span.depth * 2, "",
+                           span.name, static_cast<int>(span.begin_us));
+        }
+    }
+}
+
+int64_t Tracer::getTimeUs(void)
+{
+#if defined(ESP_PLATFORM)
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+           ).count();
+#endif
+}
+
+uint32_t Tracer::getThreadID(void)
+{
+    static std::atomic<uint32_t> next_thread_id(1);
+    static thread_local uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+
+    return thread_id;
+}
+
+} // namespace esp_brookesia::trace
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "esp_brookesia_internal.h"
+
+namespace esp_brookesia::trace {
+
+/**
+ * @brief Span tracer recording begin/end markers into a fixed-size ring. The oldest spans are overwritten once the ring
+ *        is full, so it can stay enabled without growing. Spans nest per thread, the depth of each span is the number
+ *        of spans still open on its thread when it began.
+ *
+ * @note  `begin()` and `end()` are lock-free and can be called from any task, but the span of a `begin()` must be ended
+ *        on the same thread. The names are not copied, they must outlive the tracer (e.g. string literals).
+ */
+class Tracer {
+public:
+    using SpanID = uint32_t;
+
+    static constexpr SpanID SPAN_ID_INVALID = UINT32_MAX;
+
+    struct Span {
+        const char *name;
+        int64_t begin_us;
+        int64_t end_us;         // `-1` while the span is open
+        uint32_t thread_id;
+        uint16_t depth;
+    };
+
+    explicit Tracer(size_t capacity = ESP_BROOKESIA_TRACE_RING_SIZE);
+    ~Tracer() = default;
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    /**
+     * @brief Get the tracer used by the `ESP_BROOKESIA_TRACE_*` macros. Its ring of `ESP_BROOKESIA_TRACE_RING_SIZE`
+     *        spans is in static storage, so the first span doesn't allocate from the heap.
+     */
+    static Tracer &getInstance(void);
+
+    SpanID begin(const char *name);
+    void end(SpanID id);
+    /**
+     * @brief Drop all the recorded spans. Spans still open are dropped too, ending them does nothing.
+     */
+    void reset(void);
+
+    /**
+     * @brief Get the spans still in the ring, in the order they began
+     */
+    std::vector<Span> getSpans(void) const;
+    size_t getCapacity(void) const
+    {
+        return _capacity;
+    }
+    /**
+     * @brief Get the number of spans overwritten since the last `reset()`
+     */
+    size_t getDroppedCount(void) const;
+
+    /**
+     * @brief Write the spans in the Chrome trace-event JSON format, which can be opened in `chrome://tracing` or
+     *        Perfetto. Closed spans are complete events (`"ph":"X"`), open spans are begin events (`"ph":"B"`).
+     */
+    bool dumpChromeTrace(std::string &json) const;
+    /**
+     * @brief Print the spans as an indented tree
+     */
+    void dump(void) const;
+
+    static int64_t getTimeUs(void);
+
+private:
+    /**
+     * @brief Cell of the ring. `sequence` is `id + 1` once the span of `id` is fully written, `0` while it is empty or
+     *        being overwritten.
+     */
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        std::atomic<int64_t> end_us;
+        Span span;
+    };
+
+    Tracer(Slot *slots, size_t capacity);
+
+    static uint32_t getThreadID(void);
+
+    size_t _capacity;
+    std::unique_ptr<Slot[]> _owned_slots;   // Empty if the slots are not owned by the tracer
+    Slot *_slots;
+    std::atomic<uint32_t> _next_id;
+    uint32_t _reset_id;
+};
+
+/**
+ * @brief Span lasting as long as the object
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char *name, Tracer &tracer = Tracer::getInstance()):
+        _tracer(tracer),
+        _id(tracer.begin(name))
+    {
+    }
+    ~TraceScope()
+    {
+        _tracer.end(_id);
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    Tracer &_tracer;
+    Tracer::SpanID _id;
+};
+
+} // namespace esp_brookesia::trace
+
+#define ESP_BROOKESIA_TRACE_CONCAT_IMPL(a, b)   a##b
+#define ESP_BROOKESIA_TRACE_CONCAT(a, b)        ESP_BROOKESIA_TRACE_CONCAT_IMPL(a, b)
+
+#if ESP_BROOKESIA_ENABLE_TRACE
+/**
+ * @brief Trace the rest of the current scope
+ */
+#   define ESP_BROOKESIA_TRACE_SCOPE(name) \
+        esp_brookesia::trace::TraceScope ESP_BROOKESIA_TRACE_CONCAT(_trace_scope_, __LINE__)(name)
+/**
+ * @brief Begin a span and return its ID, to be passed to `ESP_BROOKESIA_TRACE_END()`
+ */
+#   define ESP_BROOKESIA_TRACE_BEGIN(name)  esp_brookesia::trace::Tracer::getInstance().begin(name)
+#   define ESP_BROOKESIA_TRACE_END(id)      esp_brookesia::trace::Tracer::getInstance().end(id)
+#else
+#   define ESP_BROOKESIA_TRACE_SCOPE(name)
+#   define ESP_BROOKESIA_TRACE_BEGIN(name)  (esp_brookesia::trace::Tracer::SPAN_ID_INVALID)
+#   define ESP_BROOKESIA_TRACE_END(id)      ((void)(id))
+#endif
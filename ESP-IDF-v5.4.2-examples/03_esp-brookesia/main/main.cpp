@@ -29,6 +29,9 @@ using namespace esp_brookesia::systems::phone;
 
 constexpr bool EXAMPLE_SHOW_MEM_INFO = false;
 
+// Only checked when `CONFIG_ESP_BROOKESIA_PHONE_FIXED_SCREEN_WIDTH/HEIGHT` are set
+static_assert(Phone::checkFixedScreenStylesheet(STYLESHEET_410_502_DARK), "Stylesheet doesn't match the fixed screen");
+
 extern "C" void app_main(void)
 {
     ESP_UTILS_LOGI("Display ESP-Brookesia phone demo");
@@ -125,6 +128,9 @@ extern "C" void app_main(void)
                         heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL), internal_free, internal_total,
                         heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM), external_free, external_total);
                 ESP_UTILS_LOGI("\n%s", buffer);
+#if ESP_BROOKESIA_LVGL_LOCK_ENABLE_PROFILING
+                LvLock::getInstance().dump();
+#endif
 
                 {
                     LvLockGuard gui_guard;